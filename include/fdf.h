@@ -1,8 +1,6 @@
 
-// TODO: Maybe add an option to lazily evaluate? (store every value as a string and don't process anything until requested)
 // TODO: Maybe add some kind of enum type (to file format)
 // TODO: Maybe allow compact bool with std::bitset?
-// TODO: Maybe don't store full identifier on each Entry and only store their identifier?
 // TODO: Add API to read/modify data
 // TODO: Look into error callback. Can we make it better?
 
@@ -22,11 +20,62 @@
     #include <utility>
     #include <algorithm>
     #include <ranges>
+    #include <array>
+    #include <bit>
+    #include <memory>
+    #include <memory_resource>
+    #include <charconv>
+    #include <thread>
+    #include <mutex>
+    #include <atomic>
+    #include <numeric>
+    #include <optional>
+    #include <chrono>
+    #include <functional>
+    #include <cstring>
+    #include <unordered_map>
+    #include <cmath>
 
     #define FDF_EXPORT
 #endif
 
 
+#if defined(__AVX2__)
+    #define FDF_SIMD_AVX2 true
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define FDF_SIMD_SSE2 true
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #define FDF_SIMD_NEON true
+#endif
+
+#if defined(__linux__)
+    #define FDF_MMAP true
+    #define FDF_INOTIFY true
+#endif
+
+#if !FDF_USE_CPP_MODULES
+    #if FDF_MMAP
+        #include <sys/mman.h>
+        #include <sys/stat.h>
+        #include <fcntl.h>
+        #include <unistd.h>
+        #include <cerrno>
+    #endif
+
+    #if FDF_INOTIFY
+        #include <sys/inotify.h>
+        #include <sys/eventfd.h>
+        #include <poll.h>
+    #endif
+
+    #if FDF_SIMD_AVX2 || FDF_SIMD_SSE2
+        #include <immintrin.h>
+    #elif FDF_SIMD_NEON
+        #include <arm_neon.h>
+    #endif
+#endif
+
+
 
 
 #define FDF_CHECK_TOKEN(TOKEN)         do { if(TOKEN.type == TokenType::Invalid  ) return false; } while (false)
@@ -94,6 +143,25 @@ FDF_EXPORT namespace fdf
     };
 
 
+    struct ParseOptions
+    {
+        // Strings, hex values, timestamps and comments reference the parsed content instead of being copied (strings with escapes are still copied)
+        // The content must outlive the entries, "IO::ParseOwned" and "IO::Parse(path)" keep it alive inside the IO
+        bool bBorrowSource = false;
+
+        // Parsing only records where simple values are, they are decoded on first access (see "Entry::GetType", "Entry::GetValue", "Entry::DataToView")
+        // Like "bBorrowSource" the content must outlive the entries. First access writes into the entry, even through a const IO,
+        // so a lazily parsed IO must not be shared between threads until "IO::ResolveValues" has been called
+        bool bLazyValues = false;
+
+        // Comments are skipped like whitespace, nothing is tracked, reported (Error::AlreadyHasComment) or stored
+        // Unlike FDF_NO_COMMENTS it doesn't change the layout of "Entry", so parses with and without comments can be mixed
+        bool bSkipComments = false;
+
+        [[nodiscard]] constexpr bool ReferencesSource() const noexcept  { return bBorrowSource || bLazyValues; }
+    };
+
+
 
 
     enum class CommentCombineStrategy : uint8_t
@@ -113,7 +181,9 @@ FDF_EXPORT namespace fdf
 
         UnexpectedToken,
         Error_Begin = UnexpectedToken,
-        Error_End = Error_Begin,
+        IdentifierTooLong,
+        ReloadFailed,  // Reported by "FileWatcher", the text is the file and the previous text what went wrong
+        Error_End = ReloadFailed,
     };
 
     constexpr bool IsWarning(Error type) noexcept
@@ -127,6 +197,83 @@ FDF_EXPORT namespace fdf
                static_cast<uint8_t>(type) <= static_cast<uint8_t>(Error::Error_End);
     }
 
+    struct SourceLocation
+    {
+        size_t line = 0;    // 1 based
+        size_t column = 0;  // 1 based, in bytes
+    };
+
+    // Replaces "removedSize" bytes at "offset" of the previous content with "insertedText", see "IO::Reparse"
+    struct TextEdit
+    {
+        size_t offset = 0;
+        size_t removedSize = 0;
+        std::string_view insertedText;
+    };
+
+    // What the error callback receives, it only refers to the parsed content
+    // Locations and the message are computed when they are asked for, so ignored diagnostics cost nothing
+    class Diagnostic
+    {
+    public:
+        // "text" and "previousText" are views into "content", which starts at the beginning of "firstLine"
+        constexpr Diagnostic(Error error_, std::string_view content_, size_t firstLine_, std::string_view subject_, std::string_view text_, std::string_view previousText_ = {}) noexcept
+            : error(error_), content(content_), firstLine(firstLine_), subject(subject_), text(text_), previousText(previousText_)  { }
+
+    public:
+        [[nodiscard]] constexpr Error            GetError()        const noexcept  { return error; }
+        [[nodiscard]] constexpr std::string_view GetSubject()      const noexcept  { return subject; }       // What the diagnostic is about, for example "Token" or "File"
+        [[nodiscard]] constexpr std::string_view GetText()         const noexcept  { return text; }          // Part of the content that caused it
+        [[nodiscard]] constexpr std::string_view GetPreviousText() const noexcept  { return previousText; }  // Part of the content it conflicts with, if any
+
+        [[nodiscard]] constexpr SourceLocation GetLocation()         const noexcept  { return Locate(text); }
+        [[nodiscard]] constexpr SourceLocation GetPreviousLocation() const noexcept  { return Locate(previousText); }
+
+        [[nodiscard]] std::string ToString() const
+        {
+            const SourceLocation location = GetLocation();
+            switch(error)
+            {
+                case Error::AlreadyHasComment:
+                {
+                    const SourceLocation previousLocation = GetPreviousLocation();
+                    return std::format("{} already has a comment\nOld Comment: \"{}\" ({}:{})\nNew Comment: \"{}\" ({}:{})", subject, previousText, previousLocation.line, previousLocation.column, text, location.line, location.column);
+                }
+
+                case Error::IdentifierTooLong:
+                    return std::format("{} is longer than 255 bytes: \"{}\" ({}:{})", subject, text, location.line, location.column);
+
+                case Error::ReloadFailed:
+                    return std::format("{} \"{}\" can't be reloaded: {}", subject, text, previousText);
+
+                default:
+                    return std::format("{}: \"{}\" ({}:{})", subject, text, location.line, location.column);
+            }
+        }
+
+    private:
+        // Counts the new lines in front of "view", only done for diagnostics that are looked at
+        [[nodiscard]] constexpr SourceLocation Locate(std::string_view view) const noexcept
+        {
+            const size_t offset = view.data() != nullptr? static_cast<size_t>(view.data() - content.data()) : 0;
+            const std::string_view before = content.substr(0, offset);
+            const size_t lastNewLine = before.rfind('\n');
+            return
+            {
+                .line = firstLine + static_cast<size_t>(std::ranges::count(before, '\n')),
+                .column = lastNewLine != std::string_view::npos? offset - lastNewLine : offset + 1
+            };
+        }
+
+    private:
+        Error error;
+        std::string_view content;
+        size_t firstLine;
+        std::string_view subject;
+        std::string_view text;
+        std::string_view previousText;
+    };
+
     class Entry;
 }
 
@@ -148,6 +295,9 @@ namespace fdf::detail
     constexpr size_t VARIANT_32BIT_ELEMENT_COUNT = VARIANT_SIZE / sizeof(int32_t);
     constexpr size_t VARIANT_64BIT_ELEMENT_COUNT = VARIANT_SIZE / sizeof(int64_t);
     constexpr size_t VARIANT_DYNAMIC_STRING_HARD_LIMIT = (VARIANT_SIZE * 2.5);
+    constexpr size_t DEFAULT_ARENA_SIZE = 64 * 1024;
+    constexpr size_t IDENTIFIER_BLOCK_SIZE = 4 * 1024;
+    constexpr size_t MAX_TOKEN_SIZE = std::numeric_limits<uint32_t>::max();  // Offsets are 64 bit, only a single token is limited to 4 GB
 
 
     constexpr std::string_view KEYWORDS[] =
@@ -157,6 +307,117 @@ namespace fdf::detail
     };
     constexpr size_t KEYWORD_COUNT = sizeof(KEYWORDS) / sizeof(KEYWORDS[0]);
 
+    // Keywords are looked up with (size ^ first character) as a perfect hash, verified at compile time
+    constexpr size_t KEYWORD_HASH_TABLE_SIZE = 8;
+    constexpr size_t KeywordHash(std::string_view view) noexcept  { return (view.size() ^ static_cast<uint8_t>(view[0])) & (KEYWORD_HASH_TABLE_SIZE - 1); }
+
+    constexpr std::array<uint8_t, KEYWORD_HASH_TABLE_SIZE> KEYWORD_HASH_TABLE = []()
+    {
+        std::array<uint8_t, KEYWORD_HASH_TABLE_SIZE> table;
+        table.fill(static_cast<uint8_t>(-1));
+        for(size_t i = 0; i < 4; i++)  // Placeholder is excluded, it is never matched as a whole
+        {
+            if(table[KeywordHash(KEYWORDS[i])] != static_cast<uint8_t>(-1))
+                throw "Keyword hash is not perfect anymore, update KeywordHash";
+            table[KeywordHash(KEYWORDS[i])] = i;
+        }
+        return table;
+    }();
+
+    constexpr size_t FindKeyword(std::string_view view) noexcept
+    {
+        if(view.size() < 3 || view.size() > 5)
+            return -1;
+
+        const uint8_t keywordIndex = KEYWORD_HASH_TABLE[KeywordHash(view)];
+        return keywordIndex != static_cast<uint8_t>(-1) && KEYWORDS[keywordIndex] == view? keywordIndex : static_cast<size_t>(-1);
+    }
+
+
+
+    // Locale independent replacements for <cctype>, shared by Tokenizer and Utils
+    constexpr uint8_t CHAR_SPACE      = 1 << 0;
+    constexpr uint8_t CHAR_DIGIT      = 1 << 1;
+    constexpr uint8_t CHAR_HEX_LETTER = 1 << 2;  // a-f, A-F
+    constexpr uint8_t CHAR_IDENTIFIER = 1 << 3;  // a-z, A-Z, 0-9, _
+    constexpr uint8_t CHAR_DATE       = 1 << 4;  // 0-9, T, Z, W, -, +, :, .
+    constexpr uint8_t CHAR_TIME       = 1 << 5;  // 0-9, +, :, .
+
+    constexpr std::array<uint8_t, 256> CHAR_CLASS = []()
+    {
+        std::array<uint8_t, 256> table = {};
+        for(char c : std::string_view(" \t\n\v\f\r"))
+            table[static_cast<uint8_t>(c)] |= CHAR_SPACE;
+        for(char c = '0'; c <= '9'; c++)
+            table[static_cast<uint8_t>(c)] |= CHAR_DIGIT | CHAR_IDENTIFIER | CHAR_DATE | CHAR_TIME;
+        for(char c = 'a'; c <= 'z'; c++)
+            table[static_cast<uint8_t>(c)] |= CHAR_IDENTIFIER | (c <= 'f'? CHAR_HEX_LETTER : 0);
+        for(char c = 'A'; c <= 'Z'; c++)
+            table[static_cast<uint8_t>(c)] |= CHAR_IDENTIFIER | (c <= 'F'? CHAR_HEX_LETTER : 0);
+        for(char c : std::string_view("TZW-+:."))
+            table[static_cast<uint8_t>(c)] |= CHAR_DATE;
+        for(char c : std::string_view("+:."))
+            table[static_cast<uint8_t>(c)] |= CHAR_TIME;
+        table['_'] |= CHAR_IDENTIFIER;
+        return table;
+    }();
+
+    constexpr bool IsSpace(char c) noexcept  { return CHAR_CLASS[static_cast<uint8_t>(c)] & CHAR_SPACE; }
+    constexpr bool IsDigit(char c) noexcept  { return CHAR_CLASS[static_cast<uint8_t>(c)] & CHAR_DIGIT; }
+
+    // Same as std::string_view::find_first_not_of but with a character class instead of a character set
+    constexpr size_t FindFirstNotOf(std::string_view view, uint8_t charClass, size_t position) noexcept
+    {
+        for(; position < view.size(); position++)
+        {
+            if(!(CHAR_CLASS[static_cast<uint8_t>(view[position])] & charClass))
+                return position;
+        }
+        return std::string_view::npos;
+    }
+
+
+    // What the tokenizer does with the first character of a token
+    enum class CharDispatch : uint8_t
+    {
+        Invalid,
+        Quote,
+        Slash,
+        CurlyBraceOpen,
+        CurlyBraceClose,
+        SquareBraceOpen,
+        SquareBraceClose,
+        Equal,
+        Comma,
+        Dollar,
+        Identifier,
+        Number
+    };
+
+    constexpr std::array<CharDispatch, 256> CHAR_DISPATCH = []()
+    {
+        std::array<CharDispatch, 256> table = {};
+        for(size_t c = 0; c < table.size(); c++)
+        {
+            if(c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+                table[c] = CharDispatch::Identifier;
+            else if(c == '-' || (c >= '0' && c <= '9'))
+                table[c] = CharDispatch::Number;
+        }
+
+        table['\"'] = CharDispatch::Quote;
+        table['\''] = CharDispatch::Quote;
+        table['/']  = CharDispatch::Slash;
+        table['{']  = CharDispatch::CurlyBraceOpen;
+        table['}']  = CharDispatch::CurlyBraceClose;
+        table['[']  = CharDispatch::SquareBraceOpen;
+        table[']']  = CharDispatch::SquareBraceClose;
+        table['=']  = CharDispatch::Equal;
+        table[',']  = CharDispatch::Comma;
+        table['$']  = CharDispatch::Dollar;
+        return table;
+    }();
+
     enum class TokenType : uint8_t
     {
         NonExisting,  // Means the requested token doesn't exist/cannot be accessed, not necessarily an error
@@ -191,8 +452,8 @@ namespace fdf::detail
     struct Token
     {
         constexpr Token() noexcept = default;
-        constexpr Token(TokenType type_, uint32_t startPosition_ = 0, size_t count_ = 0)
-            : type(type_), count(count_), startPosition(startPosition_)  { }
+        constexpr Token(TokenType type_, size_t startPosition_ = 0, size_t count_ = 0)
+            : type(type_), count(static_cast<uint32_t>(count_)), startPosition(startPosition_)  { }
 
         constexpr std::string_view ToView(std::string_view buffer) const noexcept  { return buffer.substr(startPosition, count); }
 
@@ -200,27 +461,53 @@ namespace fdf::detail
         uint8_t  extra8  = 0; // Token specific data, if needed
         uint16_t extra16 = 0; // Token specific data, if needed
         uint32_t count = 0;
-        size_t startPosition = 0;
-        uint32_t line = 0;
-        uint32_t column = 0;
+        size_t startPosition = 0;  // Lines and columns aren't tracked, "Diagnostic" computes them from this when needed
+    };
+    static_assert(sizeof(Token) <= 16, "Tokens are passed around by value a lot, keep them in two registers");
+
+    // Where a top level entry or a map child (with the comments and new lines in front of it) starts in the parsed content and in the entry vector
+    struct EntryPosition
+    {
+        size_t sourceOffset = 0;
+        size_t entryIndex = 0;
+
+        constexpr bool operator==(const EntryPosition&) const noexcept = default;
     };
 
     struct Tokenizer
     {
         constexpr Tokenizer(std::string_view content_) noexcept
-            : content(content_), index(0), line(1), lastNewLineIndex(0), currentToken(GetNextToken())  { }
+            : Tokenizer(content_, 1)  { }
+        // "content_" is a part of a bigger content that starts at the beginning of "firstLine", reported lines are in the bigger content
+        // Tokenizing starts at "startOffset", the part in front of it is only there so positions and diagnostics refer to the whole content
+        constexpr Tokenizer(std::string_view content_, size_t firstLine, size_t startOffset = 0) noexcept
+            : content(content_), index(startOffset), firstLine(firstLine), currentTokenBegin(startOffset), currentToken(NextToken())  { }
 
         constexpr Token Current() const noexcept  { return currentToken; }
-        constexpr Token Advance()       noexcept  { currentToken = GetNextToken(); return currentToken; }
+        constexpr Token Advance()       noexcept  { currentTokenBegin = index; currentToken = NextToken(); return currentToken; }
+
+        // Offset where scanning for the current token started (including the whitespace in front of it), tokenizing again from here yields the same token
+        constexpr size_t CurrentOffset() const noexcept  { return currentTokenBegin < content.size()? currentTokenBegin : content.size(); }
+
+        constexpr std::string_view GetContent()   const noexcept  { return content; }
+        constexpr size_t           GetFirstLine() const noexcept  { return firstLine; }
 
     private:
         constexpr Token GetNextToken() noexcept;
+        constexpr Token NextToken() noexcept
+        {
+            // "count" is 32 bit, a token can't span more than that. Checked here once instead of in every branch of "GetNextToken"
+            Token token = GetNextToken();
+            if(token.type != TokenType::EndOfFile && std::min(index, content.size()) - token.startPosition > MAX_TOKEN_SIZE)
+                token.type = TokenType::Invalid;
+            return token;
+        }
 
     private:
         std::string_view content;
         size_t index;
-        size_t line;
-        size_t lastNewLineIndex;
+        size_t firstLine;
+        size_t currentTokenBegin;
         Token currentToken;
     };
 }
@@ -231,13 +518,34 @@ namespace fdf::detail
 namespace fdf::detail
 {
     struct Test;
+    struct EntryIndex;
 
-    template<auto ERROR_CALLBACK>
+    template<auto ERROR_CALLBACK, ParseOptions OPTIONS = ParseOptions{}>
     struct Utils;
 
+    // Callbacks either take the "Diagnostic" itself, or the error and its formatted message
     template <typename Callable>
-    constexpr bool IsValidErrorCallback = std::is_invocable_r_v<bool, Callable, Error, std::string_view>;
-    inline constexpr auto DefaultErrorCallback = [](Error error, std::string_view message) -> bool  { return true; };
+    constexpr bool IsValidErrorCallback = std::is_invocable_r_v<bool, Callable, const Diagnostic&> || std::is_invocable_r_v<bool, Callable, Error, std::string_view>;
+    inline constexpr auto DefaultErrorCallback = [](const Diagnostic& diagnostic) -> bool  { return true; };
+
+    // The message is only formatted for callbacks that ask for it
+    template<auto ERROR_CALLBACK>
+    constexpr bool ReportError(const Diagnostic& diagnostic)
+    {
+        if constexpr(std::is_invocable_r_v<bool, decltype(ERROR_CALLBACK), const Diagnostic&>)
+            return ERROR_CALLBACK(diagnostic);
+        else
+            return ERROR_CALLBACK(diagnostic.GetError(), diagnostic.ToString());
+    }
+
+    // Used by parallel parsing, so the user callback is never called from two threads at once
+    template<auto ERROR_CALLBACK>
+    inline constexpr auto SerializedErrorCallback = [](const Diagnostic& diagnostic) -> bool
+    {
+        static std::mutex mutex;
+        std::scoped_lock lock(mutex);
+        return ReportError<ERROR_CALLBACK>(diagnostic);
+    };
 
 
     constexpr void constexpr_memcpy(char* dest, const char* src, size_t size)
@@ -262,7 +570,7 @@ namespace fdf::detail
         {
             if(bAfterNewLine)
             {
-                if(std::isspace(c))
+                if(IsSpace(c))
                     continue;
 
                 bAfterNewLine = false;
@@ -285,2635 +593,7608 @@ namespace fdf::detail
         TrimWhitespaceMultilineInPlace(view, temp);
         return temp;
     }
-}
-
-
-
 
 
+    // FNV-1a, can be continued by passing the previous result as "hash"
+    constexpr uint64_t HASH_OFFSET_BASIS = 14695981039346656037ull;
+    constexpr uint64_t HASH_PRIME        = 1099511628211ull;
 
+    constexpr uint64_t HashString(std::string_view view, uint64_t hash = HASH_OFFSET_BASIS) noexcept
+    {
+        for(char c : view)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= HASH_PRIME;
+        }
+        return hash;
+    }
+    constexpr uint64_t HashInteger(uint64_t value, uint64_t hash = HASH_OFFSET_BASIS) noexcept
+    {
+        for(size_t i = 0; i < sizeof(value); i++, value >>= 8)
+        {
+            hash ^= value & 0xFF;
+            hash *= HASH_PRIME;
+        }
+        return hash;
+    }
 
+    // Spreads the bits of a hash, FNV-1a alone leaves the low bits too dependent on each other for bucketing
+    constexpr uint64_t MixHash(uint64_t hash) noexcept
+    {
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ull;
+        hash ^= hash >> 33;
+        return hash;
+    }
 
+    // Entries are keyed by the container key of their parent (-1 for top level entries, see "EntryIndex") and their own segment, array elements by their position
+    // The parent is mixed into a hash of the segment alone, so paths hash their segments once (see "fdf::Path") and probe any parent with them
+    constexpr uint64_t HashKey(uint64_t parentKey, uint64_t segmentHash) noexcept
+    {
+        return MixHash(segmentHash ^ (parentKey * 0x9E3779B97F4A7C15ull));
+    }
+    constexpr uint64_t HashSegment(uint64_t parentKey, std::string_view segment) noexcept
+    {
+        return HashKey(parentKey, HashString(segment));
+    }
+    constexpr uint64_t HashElement(uint64_t parentKey, size_t arrayIndex) noexcept
+    {
+        return HashKey(parentKey, HashInteger(arrayIndex));
+    }
 
 
+    // Segment of a dotted path, hashed before it is looked up. Numeric segments are array positions if their parent is an array
+    struct PathSegment
+    {
+        uint64_t hash = 0;  // "HashString" of the segment
+        uint64_t elementHash = 0;  // "HashInteger" of "arrayIndex"
+        uint32_t offset = 0;  // Position in the path
+        uint32_t size = 0;
+        uint32_t arrayIndex = 0;
+        bool bArrayIndex = false;
+    };
 
+    [[nodiscard]] constexpr size_t CountPathSegments(std::string_view path) noexcept
+    {
+        return std::ranges::count(path, '.') + 1;
+    }
 
+    // "segments" has to have "CountPathSegments(path)" elements
+    constexpr void SplitPath(std::string_view path, std::span<PathSegment> segments) noexcept
+    {
+        size_t offset = 0;
+        for(PathSegment& segment : segments)
+        {
+            const size_t end = std::min(path.find('.', offset), path.size());
+            const std::string_view text = path.substr(offset, end - offset);
+            segment.hash = HashString(text);
+            segment.offset = static_cast<uint32_t>(offset);
+            segment.size = static_cast<uint32_t>(text.size());
+
+            uint64_t arrayIndex = 0;
+            segment.bArrayIndex = !text.empty() && text.size() <= std::numeric_limits<uint32_t>::digits10;
+            for(char c : text)
+            {
+                segment.bArrayIndex = segment.bArrayIndex && c >= '0' && c <= '9';
+                arrayIndex = arrayIndex * 10 + static_cast<uint64_t>(c - '0');
+            }
+            segment.arrayIndex = segment.bArrayIndex? static_cast<uint32_t>(arrayIndex) : 0;
+            segment.elementHash = HashInteger(segment.arrayIndex);
+            offset = end + 1;
+        }
+    }
+}
 
 
 
 
+namespace fdf::detail
+{
+    constexpr size_t FLOAT_TEXT_SIZE = 512;  // Longest fixed notation of a double (smallest subnormal) fits
 
+    // Little endian regardless of the platform, compilers turn it into a single load
+    constexpr uint64_t LoadEightBytes(const char* data) noexcept
+    {
+        uint64_t chunk = 0;
+        for(size_t i = 0; i < 8; i++)
+            chunk |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (i * 8);
+        return chunk;
+    }
+    constexpr bool IsEightDigits(uint64_t chunk) noexcept
+    {
+        return (((chunk + 0x4646464646464646) | (chunk - 0x3030303030303030)) & 0x8080808080808080) == 0;
+    }
+    // Pairs of digits, then pairs of pairs and so on are combined with multiplications instead of 8 dependent multiply-adds
+    constexpr uint64_t ParseEightDigits(uint64_t chunk) noexcept
+    {
+        chunk -= 0x3030303030303030;
+        chunk = (chunk * 10) + (chunk >> 8);
+        return (((chunk & 0x000000FF000000FF) * (100 + (1000000ull << 32))) + (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ull << 32)))) >> 32;
+    }
 
+    // Parses the leading digits of "view", returns how many are consumed or npos if the value doesn't fit into 64 bits
+    constexpr size_t ParseDigits(std::string_view view, uint64_t& value) noexcept
+    {
+        value = 0;
+        size_t i = 0;
+        for(; i + 8 <= view.size() && i < 16; i += 8)  // 16 digits can't overflow, so only the rest is checked
+        {
+            const uint64_t chunk = LoadEightBytes(view.data() + i);
+            if(!IsEightDigits(chunk))
+                break;
+            value = value * 100000000 + ParseEightDigits(chunk);
+        }
 
+        for(; i < view.size() && IsDigit(view[i]); i++)
+        {
+            const uint64_t digit = view[i] - '0';
+            if(value > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+                return std::string_view::npos;
+            value = value * 10 + digit;
+        }
+        return i;
+    }
 
-namespace fdf::detail
-{
-    union Variant
+    // Unsigned integer with just enough arithmetic for "ParseFloat" in constant evaluation, 4096 bits hold every value it needs
+    struct BigInteger
     {
-        bool     b[VARIANT_SIZE];
-        int64_t  i[VARIANT_64BIT_ELEMENT_COUNT];
-        uint64_t u[VARIANT_64BIT_ELEMENT_COUNT];
-        double   f[VARIANT_64BIT_ELEMENT_COUNT];
-        char   str[VARIANT_SIZE];
+        static constexpr size_t WORD_COUNT = 128;
 
-        struct String
-        {
-            constexpr char& operator[](size_t i)       noexcept  { return data[i]; }
-            constexpr char  operator[](size_t i) const noexcept  { return data[i]; }
+        uint32_t words[WORD_COUNT] = {};  // Least significant first
+        size_t wordCount = 0;  // Words in use, the most significant one isn't zero
 
-            constexpr void Delete() noexcept
+        constexpr void MultiplyAdd(uint32_t multiplier, uint32_t addend) noexcept
+        {
+            uint64_t carry = addend;
+            for(size_t i = 0; i < wordCount; i++)
             {
-                delete[] data;
-                capacity = 0;
+                carry += static_cast<uint64_t>(words[i]) * multiplier;
+                words[i] = static_cast<uint32_t>(carry);
+                carry >>= 32;
             }
-            constexpr void Release() noexcept
+            if(carry != 0)
+                words[wordCount++] = static_cast<uint32_t>(carry);
+        }
+        constexpr void MultiplyByPowerOf10(size_t exponent) noexcept
+        {
+            for(; exponent >= 9; exponent -= 9)
+                MultiplyAdd(1'000'000'000, 0);
+            for(; exponent > 0; exponent--)
+                MultiplyAdd(10, 0);
+        }
+        constexpr void ShiftLeft(size_t bitCount) noexcept
+        {
+            if(wordCount == 0)
+                return;
+
+            const size_t wordShift = bitCount / 32;
+            const size_t bitShift = bitCount % 32;
+            words[wordCount + wordShift] = 0;
+            for(size_t i = wordCount; i-- > 0;)
             {
-                data = nullptr;
-                capacity = 0;
+                words[i + wordShift + 1] |= bitShift != 0? words[i] >> (32 - bitShift) : 0;
+                words[i + wordShift] = words[i] << bitShift;
             }
-            constexpr void Reserve(size_t newCapacity)
+            for(size_t i = 0; i < wordShift; i++)
+                words[i] = 0;
+            wordCount += wordShift + 1;
+            Trim();
+        }
+        constexpr void ShiftRightOne() noexcept
+        {
+            for(size_t i = 0; i < wordCount; i++)
+                words[i] = (words[i] >> 1) | (i + 1 < wordCount? words[i + 1] << 31 : 0);
+            Trim();
+        }
+        // Requires "*this >= other"
+        constexpr void Subtract(const BigInteger& other) noexcept
+        {
+            uint64_t borrow = 0;
+            for(size_t i = 0; i < wordCount; i++)
             {
-                if(newCapacity <= capacity)
-                    return;
-
-                char* newData = new char[newCapacity];
-                if(data != nullptr)
-                {
-                    constexpr_memcpy(newData, data, capacity);
-                    delete[] data;
-                }
-                data = newData;
-                capacity = newCapacity;
-                RefreshView();
+                const uint64_t subtrahend = (i < other.wordCount? other.words[i] : 0) + borrow;
+                borrow = words[i] < subtrahend;
+                words[i] = static_cast<uint32_t>(words[i] - subtrahend);
             }
-            constexpr void InitialAllocate(size_t newCapacity)
+            Trim();
+        }
+
+        [[nodiscard]] constexpr bool IsZero() const noexcept  { return wordCount == 0; }
+        [[nodiscard]] constexpr size_t GetBitWidth() const noexcept  { return wordCount != 0? (wordCount - 1) * 32 + std::bit_width(words[wordCount - 1]) : 0; }
+        [[nodiscard]] constexpr std::strong_ordering operator<=>(const BigInteger& other) const noexcept
+        {
+            if(wordCount != other.wordCount)
+                return wordCount <=> other.wordCount;
+            for(size_t i = wordCount; i-- > 0;)
             {
-                data = new char[newCapacity];
-                capacity = newCapacity;
-                RefreshView();
+                if(words[i] != other.words[i])
+                    return words[i] <=> other.words[i];
             }
-            constexpr void Reallocate(size_t newCapacity)
-            {
-                size_t smallest = newCapacity > capacity? capacity : newCapacity;
-                char* newData = new char[capacity];
+            return std::strong_ordering::equal;
+        }
 
-                constexpr_memcpy(newData, data, smallest);
-                delete[] data;
+    private:
+        constexpr void Trim() noexcept
+        {
+            while(wordCount > 0 && words[wordCount - 1] == 0)
+                wordCount--;
+        }
+    };
 
-                data = newData;
-                capacity = newCapacity;
-                RefreshView();
-            }
-            constexpr String Copy() const
-            {
-                String other{};
-                if(capacity > 0 && data != nullptr)
-                {
-                    other.InitialAllocate(capacity);
-                    constexpr_memcpy(other.data, data, capacity);
-                    other.RefreshView();
-                }
+    // Correctly rounded, "view" is an optional '-', digits and an optional fraction
+    // Values under half of the smallest subnormal become zero, only values over the largest double are out of range
+    constexpr bool ParseFloat(std::string_view view, double& value) noexcept
+    {
+        if !consteval
+        {
+            const auto [end, error] = std::from_chars(view.data(), view.data() + view.size(), value);
+            if(end != view.data() + view.size())
+                return false;
+            if(error != std::errc::result_out_of_range)
+                return error == std::errc();
 
-                return other;
+            // from_chars reports underflow like overflow, an underflow has no non zero digit before the dot
+            const std::string_view magnitude = view.substr(view.starts_with('-'));
+            const size_t firstNonZero = magnitude.find_first_not_of('0');
+            if(firstNonZero == std::string_view::npos || magnitude[firstNonZero] != '.')
+                return false;
+            value = view.starts_with('-')? -0.0 : 0.0;
+            return true;
+        }
+
+        // from_chars isn't usable in constant evaluation, so the value is divided out exactly with big integers.
+        // Halfway points between doubles have at most 767 significant digits, digits after the first 800 only matter for being non zero
+        constexpr size_t MAX_SIGNIFICANT_DIGITS = 800;
+
+        const bool bIsNegative = view.starts_with('-');
+        if(bIsNegative)
+            view.remove_prefix(1);
+
+        // The value is "digits * 10^exponent", rounded up a tiny bit if "bInexact"
+        BigInteger digits;
+        int64_t exponent = 0;
+        size_t keptDigitCount = 0;
+        bool bInexact = false;
+        bool bHasDigit = false;
+        bool bAfterDot = false;
+        for(char c : view)
+        {
+            if(c == '.' && !bAfterDot)
+            {
+                bAfterDot = true;
+                continue;
             }
-            constexpr String Move() noexcept
+            if(!IsDigit(c))
+                return false;
+
+            bHasDigit = true;
+            if(keptDigitCount == 0 && c == '0')
+                exponent -= bAfterDot;  // Leading zeros
+            else if(keptDigitCount < MAX_SIGNIFICANT_DIGITS)
             {
-                String other = *this;
-                *this = {};
-                return other;
+                digits.MultiplyAdd(10, c - '0');
+                keptDigitCount++;
+                exponent -= bAfterDot;
             }
-            constexpr void RefreshView() noexcept
+            else
             {
-                view = std::string_view(data, capacity);
+                exponent += !bAfterDot;
+                bInexact |= c != '0';
             }
+        }
 
-            size_t capacity;
-            char* data;
-            std::string_view view;
-        } strDynamic;
+        if(!bHasDigit)
+            return false;
+        if(digits.IsZero())
+        {
+            value = bIsNegative? -0.0 : 0.0;
+            return true;
+        }
 
-    public:
-        constexpr  Variant() noexcept  { }
-        constexpr ~Variant() noexcept  { }
-    };
-}
+        // Value is below 10^(decimalExponent + 1), under half of the smallest subnormal it rounds to zero and over the largest double it is out of range
+        const int64_t decimalExponent = static_cast<int64_t>(keptDigitCount) + exponent - 1;
+        if(decimalExponent > 308)
+            return false;
+        if(decimalExponent < -325)
+        {
+            value = bIsNegative? -0.0 : 0.0;
+            return true;
+        }
 
+        BigInteger numerator = digits;
+        BigInteger denominator;
+        denominator.MultiplyAdd(0, 1);
+        if(exponent >= 0)
+            numerator.MultiplyByPowerOf10(static_cast<size_t>(exponent));
+        else
+            denominator.MultiplyByPowerOf10(static_cast<size_t>(-exponent));
+
+        // quotient = numerator * 2^shift / denominator has 63 or 64 bits, the remainder only matters for rounding
+        const int64_t shift = 63 - (static_cast<int64_t>(numerator.GetBitWidth()) - static_cast<int64_t>(denominator.GetBitWidth()));
+        if(shift > 0)
+            numerator.ShiftLeft(static_cast<size_t>(shift));
+        else
+            denominator.ShiftLeft(static_cast<size_t>(-shift));
+
+        uint64_t quotient = 0;
+        denominator.ShiftLeft(63);
+        for(int bit = 63; bit >= 0; bit--)
+        {
+            if(numerator >= denominator)
+            {
+                numerator.Subtract(denominator);
+                quotient |= uint64_t(1) << bit;
+            }
+            denominator.ShiftRightOne();
+        }
+        bInexact |= !numerator.IsZero();
 
+        // Lowest bit the double can keep, subnormals keep less than 53 bits
+        const int64_t binaryExponent = static_cast<int64_t>(std::bit_width(quotient)) - 1 - shift;
+        const int64_t lowestBit = std::max<int64_t>(binaryExponent - 52, -1074);
+        const int64_t droppedBitCount = lowestBit + shift;
 
+        uint64_t mantissa;
+        bool bRoundUp;
+        if(droppedBitCount < 64)
+        {
+            mantissa = quotient >> droppedBitCount;
+            const uint64_t remainder = quotient & ((uint64_t(1) << droppedBitCount) - 1);
+            const uint64_t half = uint64_t(1) << (droppedBitCount - 1);
+            bRoundUp = remainder > half || (remainder == half && (bInexact || (mantissa & 1) != 0));
+        }
+        else
+        {
+            mantissa = 0;
+            bRoundUp = droppedBitCount == 64 && (quotient > (uint64_t(1) << 63) || (quotient == (uint64_t(1) << 63) && bInexact));
+        }
+        mantissa += bRoundUp;
 
-FDF_EXPORT namespace fdf
-{
-    template<auto ERROR_CALLBACK = detail::DefaultErrorCallback> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
-    class IO;
+        // A subnormal mantissa that rounds up to 2^52 becomes the smallest normal double through the same bit pattern
+        uint64_t bits = mantissa;
+        if(mantissa >= (uint64_t(1) << 52) && lowestBit > -1074)
+        {
+            const uint64_t biasedExponent = static_cast<uint64_t>(lowestBit + 52 + 1023) + (mantissa >> 53);
+            if(biasedExponent >= 2047)
+                return false;
+            bits = (biasedExponent << 52) | ((mantissa >> (mantissa >> 53)) & ((uint64_t(1) << 52) - 1));
+        }
+        value = std::bit_cast<double>(bits | (static_cast<uint64_t>(bIsNegative) << 63));
+        return true;
+    }
 
-    class Entry
+    // Shortest text that parses back to the same value. Always fixed notation with a dot, the tokenizer has no exponents and "1" would be an int
+    // There is no spelling for infinity and NaN, "ParseFloat" and "IO::LoadBinary" never make them
+    inline void AppendFloat(std::string& buffer, double value)
     {
-        friend struct detail::Test;
+        char text[FLOAT_TEXT_SIZE];
+        const std::string_view view(text, std::to_chars(text, std::end(text), value, std::chars_format::fixed).ptr);
+        buffer.append(view);
+        if(view.find('.') == std::string_view::npos)
+            buffer.append(".0");
+    }
+}
 
-        template<auto ERROR_CALLBACK>
-        friend struct detail::Utils;
 
-        template<auto ERROR_CALLBACK> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
-        friend class IO;
 
-        static Entry INVALID;
 
-    private:
-        Type type = Type::Invalid;
-        uint8_t depth = 0;  // Depth of the entry (0 for top level, 1 for child of top level, 2 for grandchild of top level, ...)
-        uint8_t identifierSize = 0;
-        uint32_t size = 0;  // If Array or Map this is count of top level childs, otherwise type specific (for example: character count for string)
+namespace fdf::detail
+{
+    constexpr size_t STRUCTURAL_BLOCK_SIZE = 64;
+    constexpr size_t STREAM_CHUNK_SIZE = 64 * 1024;
+    constexpr size_t PARALLEL_PARSE_MIN_RANGE_SIZE = 64 * 1024;  // Smaller ranges cost more in thread startup and merging than they save
+    constexpr size_t SIZE_ESTIMATE_THRESHOLD = 64 * 1024;  // The estimate takes about a tenth of what reserving saves in growing the entries and the index, below this it doesn't matter
 
-        detail::Variant data;
-        std::string fullIdentifier;
+    // Bit N of each mask is set if the N-th character of the block matches
+    struct StructuralMasks
+    {
+        uint64_t quote;         // " and '
+        uint64_t backslash;
+        uint64_t braceOpen;     // { and [
+        uint64_t equal;
+        uint64_t comma;
+        uint64_t newLine;
+        uint64_t commentStart;  // "/", both "//" and "/*" start with it
 
-#if !FDF_NO_COMMENTS
-    public:
-        std::string comment;
-#endif
+        [[nodiscard]] constexpr uint64_t All() const noexcept  { return quote | backslash | braceOpen | equal | comma | newLine | commentStart; }
 
-    public:
-        constexpr Entry() noexcept = default;
-        constexpr ~Entry() noexcept
-        {
-            if((type == Type::String || type == Type::Hex || type == Type::Timestamp) && size > detail::VARIANT_SIZE - 1)
-                data.strDynamic.Delete();
-        }
+        constexpr bool operator==(const StructuralMasks&) const noexcept = default;
+    };
+
+    struct SizeEstimate
+    {
+        size_t entryCountEstimate = 0;
+        size_t stringByteCount = 0;
+    };
 
 
-        constexpr Entry(const Entry& other)
-            : type(other.type), depth(other.depth), identifierSize(other.identifierSize), size(other.size), fullIdentifier(other.fullIdentifier)
-        #if !FDF_NO_COMMENTS
-            , comment(other.comment)
-        #endif
+    // "block" must have STRUCTURAL_BLOCK_SIZE readable bytes
+    constexpr StructuralMasks ClassifyBlock(const char* block) noexcept
+    {
+        if !consteval
         {
-            if((type == Type::String || type == Type::Hex || type == Type::Timestamp) && size > detail::VARIANT_SIZE - 1)
-                data.strDynamic = other.data.strDynamic.Copy();
-            else
-                data = other.data;
-        }
-        constexpr Entry(Entry&& other) noexcept
-            : type(other.type), depth(other.depth), identifierSize(other.identifierSize), size(other.size), fullIdentifier(std::move(other.fullIdentifier))
-        #if !FDF_NO_COMMENTS
-            , comment(std::move(other.comment))
+        #if FDF_SIMD_AVX2
+            auto classify = [block](char c) -> uint64_t
+            {
+                const __m256i needle = _mm256_set1_epi8(c);
+                const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+                const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+                return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle))) |
+                       static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)))) << 32;
+            };
+        #elif FDF_SIMD_SSE2
+            auto classify = [block](char c) -> uint64_t
+            {
+                const __m128i needle = _mm_set1_epi8(c);
+                uint64_t mask = 0;
+                for(size_t i = 0; i < 4; i++)
+                {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+                    mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)))) << (i * 16);
+                }
+                return mask;
+            };
+        #elif FDF_SIMD_NEON
+            auto classify = [block](char c) -> uint64_t
+            {
+                const uint8x16_t needle = vdupq_n_u8(static_cast<uint8_t>(c));
+                const uint8x16_t bits = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+                const uint8_t* data = reinterpret_cast<const uint8_t*>(block);
+                uint8x16_t t0 = vandq_u8(vceqq_u8(vld1q_u8(data     ), needle), bits);
+                uint8x16_t t1 = vandq_u8(vceqq_u8(vld1q_u8(data + 16), needle), bits);
+                uint8x16_t t2 = vandq_u8(vceqq_u8(vld1q_u8(data + 32), needle), bits);
+                uint8x16_t t3 = vandq_u8(vceqq_u8(vld1q_u8(data + 48), needle), bits);
+                uint8x16_t sum = vpaddq_u8(vpaddq_u8(t0, t1), vpaddq_u8(t2, t3));
+                sum = vpaddq_u8(sum, sum);
+                return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+            };
         #endif
-        {
-            if((type == Type::String || type == Type::Hex || type == Type::Timestamp) && size > detail::VARIANT_SIZE - 1)
-                data.strDynamic = other.data.strDynamic.Move();
-            else
-                data = other.data;
 
-            other.type = Type::Invalid;
+        #if FDF_SIMD_AVX2 || FDF_SIMD_SSE2 || FDF_SIMD_NEON
+            StructuralMasks masks;
+            masks.quote        = classify('\"') | classify('\'');
+            masks.backslash    = classify('\\');
+            masks.braceOpen    = classify('{') | classify('[');
+            masks.equal        = classify('=');
+            masks.comma        = classify(',');
+            masks.newLine      = classify('\n');
+            masks.commentStart = classify('/');
+            return masks;
+        #endif
         }
 
-
-        constexpr Entry& operator=(const Entry& other)
+        StructuralMasks masks = {};
+        for(size_t i = 0; i < STRUCTURAL_BLOCK_SIZE; i++)
         {
-            if(this != &other)
+            const uint64_t bit = uint64_t(1) << i;
+            switch(block[i])
             {
-                type = other.type;
-                depth = other.depth;
-                identifierSize = other.identifierSize;
-                size = other.size;
-                fullIdentifier = other.fullIdentifier;
-            #if !FDF_NO_COMMENTS
-                comment = other.comment;
-            #endif
-
-                if((type == Type::String || type == Type::Hex || type == Type::Timestamp) && size > detail::VARIANT_SIZE - 1)
-                    data.strDynamic.Delete();
-
-                if((type == Type::String || type == Type::Hex || type == Type::Timestamp) && size > detail::VARIANT_SIZE - 1)
-                    data.strDynamic = other.data.strDynamic.Copy();
-                else
-                    data = other.data;
+                case '\"': case '\'': masks.quote        |= bit; break;
+                case '\\':            masks.backslash    |= bit; break;
+                case '{': case '[':   masks.braceOpen    |= bit; break;
+                case '=':             masks.equal        |= bit; break;
+                case ',':             masks.comma        |= bit; break;
+                case '\n':            masks.newLine      |= bit; break;
+                case '/':             masks.commentStart |= bit; break;
+                default: break;
             }
-            return *this;
         }
-        constexpr Entry& operator=(Entry&& other) noexcept
+        return masks;
+    }
+
+
+    // Pre-size estimator: classifies the content 64 bytes at a time and then only visits the structural characters, skipping strings and comments
+    // The Tokenizer doesn't use the masks, the result is only used to reserve the entries and the index before parsing
+    constexpr SizeEstimate EstimateSizes(std::string_view content) noexcept
+    {
+        enum class State : uint8_t { Default, DoubleQuoteString, SingleQuoteString, LineComment, BlockComment };
+
+        SizeEstimate result;
+        State state = State::Default;
+        size_t stringStart = 0;
+        size_t commentStart = 0;
+        size_t separatorCount = 0;
+        size_t valueCount = 0;
+
+        auto at = [&content](size_t i) -> char  { return i < content.size()? content[i] : '\0'; };
+        auto isEscapedQuote = [&content](size_t i) -> bool  { return i >= 2 && content[i - 1] == '\\' && content[i - 2] != '\\'; };  // Same rule as Tokenizer
+
+        char tail[STRUCTURAL_BLOCK_SIZE] = {};
+        for(size_t blockStart = 0; blockStart < content.size(); blockStart += STRUCTURAL_BLOCK_SIZE)
         {
-            if(this != &other)
+            const char* block = content.data() + blockStart;
+            if(content.size() - blockStart < STRUCTURAL_BLOCK_SIZE)
             {
-                type = other.type;
-                depth = other.depth;
-                identifierSize = other.identifierSize;
-                size = other.size;
-                fullIdentifier = std::move(other.fullIdentifier);
-            #if !FDF_NO_COMMENTS
-                comment = std::move(other.comment);
-            #endif
+                for(size_t i = 0; i < STRUCTURAL_BLOCK_SIZE; i++)
+                    tail[i] = at(blockStart + i);
+                block = tail;
+            }
 
-                if((type == Type::String || type == Type::Hex || type == Type::Timestamp) && size > detail::VARIANT_SIZE - 1)
-                    data.strDynamic.Delete();
-                
-                if((type == Type::String || type == Type::Hex || type == Type::Timestamp) && size > detail::VARIANT_SIZE - 1)
-                    data.strDynamic = other.data.strDynamic.Move();
-                else
-                    data = other.data;
+            const StructuralMasks masks = ClassifyBlock(block);
+            for(uint64_t bits = masks.All() & ~masks.backslash; bits != 0; bits &= bits - 1)
+            {
+                const size_t offset = std::countr_zero(bits);
+                const size_t i = blockStart + offset;
+                const char c = block[offset];
 
-                other.type = Type::Invalid;
+                switch(state)
+                {
+                    case State::Default:
+                        if(c == '\"' || c == '\'')
+                        {
+                            state = c == '\"'? State::DoubleQuoteString : State::SingleQuoteString;
+                            stringStart = i + 1;
+                        }
+                        else if(c == '/' && at(i + 1) == '/')
+                            state = State::LineComment;
+                        else if(c == '/' && at(i + 1) == '*')
+                        {
+                            state = State::BlockComment;
+                            commentStart = i + 2;
+                        }
+                        else if(c == '\n' || c == ',')
+                            separatorCount++;
+                        else if(c == '=' || c == '{' || c == '[')
+                            valueCount++;
+                        break;
+
+                    case State::DoubleQuoteString:
+                    case State::SingleQuoteString:
+                        if(c == (state == State::DoubleQuoteString? '\"' : '\'') && !isEscapedQuote(i))
+                        {
+                            result.stringByteCount += i - stringStart;
+                            state = State::Default;
+                        }
+                        break;
+
+                    case State::LineComment:
+                        if(c == '\n')
+                        {
+                            separatorCount++;
+                            state = State::Default;
+                        }
+                        break;
+
+                    case State::BlockComment:
+                        if(c == '/' && i > commentStart && content[i - 1] == '*')  // The star of "/*" doesn't close it, "/*/" is still open
+                            state = State::Default;
+                        break;
+                }
             }
-            return *this;
         }
 
-    public:
-        [[nodiscard]] constexpr size_t GetChildCount()         const noexcept  { return IsContainer()? data.u[0] : 0; }
-        [[nodiscard]] constexpr size_t GetTopLevelChildCount() const noexcept  { return IsContainer()? size : 0; }
+        result.entryCountEstimate = std::max(separatorCount, valueCount);
+        return result;
+    }
 
-        [[nodiscard]] constexpr uint8_t  GetDepth()      const noexcept  { return depth; }
-        [[nodiscard]] constexpr Type     GetType()       const noexcept  { return type; }
-        [[nodiscard]] constexpr bool     IsValid()       const noexcept  { return type != Type::Invalid; }
-        [[nodiscard]] constexpr bool     IsNull()        const noexcept  { return type == Type::Null; }
-        [[nodiscard]] constexpr bool     IsNil()         const noexcept  { return IsNull(); }
-        [[nodiscard]] constexpr bool     IsContainer()   const noexcept  { return type == Type::Array || type == Type::Map; }
-        [[nodiscard]] constexpr bool     HasValue()      const noexcept  { return IsValid() && !IsNull() && !IsContainer(); }
 
 
-        [[nodiscard]] constexpr std::string_view GetFullIdentifier() const noexcept
+    // Resumable scanner that finds where top level entries can end: new lines that are outside of any container, string or comment
+    // It follows the same string and comment rules as the Tokenizer, but it doesn't validate anything
+    struct TopLevelScanner
+    {
+        // Continues from where the previous call stopped, returns the offset right after the last top level new line in the newly scanned part or "npos"
+        constexpr size_t Scan(std::string_view content) noexcept
         {
-            return fullIdentifier;
+            size_t lastBoundary = std::string_view::npos;
+            for(; position < content.size(); position++)
+            {
+                const char c = content[position];
+                switch(state)
+                {
+                    case State::Default:
+                        if(c == '\"' || c == '\'')
+                        {
+                            state = c == '\"'? State::DoubleQuoteString : State::SingleQuoteString;
+                            if(depth <= 0)
+                                entryState = EntryState::Complete;
+                        }
+                        else if(c == '/')
+                        {
+                            if(position + 1 >= content.size())
+                                return lastBoundary;  // Can't decide until the next character is available
+
+                            if(content[position + 1] == '/' || content[position + 1] == '*')
+                            {
+                                state = content[position + 1] == '/'? State::LineComment : State::BlockComment;
+                                position += state == State::BlockComment? 2 : 1;  // The star of "/*" doesn't close it, "/*/" is still open
+                                if(depth <= 0 && entryState == EntryState::None)
+                                    bPendingComment = true;  // Belongs to the next entry, a comment after a value on the same line belongs to that entry
+                            }
+                        }
+                        else if(c == '{' || c == '[')
+                            depth++;
+                        else if(c == '}' || c == ']')
+                        {
+                            if(--depth <= 0)
+                                entryState = EntryState::Complete;
+                        }
+                        else if(c == '\n')
+                            TryAddBoundary(lastBoundary);
+                        else if(depth <= 0 && !IsSpace(c))
+                        {
+                            if(c == '=')
+                                entryState = EntryState::Equal;
+                            else if(entryState == EntryState::None || entryState == EntryState::Equal)
+                            {
+                                entryState = entryState == EntryState::None? EntryState::Identifier : EntryState::Complete;
+                                bPendingComment = false;
+                            }
+                        }
+                        break;
+
+                    case State::DoubleQuoteString:
+                    case State::SingleQuoteString:
+                        if(c == (state == State::DoubleQuoteString? '\"' : '\'') && !(content[position - 1] == '\\' && (position < 2 || content[position - 2] != '\\')))
+                            state = State::Default;
+                        break;
+
+                    case State::LineComment:
+                        if(c == '\n')
+                        {
+                            state = State::Default;
+                            TryAddBoundary(lastBoundary);
+                        }
+                        break;
+
+                    case State::BlockComment:
+                        if(c == '/' && content[position - 1] == '*')
+                            state = State::Default;
+                        break;
+                }
+            }
+
+            return lastBoundary;
         }
-        [[nodiscard]] constexpr std::string_view GetIdentifier() const noexcept
+
+        // Call after removing "count" characters from the front of the scanned content
+        constexpr void Rebase(size_t count) noexcept  { position -= count; }
+
+    private:
+        // A new line is only a boundary if the entry before it is complete, "a =" and "a" can still continue on the next line
+        // Nor if a comment is waiting for the next entry, it would be cut off from the entry it is attached to
+        constexpr void TryAddBoundary(size_t& lastBoundary) noexcept
         {
-            return std::string_view(fullIdentifier.data() + fullIdentifier.size() - identifierSize, identifierSize);
+            if(depth > 0 || entryState == EntryState::Identifier || entryState == EntryState::Equal || bPendingComment)
+                return;
+
+            lastBoundary = position + 1;
+            entryState = EntryState::None;
         }
-        [[nodiscard]] constexpr std::string_view GetIdentifierWithDot() const noexcept
+
+    private:
+        enum class State : uint8_t { Default, DoubleQuoteString, SingleQuoteString, LineComment, BlockComment };
+        enum class EntryState : uint8_t { None, Identifier, Equal, Complete };
+
+        size_t position = 0;
+        int64_t depth = 0;
+        State state = State::Default;
+        EntryState entryState = EntryState::None;
+        bool bPendingComment = false;
+    };
+}
+
+
+
+
+#if FDF_MMAP
+namespace fdf::detail
+{
+    // Read only view of a whole file. Regular files are mapped directly, everything else (pipes, character devices, ...) is read into memory
+    // Files that report a size of 0 are read as well, procfs and sysfs only generate their content when it is read
+    // Truncating a mapped file raises SIGBUS on the next access to the lost pages, only files nobody else writes to should stay mapped
+    class MappedFile
+    {
+    public:
+        MappedFile() noexcept = default;
+        ~MappedFile() noexcept
         {
-            return std::string_view(fullIdentifier.data() + fullIdentifier.size() - identifierSize - 1, identifierSize + 1);
+            if(mapping != nullptr)
+                ::munmap(mapping, mappingSize);
         }
-        [[nodiscard]] constexpr std::string_view GetParentIdentifier() const noexcept
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+    public:
+        // "bAllowMapping" is false for files that may be truncated while they are in use, reading a truncated mapping raises SIGBUS
+        [[nodiscard]] bool Open(const std::filesystem::path& filepath, bool bAllowMapping = true) noexcept
         {
-            return std::string_view(fullIdentifier.data(), fullIdentifier.size() - identifierSize - 1);
+            const int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+            if(fd < 0)
+                return false;
+
+            struct stat status;
+            const bool bResult = ::fstat(fd, &status) == 0 && (S_ISREG(status.st_mode) && status.st_size > 0 && bAllowMapping? Map(fd, status.st_size) : Read(fd));
+            ::close(fd);
+            return bResult;
         }
-        [[nodiscard]] constexpr std::string_view GetParentIdentifierWithDot() const noexcept
+
+        [[nodiscard]] std::string_view View() const noexcept
         {
-            return std::string_view(fullIdentifier.data(), fullIdentifier.size() - identifierSize);
+            return mapping != nullptr? std::string_view(static_cast<const char*>(mapping), mappingSize) : std::string_view(buffer);
         }
 
-        constexpr void SetIdentifier(std::string_view newIdentifier)
+    private:
+        [[nodiscard]] bool Map(int fd, size_t size) noexcept
         {
-            if(newIdentifier.empty())
-                throw std::runtime_error("Identifier can't be empty");
+            void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(address == MAP_FAILED)
+                return Read(fd);
 
-            fullIdentifier.resize(fullIdentifier.size() - identifierSize);
-            fullIdentifier += newIdentifier;
-            identifierSize = newIdentifier.size();
+            ::madvise(address, size, MADV_SEQUENTIAL);
+            mapping = address;
+            mappingSize = size;
+            return true;
         }
 
-
-        template<Style STYLE = {}>
-        [[nodiscard]] constexpr std::string_view DataToView(std::string& temp) const
+        // Uses pread so the file position is left alone, falls back to read for the ones that can't seek
+        [[nodiscard]] bool Read(int fd) noexcept
         {
-            switch(type)
+            bool bCanSeek = true;
+            while(true)
             {
-                case Type::Invalid: return detail::INVALID_TEXT;
-                case Type::Null:    if constexpr(STYLE.bUseNilInsteadOfNull) return detail::KEYWORDS[1]; return detail::KEYWORDS[0];
-                case Type::Array:   return detail::ARRAY_TEXT;
-                case Type::Map:     return detail::MAP_TEXT;
+                const size_t offset = buffer.size();
+                buffer.resize(offset + STREAM_CHUNK_SIZE);
 
-                case Type::String:
-                case Type::Timestamp:
-                    return size > detail::VARIANT_SIZE - 1? data.strDynamic.view.substr(0, size) : std::string_view(data.str, size);
-                
-                case Type::Hex:
-                {
-                    std::string_view view = size > detail::VARIANT_SIZE - 1? data.strDynamic.view.substr(0, size) : std::string_view(data.str, size);
+                const ssize_t count = bCanSeek? ::pread(fd, buffer.data() + offset, STREAM_CHUNK_SIZE, offset) : ::read(fd, buffer.data() + offset, STREAM_CHUNK_SIZE);
+                buffer.resize(offset + std::max<ssize_t>(count, 0));
 
-                    if constexpr(STYLE.bUppercaseHex)
-                    {
-                        temp = view;
-                        std::ranges::transform(temp, temp.begin(), [](unsigned char c)  { return std::toupper(c); });
-                        return temp;
-                    }
+                if(count > 0)
+                    continue;
+                if(count == 0)
+                    return true;
+                if(errno == ESPIPE && bCanSeek && offset == 0)
+                    bCanSeek = false;
+                else if(errno != EINTR)
+                    return false;
+            }
+        }
 
-                    return view;
-                }
+    private:
+        void* mapping = nullptr;
+        size_t mappingSize = 0;
+        std::string buffer;
+    };
+}
+#endif
 
-                case Type::Version:
-                    if(data.u[3] == 0)
-                        temp = std::format("{}.{}.{}", data.u[0], data.u[1], data.u[2]);
-                    else
-                        temp = std::format("{}.{}.{}.{}", data.u[0], data.u[1], data.u[2], data.u[3]);
-                    return temp;
 
-                case Type::Bool:
-                    temp = std::format("{}", (data.b[0]? detail::KEYWORDS[2] : detail::KEYWORDS[3]));
-                    for(int i = 1; i < size; i++)
-                        temp = std::format("{}x{}", temp, (data.b[i]? detail::KEYWORDS[2] : detail::KEYWORDS[3]));
-                    return temp;
 
-                case Type::Int:
-                    temp = std::format("{}", data.i[0]);
-                    for(int i = 1; i < size; i++)
-                        temp = std::format("{}x{}", temp, data.i[i]);
-                    return temp;
 
-                case Type::UInt:
-                    temp = std::format("{}", data.u[0]);
-                    for(int i = 1; i < size; i++)
-                        temp = std::format("{}x{}", temp, data.u[i]);
-                    return temp;
+namespace fdf::detail
+{
+    // Layout of "IO::WriteBinary": header, one record per entry (same order as the entry vector), slots of "EntryIndex", then the blob
+    // Blob holds strings, identifiers and comments, loaded entries point into it instead of copying them
+    constexpr uint32_t BINARY_MAGIC = 0x42464446;  // "FDFB", read back differently on a machine with another byte order
+    constexpr uint32_t BINARY_VERSION = 3;  // 2: keys of "EntryIndex" hash the parent and the segment separately, 3: parents are hashed by their container key
 
-                case Type::Float:
-                    temp = std::format("{:.1f}", data.f[0]);
-                    for(int i = 1; i < size; i++)
-                        temp = std::format("{}x{:.1f}", temp, data.f[i]);
-                    return temp;
+    struct BinaryHeader
+    {
+        uint32_t magic = BINARY_MAGIC;
+        uint32_t version = BINARY_VERSION;
+        uint64_t recordSize = 0;
+        uint64_t entryCount = 0;
+        uint64_t topLevelEntryCount = 0;
+        uint64_t slotsSize = 0;  // Bytes of the identifier index, stored between the records and the blob
+        uint64_t blobSize = 0;
+        uint64_t fileCommentOffset = 0;
+        uint64_t fileCommentSize = 0;
+        uint64_t checksum = 0;  // Of everything after the header
+    };
 
-                default:
-                    std::unreachable();
-                    return {};
+    struct BinaryRecord
+    {
+        Type type = Type::Invalid;
+        uint8_t depth = 0;
+        uint8_t identifierSize = 0;
+        bool bHasIdentifier = false;  // Array elements don't have one
+        uint32_t size = 0;
+        uint32_t parentOffset = 0;
+        uint32_t arrayIndex = 0;
+        uint64_t identifierOffset = 0;
+        uint64_t commentOffset = 0;
+        uint64_t commentSize = 0;
+        uint64_t payload[VARIANT_64BIT_ELEMENT_COUNT] = {};  // Bytes of "Variant", strings store their blob offset in the first element instead
+    };
+    static_assert(sizeof(BinaryRecord) == 40 + VARIANT_SIZE);
+
+    // Four independent lanes over 64 bit words, so verifying a mapped file costs about as much as faulting its pages in
+    inline uint64_t Checksum(std::string_view data) noexcept
+    {
+        constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+
+        uint64_t lanes[4] = { PRIME_1, PRIME_2, ~PRIME_1, ~PRIME_2 };
+        size_t i = 0;
+        for(; i + sizeof(lanes) <= data.size(); i += sizeof(lanes))
+        {
+            for(size_t lane = 0; lane < 4; lane++)
+            {
+                uint64_t word;
+                std::memcpy(&word, data.data() + i + lane * sizeof(word), sizeof(word));
+                lanes[lane] = std::rotl(lanes[lane] + word * PRIME_2, 31) * PRIME_1;
             }
-        };
+        }
 
+        uint64_t hash = data.size();
+        for(uint64_t lane : lanes)
+            hash = std::rotl(hash ^ lane, 27) * PRIME_1;
+        for(; i < data.size(); i++)
+            hash = (hash ^ static_cast<uint8_t>(data[i])) * PRIME_2;
+        return hash ^ (hash >> 29);
+    }
 
+    constexpr uint64_t DEFAULT_PARSE_CACHE_SIZE = 1024 * 1024 * 1024;
+}
 
 
-        template<typename T>
-        [[nodiscard]] constexpr auto GetValue() const  { }
-        template<typename T>
-        [[nodiscard]] constexpr auto GetValueUnsafe() const  { }
-    };
 
 
+FDF_EXPORT namespace fdf
+{
+    // Binary images (see "IO::WriteBinary") of parsed files for "IO::Parse(filepath, cache)", processes using the same directory share them
+    // Images are named after the hash of the file contents, a stamp per file remembers its size and modification time so unchanged files aren't hashed again
+    // A file rewritten with the same size within the resolution of its modification time looks unchanged, same as with make
+    class ParseCache
+    {
+        template<auto ERROR_CALLBACK> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
+        friend class IO;
 
+    public:
+        // Least recently used images are removed when the directory grows over "maxSize" bytes
+        explicit ParseCache(std::filesystem::path directory, uint64_t maxSize = detail::DEFAULT_PARSE_CACHE_SIZE)
+            : directory(std::move(directory)), maxSize(maxSize)  { }
 
+        ParseCache(const ParseCache&) = delete;
+        ParseCache& operator=(const ParseCache&) = delete;
 
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValue<bool>() const
-    {
-        if(type != Type::Bool)
-            throw std::runtime_error("Non matching type is not 'bool'");
-        return std::span<const bool>(data.b, size);
-    }
+        [[nodiscard]] const std::filesystem::path& GetDirectory() const noexcept  { return directory; }
+        [[nodiscard]] uint64_t                     GetMaxSize()   const noexcept  { return maxSize; }
 
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValue<int64_t>() const
-    {
-        if(type != Type::Int)
-            throw std::runtime_error("Non matching type is not 'int64_t'");
-        return std::span<const int64_t>(data.i, size);
-    }
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValue<int>() const { return GetValue<int64_t>(); }
-
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValue<uint64_t>() const
-    {
-        if(type != Type::UInt && type != Type::Version)
-            throw std::runtime_error("Non matching type is not 'uint64_t'");
-        return std::span<const uint64_t>(data.u, size);
-    }
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValue<unsigned int>() const { return GetValue<uint64_t>(); }
-
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValue<double>() const
-    {
-        if(type != Type::Float)
-            throw std::runtime_error("Non matching type is not 'double'");
-        return std::span<const double>(data.f, size);
-    }
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValue<float>() const { return GetValue<double>(); }
-
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValue<char>() const
-    {
-        if(type != Type::String && type != Type::Hex && type != Type::Timestamp)
-            throw std::runtime_error("Non matching type is not 'string'");
-
-        if(size > detail::VARIANT_SIZE - 1)
-            return std::string_view(data.strDynamic.data, size);
-        return std::string_view(data.str, size);
-    }
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValue<std::string>() const { return GetValue<char>(); }
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValue<std::string_view>() const { return GetValue<char>(); }
-
-
-
-
-
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<bool>() const
-    {
-        return std::span<const bool>(data.b, size);
-    }
-
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<int64_t>() const
-    {
-        return std::span<const int64_t>(data.i, size);
-    }
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<int>() const { return GetValueUnsafe<int64_t>(); }
+        inline void Evict() noexcept
+        {
+            try
+            {
+                struct CachedFile
+                {
+                    std::filesystem::path path;
+                    std::filesystem::file_time_type time;
+                    uintmax_t size = 0;
+                };
 
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<uint64_t>() const
-    {
-        return std::span<const uint64_t>(data.u, size);
-    }
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<unsigned int>() const { return GetValueUnsafe<uint64_t>(); }
+                std::vector<CachedFile> files;
+                uint64_t totalSize = 0;
+                std::error_code ec;
+                const std::filesystem::file_time_type tempCutoff = std::filesystem::file_time_type::clock::now() - TEMP_GRACE_PERIOD;
+                for(auto it = std::filesystem::directory_iterator(directory, ec); !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+                {
+                    const std::filesystem::path extension = it->path().extension();
+                    if(!it->is_regular_file(ec) || (extension != IMAGE_EXTENSION && extension != STAMP_EXTENSION && extension != TEMP_EXTENSION))
+                        continue;
 
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<double>() const
-    {
-        return std::span<const double>(data.f, size);
-    }
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<float>() const { return GetValueUnsafe<double>(); }
+                    // Recent temporary files may still be written by another process, only ones left behind by a crash are removed
+                    const std::filesystem::file_time_type time = it->last_write_time(ec);
+                    if(extension == TEMP_EXTENSION && time > tempCutoff)
+                        continue;
 
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<char>() const
-    {
-        if(size > detail::VARIANT_SIZE - 1)
-            return std::string_view(data.strDynamic.data, size);
-        return std::string_view(data.str, size);
-    }
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<std::string>() const { return GetValueUnsafe<char>(); }
-    template<>
-    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<std::string_view>() const { return GetValueUnsafe<char>(); }
-}
+                    files.push_back({ it->path(), time, it->file_size(ec) });
+                    totalSize += files.back().size;
+                }
 
-inline fdf::Entry fdf::Entry::INVALID;
+                if(totalSize <= maxSize)
+                    return;
 
+                std::ranges::sort(files, {}, &CachedFile::time);
+                for(const CachedFile& file : files)
+                {
+                    if(totalSize <= maxSize)
+                        break;
+                    if(std::filesystem::remove(file.path, ec))
+                        totalSize -= file.size;
+                }
+            }
+            catch(...)
+            {
+                // Allocation failures are ignored like file system errors, a later call evicts again
+            }
+        }
 
+    private:
+        struct Stamp
+        {
+            int64_t modificationTime = 0;  // Nanoseconds
+            uint64_t fileSize = 0;
+            uint64_t contentKey = 0;  // Hash of the contents, names the image
 
+            [[nodiscard]] bool IsSameFile(const Stamp& other) const noexcept  { return modificationTime == other.modificationTime && fileSize == other.fileSize; }
+        };
+        struct StampFile
+        {
+            uint32_t magic = detail::BINARY_MAGIC;
+            uint32_t version = detail::BINARY_VERSION;
+            Stamp stamp;
+        };
 
+        static constexpr std::string_view IMAGE_EXTENSION = ".fdfb";
+        static constexpr std::string_view STAMP_EXTENSION = ".stamp";
+        static constexpr std::string_view TEMP_EXTENSION  = ".tmp";
+        static constexpr std::chrono::minutes TEMP_GRACE_PERIOD = std::chrono::minutes(10);  // Longer than writing any image takes
 
+        // The only file system access for files that didn't change
+        [[nodiscard]] static std::optional<Stamp> Stat(const std::filesystem::path& filepath) noexcept
+        {
+        #if FDF_MMAP
+            struct stat status;
+            if(::stat(filepath.c_str(), &status) != 0 || !S_ISREG(status.st_mode))
+                return std::nullopt;
+            return Stamp{ .modificationTime = status.st_mtim.tv_sec * 1'000'000'000ll + status.st_mtim.tv_nsec, .fileSize = static_cast<uint64_t>(status.st_size) };
+        #else
+            std::error_code ec;
+            const uintmax_t size = std::filesystem::file_size(filepath, ec);
+            if(ec)
+                return std::nullopt;
+            const std::filesystem::file_time_type time = std::filesystem::last_write_time(filepath, ec);
+            if(ec)
+                return std::nullopt;
+            return Stamp{ .modificationTime = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count(), .fileSize = size };
+        #endif
+        }
 
+        // "flavor" separates images that come out different from the same file (comments skipped, format version, ...)
+        [[nodiscard]] static uint64_t GetPathKey(const std::filesystem::path& filepath, uint64_t flavor) noexcept
+        {
+            std::error_code ec;
+            const std::filesystem::path absolutePath = std::filesystem::absolute(filepath, ec);
+            return detail::HashString((ec? filepath : absolutePath).native(), flavor);
+        }
 
+        [[nodiscard]] std::filesystem::path GetImagePath(uint64_t contentKey) const  { return directory / std::format("{:016x}{}", contentKey, IMAGE_EXTENSION); }
+        [[nodiscard]] std::filesystem::path GetStampPath(uint64_t pathKey)    const  { return directory / std::format("{:016x}{}", pathKey, STAMP_EXTENSION); }
 
+        // Content key of the file if it is unchanged since it was remembered, by this cache or by any other process using the directory
+        [[nodiscard]] std::optional<uint64_t> FindContentKey(uint64_t pathKey, const Stamp& current) noexcept
+        {
+            {
+                std::lock_guard lock(mutex);
+                if(const auto it = stamps.find(pathKey); it != stamps.end() && it->second.IsSameFile(current))
+                    return it->second.contentKey;
+            }
 
+            StampFile stampFile;
+            std::ifstream file(GetStampPath(pathKey), std::ios::binary);
+            if(!file.read(reinterpret_cast<char*>(&stampFile), sizeof(stampFile)) || stampFile.magic != detail::BINARY_MAGIC || stampFile.version != detail::BINARY_VERSION || !stampFile.stamp.IsSameFile(current))
+                return std::nullopt;
 
-namespace fdf::detail
-{
-    constexpr Token Tokenizer::GetNextToken() noexcept
-    {
-        if(index >= content.size())
-            return TokenType::EndOfFile;
+            std::lock_guard lock(mutex);
+            stamps[pathKey] = stampFile.stamp;
+            return stampFile.stamp.contentKey;
+        }
 
-        while(std::isspace(content[index]))
+        // Failing to write only costs a parse next time, so errors are ignored
+        inline void Remember(uint64_t pathKey, const Stamp& stamp) noexcept
         {
-            if(content[index] == '\n')
+            try
             {
-                Token token = Token(TokenType::NewLine, index);
-                token.line = line;
-                token.column = token.startPosition - lastNewLineIndex;
-                while(index < content.size() && std::isspace(content[index]))
                 {
-                    if(content[index] == '\n')
-                    {
-                        line++;
-                        lastNewLineIndex = index;
-                    }
-
-
-                    index++;
-                    token.count++;
+                    std::lock_guard lock(mutex);
+                    stamps[pathKey] = stamp;
                 }
 
-                return token;
+                const StampFile stampFile = { .stamp = stamp };
+                WriteAtomically(GetStampPath(pathKey), std::string_view(reinterpret_cast<const char*>(&stampFile), sizeof(stampFile)));
+            }
+            catch(...)
+            {
             }
-
-            if(std::isspace(content[index]))
-                index++;
-
-            if(index >= content.size())
-                return TokenType::EndOfFile;
         }
-
-
-
-        if(content[index] == '\"' || content[index] == '\'')
+        inline void StoreImage(uint64_t contentKey, std::string_view image) noexcept
         {
-            size_t nextQuote = content.find_first_of(content[index], index + 1);
-            if(nextQuote == std::string_view::npos)
-                return TokenType::Invalid;  // Non matching quotes
-
-            while(content[nextQuote - 1] == '\\' && content[nextQuote - 2] != '\\')
+            try
+            {
+                if(WriteAtomically(GetImagePath(contentKey), image))
+                    Evict();
+            }
+            catch(...)
             {
-                nextQuote = content.find_first_of(content[index], nextQuote + 1);
-                if(nextQuote == std::string_view::npos)
-                    return TokenType::Invalid;  // Non matching quotes
             }
-
-            Token token = Token(TokenType::StringLiteral, index, nextQuote + 1 - index);
-            index = nextQuote + 1;
-            token.line = line;
-            token.column = token.startPosition - lastNewLineIndex;
-            return token;
         }
-
-
-
-        if(content[index] == '/')
+        // Loaded images are marked as recently used for "Evict"
+        inline void Touch(uint64_t contentKey) noexcept
         {
-            if(index + 2 >= content.size())
-                return TokenType::Invalid; // not enough space for a comment
+            std::error_code ec;
+            std::filesystem::last_write_time(GetImagePath(contentKey), std::filesystem::file_time_type::clock::now(), ec);
+        }
 
-            if(content[index + 1] == '/') // single line comment
+        // Readers either see the old file or the whole new one, never a partially written one
+        inline bool WriteAtomically(const std::filesystem::path& target, std::string_view data) noexcept
+        {
+            try
             {
-                size_t newLinePos = content.find_first_of('\n', index + 2);
-                Token token = Token(TokenType::Comment, content[index + 2] == ' '? index + 3 : index + 2);
-                token.line = line;
-                token.column = token.startPosition - lastNewLineIndex;
+                std::error_code ec;
+                std::filesystem::create_directories(directory, ec);
 
-                if(newLinePos != std::string_view::npos)
+                uint64_t unique = detail::HashInteger(std::hash<std::thread::id>{}(std::this_thread::get_id()), detail::HashInteger(reinterpret_cast<uintptr_t>(this)));
+            #if FDF_MMAP
+                unique = detail::HashInteger(static_cast<uint64_t>(::getpid()), unique);
+            #endif
                 {
-                    token.count = newLinePos - token.startPosition;
-                    index = newLinePos;
-                    return token;
+                    std::lock_guard lock(mutex);
+                    unique = detail::HashInteger(writeCount++, unique);
                 }
 
-                // There is no new lines left (comment is at the end of the file)
-                token.count = content.size() - token.startPosition;
-                index = -1;
-                return token;
-            }
-
-            if(content[index + 1] == '*') // multi line comment
-            {
-                size_t slashPos = content.find_first_of('/', index + 2);
-                while(true)
+                std::filesystem::path temp = target;
+                temp += std::format(".{:016x}{}", unique, TEMP_EXTENSION);
                 {
-                    if(slashPos == std::string_view::npos)
-                        return TokenType::Invalid; // Non matching comment scope (There is only "/*" and not "*/")
-
-                    if(content[slashPos - 1] == '*')
+                    std::ofstream file(temp, std::ios::binary);
+                    if(!file.write(data.data(), data.size()) || !file.flush())
                     {
-                        Token token = Token(TokenType::Comment, index + 2);
-                        token.line = line;
-                        token.column = token.startPosition - lastNewLineIndex;
-                        token.extra8 = 1;  // Means multi line
-                        token.count = slashPos - 2 - token.startPosition;
-
-                        for(size_t i = index + 2; i < slashPos - 1; i++)
-                        {
-                            if(content[i] == '\n')
-                                line++;
-                        }
-
-                        index = slashPos + 1;
-                        if(index + 1 < content.size() && content[index] == '\n')
-                        {
-                            lastNewLineIndex = index;
-                            line++;
-                            index++;
-                        }
-
-                        if(token.count == -1)
-                            token.count = 0;
-                        return token;
+                        file.close();
+                        std::filesystem::remove(temp, ec);
+                        return false;
                     }
+                }
 
-                    slashPos = content.find_first_of('/', slashPos + 2);
+                std::filesystem::rename(temp, target, ec);
+                if(ec)
+                {
+                    std::filesystem::remove(temp, ec);
+                    return false;
                 }
+                return true;
+            }
+            catch(...)
+            {
+                return false;
             }
-
-            return TokenType::Invalid;  // slash "/" without a comment
         }
 
+    private:
+        std::filesystem::path directory;
+        uint64_t maxSize;
 
-
-        if(content[index] == '{')
-            return Token(TokenType::CurlyBraceOpen, index++, 1);
-        if(content[index] == '}')
-            return Token(TokenType::CurlyBraceClose, index++, 1);
-        if(content[index] == '[')
-            return Token(TokenType::SquareBraceOpen, index++, 1);
-        if(content[index] == ']')
-            return Token(TokenType::SquareBraceClose, index++, 1);
-
-        if(content[index] == '=')
-            return Token(TokenType::Equal, index++, 1);
-        if(content[index] == ',')
-            return Token(TokenType::Comma, index++, 1);
+        std::mutex mutex;  // Same cache can be used by IOs on different threads
+        std::unordered_map<uint64_t, Stamp> stamps;  // Keyed by "GetPathKey"
+        uint64_t writeCount = 0;
+    };
+}
 
 
 
-        if(content[index] == '$')
-        {
-            if(index + 1 < content.size() && content[index + 1] == '{')
-            {
-                size_t braceClose = content.find_first_of('}', index + 2);
-                if(braceClose == std::string_view::npos) // we reached eof before "}"
-                    return TokenType::Invalid;
 
-                Token token = Token(TokenType::EvaluateLiteral, index, braceClose + 1 - index);
-                token.line = line;
-                token.column = token.startPosition - lastNewLineIndex;
-                index = braceClose + 1;
-                return token;
-            }
 
-            return TokenType::Invalid; // Random "$" without "{"
-        }
 
 
 
-        if(std::isalpha(content[index]) || content[index] == '_') // identifier, keyword
-        {
-            Token token = Token(TokenType::Identifier, index);
-            token.line = line;
-            token.column = token.startPosition - lastNewLineIndex;
-            auto checkKeywords = [&](std::string_view view) -> void
-            {
-                for(size_t i = 0; i < KEYWORD_COUNT; i++)
-                {
-                    if(view == KEYWORDS[i])
-                    {
-                        token.type = TokenType::Keyword;
-                        token.extra8 = i;  // Used as keyword index
-                        return;
-                    }
-                }
 
-                if(view.starts_with(KEYWORDS[2]) || view.starts_with(KEYWORDS[3]))
-                {
-                    token.type = TokenType::Keyword;
-                    token.extra8 = 4;  // Used as keyword index
-                }
-            };
 
-            size_t firstNonAlpha = index + 1;
-            while(firstNonAlpha < content.size() && (std::isalpha(content[firstNonAlpha]) || std::isdigit(content[firstNonAlpha]) || content[firstNonAlpha] == '_'))
-                firstNonAlpha++;
 
-            token.count = firstNonAlpha - token.startPosition;
-            std::string_view view = token.ToView(content);
 
-            if(firstNonAlpha >= content.size()) // we reached eof before any space or any other token
-            {
-                checkKeywords(view);
-                index = -1;
-                return token;
-            }
 
-            checkKeywords(view);
-            index = firstNonAlpha;
-            return token;
-        }
 
 
 
-        if(std::isdigit(content[index]) || content[index] == '-')
-        {
-            if(content[index] == '0' && index + 3 < content.size() && content[index + 1] == 'x')  // Hex
-            {
-                size_t firstNonHex = content.find_first_not_of("0123456789abcdefABCDEF", index + 2);
-                size_t firstChar = content.find_first_of("abcdefABCDEF", index + 2);
-                size_t firstHash = content.find_first_of('#', index + 2);
-                if(firstNonHex == firstHash && firstNonHex != std::string_view::npos) // First non hex character is "#"
-                {
-                    Token token = Token(TokenType::HexLiteral, index, firstNonHex - index);
-                    token.line = line;
-                    token.column = token.startPosition - lastNewLineIndex;
-                    index = firstNonHex + 1;
-                    return token;
-                }
 
-                if(firstNonHex == std::string_view::npos) // we reached eof before any space or any other token
-                    return TokenType::Invalid;
 
-                if(firstChar < firstNonHex) // it contains hex characters, so we can't let it slide as a number
-                    return TokenType::Invalid;
 
-                // Let it fallthrough as "multi dimensional int"
-            }
 
+namespace fdf::detail
+{
+    // Works like std::pmr::polymorphic_allocator, but without a resource (and in constant evaluation) it uses new/delete
+    // Copies of a container don't inherit the resource (same as std::pmr), assignments and moves do so the IO always matches its arena
+    template<typename T>
+    struct Allocator
+    {
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
 
+        constexpr Allocator() noexcept = default;
+        constexpr Allocator(std::pmr::memory_resource* resource_) noexcept : resource(resource_)  { }
+        template<typename U>
+        constexpr Allocator(const Allocator<U>& other) noexcept : resource(other.resource)  { }
 
-            size_t firstNonDigit = content.find_first_not_of("0123456789", index + 1);
-            if(firstNonDigit == std::string_view::npos)  // we reached eof before any space or any other token
+        [[nodiscard]] constexpr T* allocate(size_t count)
+        {
+            if consteval
             {
-                Token token = Token(TokenType::IntLiteral, index, content.size() - index);
-                token.line = line;
-                token.column = token.startPosition - lastNewLineIndex;
-                token.extra8 = 1;  // Used as dimension (2d, 3d, 4d, 5d, etc)
-                index = -1;
-                return token;
+                return std::allocator<T>().allocate(count);
             }
-
-            if(std::isspace(content[firstNonDigit]) || content[firstNonDigit] == ',')
+            else
             {
-                Token token = Token(TokenType::IntLiteral, index, firstNonDigit - index);
-                token.line = line;
-                token.column = token.startPosition - lastNewLineIndex;
-                token.extra8 = 1;  // Used as dimension (2d, 3d, 4d, 5d, etc)
-                index = firstNonDigit;
-                return token;
+                if(resource == nullptr)
+                    return std::allocator<T>().allocate(count);
+                return static_cast<T*>(resource->allocate(count * sizeof(T), alignof(T)));
             }
-
-            if(content[firstNonDigit] == '.')  // float, version or multi dimensional float
+        }
+        constexpr void deallocate(T* pointer, size_t count) noexcept
+        {
+            if consteval
             {
-                Token token = Token(TokenType::FloatLiteral, index);
-                token.line = line;
-                token.column = token.startPosition - lastNewLineIndex;
-                token.extra8 = 1;  // Used as dimension (2d, 3d, 4d, 5d, etc)
-
-                size_t dotCount = 0;
-                size_t temp = firstNonDigit;
-                char lastChar = '.';
-                bool bContainsDash = false;
-
-                auto calculateResult = [&]() -> void
-                {
-                    if(lastChar == '.' || lastChar == 'x')
-                    {
-                        token.type = TokenType::Invalid;  // Must end with a digit
-                        return;
-                    }
+                std::allocator<T>().deallocate(pointer, count);
+            }
+            else
+            {
+                if(resource == nullptr)
+                    std::allocator<T>().deallocate(pointer, count);
+                else
+                    resource->deallocate(pointer, count * sizeof(T), alignof(T));
+            }
+        }
 
-                    token.count = temp - token.startPosition;
+        // Uses-allocator construction, elements that accept a resource (Entry) are placed into the same one as the container
+        template<typename U, typename... ARGS>
+        constexpr void construct(U* pointer, ARGS&&... args)
+        {
+            if constexpr(std::is_constructible_v<U, ARGS&&..., std::pmr::memory_resource*>)
+                std::construct_at(pointer, std::forward<ARGS>(args)..., resource);
+            else
+                std::construct_at(pointer, std::forward<ARGS>(args)...);
+        }
 
-                    if(dotCount == 2 || dotCount == 3)
-                    {
-                        if(bContainsDash)
-                        {
-                            token.type = TokenType::Invalid;  // Version cannot contain dash
-                            return;
-                        }
+        [[nodiscard]] constexpr Allocator select_on_container_copy_construction() const noexcept  { return {}; }
 
-                        token.type = TokenType::VersionLiteral;
-                        token.extra8 = dotCount + 1;
-                        return;
-                    }
-                };
+        template<typename U>
+        [[nodiscard]] constexpr bool operator==(const Allocator<U>& other) const noexcept  { return resource == other.resource; }
 
-                while(temp < content.size())
-                {
-                    lastChar = content[temp];
-                    if(std::isdigit(content[temp]) || (content[temp] == '-' && lastChar == 'x'))
-                    {
-                        if(content[temp] == '-')
-                            bContainsDash = true;
+        std::pmr::memory_resource* resource = nullptr;
+    };
 
-                        temp++;
-                        continue;
-                    }
+    using String = std::basic_string<char, std::char_traits<char>, Allocator<char>>;
 
-                    if(content[temp] == '.')
-                    {
-                        if(dotCount == 1 && token.extra8 > 1)
-                            return TokenType::Invalid;  // Float can't have more than 1 dot
-                        if(dotCount > 2)
-                            return TokenType::Invalid;  // Version can have 3 dots maximum
-                        
-                        dotCount++;
-                        temp++;
-                        continue;
-                    }
 
-                    if(content[temp] == 'x')
-                    {
-                        dotCount = 0;
-                        token.extra8++;
-                        temp++;
-                        continue;
-                    }
 
-                    if(std::isspace(content[temp]) || content[temp] == ',')
-                    {
-                        calculateResult();
-                        index = temp;
-                        return token;
-                    }
 
-                    return TokenType::Invalid; // Non allowed character
-                }
+    union Variant
+    {
+        bool     b[VARIANT_SIZE];
+        int64_t  i[VARIANT_64BIT_ELEMENT_COUNT];
+        uint64_t u[VARIANT_64BIT_ELEMENT_COUNT];
+        double   f[VARIANT_64BIT_ELEMENT_COUNT];
+        char   str[VARIANT_SIZE];
 
-                calculateResult();
-                index = -1;
-                return token;
-            }
+        struct String
+        {
+            constexpr char& operator[](size_t i)       noexcept  { return data[i]; }
+            constexpr char  operator[](size_t i) const noexcept  { return data[i]; }
 
-            if(content[firstNonDigit] == 'x')  // multi dimensional int
+            constexpr void Delete() noexcept
+            {
+                if(data != nullptr)
+                    Allocator<char>(resource).deallocate(data, capacity);
+                data = nullptr;
+                capacity = 0;
+            }
+            constexpr void Release() noexcept
+            {
+                data = nullptr;
+                capacity = 0;
+            }
+            constexpr void Reserve(size_t newCapacity)
             {
-                Token token = Token(TokenType::IntLiteral, index);
-                token.line = line;
-                token.column = token.startPosition - lastNewLineIndex;
-                token.extra8 = 2;  // Used as dimension (2d, 3d, 4d, 5d, etc)
+                if(newCapacity <= capacity)
+                    return;
 
-                size_t dotCount = 0;
-                while(true)
+                char* newData = Allocator<char>(resource).allocate(newCapacity);
+                if(data != nullptr)
                 {
-                    size_t previous = firstNonDigit;
-                    firstNonDigit = content.find_first_not_of("0123456789", firstNonDigit + 1);
-
-                    if(firstNonDigit == std::string_view::npos) // we reached eof before any space or any other token
-                    {
-                        token.count = content.size() - token.startPosition;
-                        index = -1;
-                        return token;
-                    }
-
-                    if(previous + 1 == firstNonDigit && !(content[previous] == ',' && std::isspace(content[firstNonDigit])) && !(content[previous] == 'x' && content[firstNonDigit] == '-'))
-                        return TokenType::Invalid;  // It must have number(s) in between
-
-                    if(std::isspace(content[firstNonDigit]) || content[firstNonDigit] == ',')
-                    {
-                        token.count = firstNonDigit - token.startPosition;
-                        index = firstNonDigit;
-                        return token;
-                    }
-
-                    if(content[firstNonDigit] == 'x')
-                    {
-                        token.extra8++;
-                        dotCount = 0;
-                        continue;
-                    }
-
-                    if(content[firstNonDigit] == '.')
-                    {
-                        dotCount++;
-                        if(dotCount > 1)
-                            return TokenType::Invalid;  // Multi dimensional numbers can't contain more than 1 dot (for each number)
-
-                        continue;
-                    }
+                    constexpr_memcpy(newData, data, capacity);
+                    Allocator<char>(resource).deallocate(data, capacity);
                 }
+                data = newData;
+                capacity = newCapacity;
+                RefreshView();
+            }
+            constexpr void InitialAllocate(std::pmr::memory_resource* resource_, size_t newCapacity)
+            {
+                resource = resource_;
+                data = Allocator<char>(resource).allocate(newCapacity);
+                capacity = newCapacity;
+                RefreshView();
             }
+            constexpr void Reallocate(size_t newCapacity)
+            {
+                size_t smallest = newCapacity > capacity? capacity : newCapacity;
+                char* newData = Allocator<char>(resource).allocate(newCapacity);
 
+                constexpr_memcpy(newData, data, smallest);
+                Allocator<char>(resource).deallocate(data, capacity);
 
+                data = newData;
+                capacity = newCapacity;
+                RefreshView();
+            }
+            constexpr String Copy(std::pmr::memory_resource* newResource) const
+            {
+                String other{};
+                other.resource = newResource;
+                other.view = view;  // Borrowed strings don't own anything, copying the view is enough
+                if(capacity > 0 && data != nullptr)
+                {
+                    other.InitialAllocate(newResource, capacity);
+                    constexpr_memcpy(other.data, data, capacity);
+                    other.RefreshView();
+                }
 
+                return other;
+            }
+            constexpr String Move() noexcept
+            {
+                String other = *this;
+                *this = {};
+                return other;
+            }
+            constexpr void RefreshView() noexcept
+            {
+                view = std::string_view(data, capacity);
+            }
 
+            size_t capacity;
+            char* data;
+            std::string_view view;
+            std::pmr::memory_resource* resource;  // Where "data" came from, nullptr for new/delete
+        } strDynamic;
 
-            /* Possible datetime formats
-            *  2024-12-24T15:30:00       -> Date + Time without timezone info (Usually interpreted as local time)
-            *  2024-12-24T15:30:00Z      -> Date + Time with timezone info (Z means utc/zulu time)
-            *  2024-12-24T15:30:00+05:30 -> Date + Time with timezone info (5 hours and 30 minutes ahead of UTC)
-            *  2024-12-24                -> Date
-            *  15:30:00                  -> Time
-            *  2024-12-24T15:30:00.123Z  -> Date + Time with timezone info (Z means utc/zulu time) and milliseconds (123ms)
-            *  2024-W52-2                -> Year + Week + Weekday (52nd week of 2024, tuesday)
-            *  2024-359                  -> Year + Day of Year (359th day of 2024)
-            */
+    public:
+        constexpr  Variant() noexcept  { }
+        constexpr ~Variant() noexcept  { }
+    };
+    static_assert(sizeof(Variant) == VARIANT_SIZE);
+}
 
-            /* Possible duration formats (if we wanna support it, currently we don't) (Note: not here, it starts with a letter)
-            *  P3D              -> 3 days
-            *  P2W              -> 2 weeks (14 days)
-            *  P1Y2M3D          -> 1 year, 2 months, 3 days
-            *  P2WT3H           -> 2 weeks and 3 hours
-            *  P5DT4H30M        -> 5 days, 4 hours, and 30 minutes
-            *  PT1H45M          -> 1 hour and 45 minutes
-            *  P1Y2M3DT4H30M10S -> 1 year, 2 months, 3 days, 4 hours, 30 minutes, and 10 seconds
-            *  P10M             -> 10 minutes
-            *  PT10M            -> 10 minutes (alternative representation for time)
-            *  PT1.5S           -> 1.5 seconds (1 second and 500 milliseconds)
-            *  PT0.000001S      -> 1 microsecond (0.000001 seconds)
-            *  P1.5Y            -> 1.5 years (1 year and 6 months)
-            *  P3DT5H30M        -> 3 days, 5 hours, and 30 minutes
-            *  PT0.5H           -> 30 minutes (0.5 hours)
-            *  P2Y3M4DT5H6M7S   -> 2 years, 3 months, 4 days, 5 hours, 6 minutes, and 7 seconds
-            */
 
 
-            if(content[firstNonDigit] == '-')  // date or datetime
-            {
-                Token token = Token(TokenType::TimestampLiteral, index);
-                token.line = line;
-                token.column = token.startPosition - lastNewLineIndex;
-                size_t firstNonDate = content.find_first_not_of("0123456789TZW-+:.", index);
-                if(firstNonDate == std::string_view::npos)
-                {
-                    token.count = content.size() - token.startPosition;
-                    index = -1;
-                    return token;
-                }
 
-                if(std::isspace(content[firstNonDate]) || content[firstNonDate] == ',')
-                {
-                    token.count = firstNonDate - token.startPosition;
-                    index = firstNonDate;
-                    return token;
-                }
+FDF_EXPORT namespace fdf
+{
+    template<auto ERROR_CALLBACK = detail::DefaultErrorCallback> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
+    class IO;
 
-                return TokenType::Invalid;  // Invalid character after timestamp
-            }
+    template<auto ERROR_CALLBACK = detail::DefaultErrorCallback> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
+    class StreamParser;
 
-            if(content[firstNonDigit] == ':')  // time
-            {
-                Token token = Token(TokenType::TimestampLiteral, index);
-                token.line = line;
-                token.column = token.startPosition - lastNewLineIndex;
-                size_t firstNonDate = content.find_first_not_of("0123456789+:.", index);  // idk if it can include timezone ("+" sign)
-                if(firstNonDate == std::string_view::npos)
-                {
-                    token.count = content.size() - token.startPosition;
-                    index = -1;
-                    return token;
-                }
+    class FrozenDocument;
 
-                if(std::isspace(content[firstNonDate]) || content[firstNonDate] == ',')
-                {
-                    token.count = firstNonDate - token.startPosition;
-                    index = firstNonDate;
-                    return token;
-                }
+    // Entries are views that only live inside the entry vector of an IO: identifiers point into the identifier pool of the IO, which is shared by its copies,
+    // and parents are found by their distance in that vector. So entries can't be copied or moved out on their own, only into another container of entries
+    class Entry
+    {
+        friend struct detail::Test;
+        friend struct detail::EntryIndex;
 
-                return TokenType::Invalid;  // Invalid character after timestamp
-            }
+        template<auto ERROR_CALLBACK, ParseOptions OPTIONS>
+        friend struct detail::Utils;
 
-            return TokenType::Invalid;  // Something we didn't process yet?
-        }
+        template<auto ERROR_CALLBACK> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
+        friend class IO;
 
-        return TokenType::Invalid;  // Something we didn't process yet?
-    }
+        static Entry INVALID;
 
+    private:
+        Type type = Type::Invalid;
+        uint8_t depth = 0;  // Depth of the entry (0 for top level, 1 for child of top level, 2 for grandchild of top level, ...)
+        uint8_t identifierSize = 0;
+        bool bBorrowedData : 1 = false;  // String payload is "data.strDynamic.view" into the parsed content, nothing is owned
+        bool bLazyValue    : 1 = false;  // Not decoded yet, "data.strDynamic.view" is the token and "size" its type and extra data
+        uint32_t size = 0;  // If Array or Map this is count of top level childs, otherwise type specific (for example: character count for string)
 
+        detail::Variant data;  // Containers keep their descendant count in "u[0]" and their key in "detail::EntryIndex" in "u[1]"
 
+        // Full identifiers aren't stored, they are rebuilt from the parent chain (see "GetFullIdentifier")
+        const char* identifier = nullptr;  // Interned segment (see "detail::IdentifierPool"), nullptr for array elements
+        uint32_t parentOffset = 0;  // Distance to the parent in the entry vector, 0 for top level entries
+        uint32_t arrayIndex = 0;  // Position inside the parent array, only used by array elements
+        std::pmr::memory_resource* resource = nullptr;
 
-    template<auto ERROR_CALLBACK>
-    struct Utils
-    {
-        [[nodiscard]] constexpr static bool ParseFileContent(std::string_view content, std::vector<Entry>& entries,
+#if !FDF_NO_COMMENTS
+    private:
+        // Only one of them is set, read both through "GetComment"
+        std::string_view borrowedComment;  // Used instead of "comment" when parsed with "ParseOptions::bBorrowSource"
+        detail::String comment;
+#endif
+
+    public:
+        constexpr Entry() noexcept = default;
+        // Comment and string payload are allocated from "resource" (nullptr for new/delete)
+        constexpr explicit Entry(std::pmr::memory_resource* resource) noexcept
+            : resource(resource)
         #if !FDF_NO_COMMENTS
-            std::string& fileComment,
+            , comment(detail::Allocator<char>(resource))
         #endif
-            size_t& topLevelEntryCount) noexcept
+            { }
+        constexpr ~Entry() noexcept
         {
-            Tokenizer tokenizer = content;
-        #if !FDF_NO_COMMENTS
-            Token fileCommentToken = TokenType::NonExisting;
-        #endif
-            while(true)
-            {
-            #if !FDF_NO_COMMENTS
-                Token comment = TokenType::NonExisting;
-            #endif
-                Token currentToken = tokenizer.Current();
-                FDF_CHECK_TOKEN(currentToken);
-    
-                while(currentToken.type == TokenType::Comment || currentToken.type == TokenType::NewLine)
-                {
-                #if !FDF_NO_COMMENTS
-                    if(currentToken.type == TokenType::Comment)
-                    {
-                        if(entries.empty() && fileComment.empty() && currentToken.count > 0 && content[currentToken.startPosition] == '#')
-                        {
-                            std::string_view sv = currentToken.ToView(content);
-                            size_t firstChar = sv.find_first_not_of("# ");
-                            if(firstChar == std::string_view::npos)
-                            {
-                                currentToken.startPosition += currentToken.count;
-                                currentToken.count = 0;
-                            }
-                            else
-                            {
-                                currentToken.startPosition += firstChar;
-                                currentToken.count = currentToken.count - firstChar;
-                                if(content[currentToken.startPosition] == '\n')
-                                {
-                                    currentToken.startPosition++;
-                                    currentToken.count--;
-                                }
-                            }
-
-                            if(fileCommentToken.type != TokenType::NonExisting)
-                                if(!ERROR_CALLBACK(Error::AlreadyHasComment, std::format("File already has a comment\nOld Comment: \"{}\" ({}:{})\nNew Comment: \"{}\" ({}:{})", fileCommentToken.ToView(content), fileCommentToken.line, fileCommentToken.column, currentToken.ToView(content), currentToken.line, currentToken.column)))
-                                    return false;
-                            fileCommentToken = currentToken;
-                        }
-                        else
-                        {
-                            if(comment.type != TokenType::NonExisting)
-                                if(!ERROR_CALLBACK(Error::AlreadyHasComment, std::format("Token already has a comment\nOld Comment: \"{}\" ({}:{})\nNew Comment: \"{}\" ({}:{})", comment.ToView(content), comment.line, comment.column, currentToken.ToView(content), currentToken.line, currentToken.column)))
-                                    return false;
-                            comment = currentToken;
-                        }
-                    }
-                #endif
-    
-                    currentToken = tokenizer.Advance();
-                }
-    
-                if(currentToken.type == TokenType::Identifier)
-                {
-                    topLevelEntryCount++;
+            if(HasDynamicString())
+                data.strDynamic.Delete();
+        }
 
-                #if !FDF_NO_COMMENTS
-                    if(!ParseVariable(content, tokenizer, entries, comment, -1))
-                        return false;
-                #else
-                    if(!ParseVariable(content, tokenizer, entries, -1))
-                        return false;
-                #endif
-    
-                    continue;
-                }
-                
-                if(currentToken.type == TokenType::EndOfFile)
-                    break;
-    
-                return false;  // First token can't be anything else
-            }
 
+        // Copies and moves take the memory resource of the container they are placed into (see "detail::Allocator::construct")
+        Entry(const Entry& other) = delete;
+        Entry(Entry&& other) = delete;
+        constexpr Entry(const Entry& other, std::pmr::memory_resource* resource)
+            : type(other.type), depth(other.depth), identifierSize(other.identifierSize), bBorrowedData(other.bBorrowedData), bLazyValue(other.bLazyValue), size(other.size), identifier(other.identifier), parentOffset(other.parentOffset), arrayIndex(other.arrayIndex), resource(resource)
         #if !FDF_NO_COMMENTS
-            if(fileCommentToken.type != TokenType::NonExisting)
-                TrimWhitespaceMultilineInPlace(fileCommentToken.ToView(content), fileComment);
+            , borrowedComment(other.borrowedComment), comment(other.comment, detail::Allocator<char>(resource))
         #endif
-            return true;
+        {
+            if(HasDynamicString())
+                data.strDynamic = other.data.strDynamic.Copy(resource);
+            else
+                data = other.data;
         }
-    
-    
-    
-    
-        [[nodiscard]] constexpr static bool ParseVariable(std::string_view content, Tokenizer& tokenizer, std::vector<Entry>& entries,
+        // Steals the buffers if they come from "resource", copies them otherwise
+        constexpr Entry(Entry&& other, std::pmr::memory_resource* resource)
+            : type(other.type), depth(other.depth), identifierSize(other.identifierSize), bBorrowedData(other.bBorrowedData), bLazyValue(other.bLazyValue), size(other.size), identifier(other.identifier), parentOffset(other.parentOffset), arrayIndex(other.arrayIndex), resource(resource)
         #if !FDF_NO_COMMENTS
-            Token comment,
+            , borrowedComment(other.borrowedComment), comment(std::move(other.comment), detail::Allocator<char>(resource))
         #endif
-            size_t parentEntryIndex)
         {
-            const bool bHasParent    = parentEntryIndex != -1;
-            const bool bArrayElement = bHasParent? entries[parentEntryIndex].type == Type::Array : false;
-            Token currentToken = tokenizer.Current();
-    
-            Entry& entry = entries.emplace_back();
-            size_t currentEntryIndex = entries.size() - 1;
-    
-            if(bArrayElement)
+            if(HasDynamicString() && other.data.strDynamic.resource != resource)
             {
-                std::string temp = std::format("{}", entries[parentEntryIndex].size);
-                entry.identifierSize = temp.size();
-                entry.fullIdentifier = std::format("{}.{}", entries[parentEntryIndex].fullIdentifier, temp);
+                data.strDynamic = other.data.strDynamic.Copy(resource);
+                other.data.strDynamic.Delete();
             }
+            else if(HasDynamicString())
+                data.strDynamic = other.data.strDynamic.Move();
             else
-            {
-                entry.fullIdentifier = currentToken.ToView(content);
-                entry.identifierSize = entry.fullIdentifier.size();
-                currentToken = tokenizer.Advance();
-            }
-    
-            FDF_CHECK_TOKEN(currentToken);
-            FDF_CHECK_TOKEN_FOR_EOF(currentToken);
-    
-            if(bHasParent)
-            {
-                if(parentEntryIndex >= entries.size())
-                    return false;  // Unexpected parsing error
-    
-                Entry& parent = entries[parentEntryIndex];
-                if(parent.type != Type::Array && parent.type != Type::Map)
-                    return false;  // Unexpected parsing error
-    
-                entry.depth = parent.depth + 1;
-                if(entry.depth == 0)
-                    throw std::runtime_error("Max depth(255) is exceeded");
+                data = other.data;
 
-                parent.size++;
-                if(!bArrayElement)
-                    entry.fullIdentifier = parent.fullIdentifier + '.' + entry.fullIdentifier;
-            }
-    
-            bool bHasEqual = false;
-            if(currentToken.type == TokenType::Equal)
-            {
-                bHasEqual = true;
-                currentToken = tokenizer.Advance();
-                FDF_CHECK_TOKEN(currentToken);
-                FDF_CHECK_TOKEN_FOR_EOF(currentToken);
-            }
+            other.type = Type::Invalid;
+            other.bLazyValue = false;
+        }
 
-            while(currentToken.type == TokenType::Comment || currentToken.type == TokenType::NewLine)
+
+        constexpr Entry& operator=(const Entry& other)
+        {
+            if(this != &other)
             {
+                if(HasDynamicString())
+                    data.strDynamic.Delete();  // Has to happen before the type and size of "other" are taken
+
+                type = other.type;
+                depth = other.depth;
+                identifierSize = other.identifierSize;
+                bBorrowedData = other.bBorrowedData;
+                bLazyValue = other.bLazyValue;
+                size = other.size;
+                identifier = other.identifier;
+                parentOffset = other.parentOffset;
+                arrayIndex = other.arrayIndex;
+                resource = other.resource;
             #if !FDF_NO_COMMENTS
-                if(currentToken.type == TokenType::Comment)
-                {
-                    if(comment.type != TokenType::NonExisting)
-                        if(!ERROR_CALLBACK(Error::AlreadyHasComment, std::format("Token already has a comment\nOld Comment: \"{}\" ({}:{})\nNew Comment: \"{}\" ({}:{})", comment.ToView(content), comment.line, comment.column, currentToken.ToView(content), currentToken.line, currentToken.column)))
-                            return false;
-                    comment = currentToken;
-                }
+                borrowedComment = other.borrowedComment;
+                comment = other.comment;
             #endif
 
-                currentToken = tokenizer.Advance();
-                FDF_CHECK_TOKEN(currentToken);
-                FDF_CHECK_TOKEN_FOR_EOF(currentToken);
+                if(HasDynamicString())
+                    data.strDynamic = other.data.strDynamic.Copy(GetMemoryResource());
+                else
+                    data = other.data;
             }
-
-        #if !FDF_NO_COMMENTS
-            if(IsValueLiteral(currentToken.type) && (bHasEqual || bArrayElement))
-                return ParseSimpleValue(content, tokenizer, entry, comment) && OverrideEntry(entries, FindEntry(entries, entries[currentEntryIndex].fullIdentifier, entries[currentEntryIndex].depth, bHasParent? parentEntryIndex + 1 : 0), currentEntryIndex);
-            if(currentToken.type == TokenType::CurlyBraceOpen)
-                return ParseMap(content, tokenizer, entries, comment) && OverrideEntry(entries, FindEntry(entries, entries[currentEntryIndex].fullIdentifier, entries[currentEntryIndex].depth, bHasParent? parentEntryIndex + 1 : 0), currentEntryIndex);
-            if(currentToken.type == TokenType::SquareBraceOpen)
-                return ParseArray(content, tokenizer, entries, comment) && OverrideEntry(entries, FindEntry(entries, entries[currentEntryIndex].fullIdentifier, entries[currentEntryIndex].depth, bHasParent? parentEntryIndex + 1 : 0), currentEntryIndex);
-        #else
-            if(IsValueLiteral(currentToken.type) && (bHasEqual || bArrayElement))
-                return ParseSimpleValue(content, tokenizer, entry) && OverrideEntry(entries, FindEntry(entries, entries[currentEntryIndex].fullIdentifier, entries[currentEntryIndex].depth, bHasParent? parentEntryIndex + 1 : 0), currentEntryIndex);
-            if(currentToken.type == TokenType::CurlyBraceOpen)
-                return ParseMap(content, tokenizer, entries) && OverrideEntry(entries, FindEntry(entries, entries[currentEntryIndex].fullIdentifier, entries[currentEntryIndex].depth, bHasParent? parentEntryIndex + 1 : 0), currentEntryIndex);
-            if(currentToken.type == TokenType::SquareBraceOpen)
-                return ParseArray(content, tokenizer, entries) && OverrideEntry(entries, FindEntry(entries, entries[currentEntryIndex].fullIdentifier, entries[currentEntryIndex].depth, bHasParent? parentEntryIndex + 1 : 0), currentEntryIndex);
-        #endif
-    
-            return false;  // Something we didn't process yet?
+            return *this;
         }
-    
-    
-    
-    
-        [[nodiscard]] constexpr static bool ParseSimpleValue(std::string_view content, Tokenizer& tokenizer, Entry& entry
-        #if !FDF_NO_COMMENTS
-            , Token comment
-        #endif
-            )
+        constexpr Entry& operator=(Entry&& other) noexcept
         {
-            Token currentToken = tokenizer.Current();
-            std::string_view view = currentToken.ToView(content);
-    
-            auto postProcess = [&]()
+            if(this != &other)
             {
-                currentToken = tokenizer.Advance();
-                if(currentToken.type == TokenType::Comment)
-                {
-                #if !FDF_NO_COMMENTS
-                    if(comment.type != TokenType::NonExisting)
-                        if(!ERROR_CALLBACK(Error::AlreadyHasComment, std::format("Token already has a comment\nOld Comment: \"{}\" ({}:{})\nNew Comment: \"{}\" ({}:{})", comment.ToView(content), comment.line, comment.column, currentToken.ToView(content), currentToken.line, currentToken.column)))
-                            return false;
-                    comment = currentToken;
-                #endif
-                    currentToken = tokenizer.Advance();
-                }
-    
-                if(currentToken.type == TokenType::NewLine)
-                    tokenizer.Advance();
+                if(HasDynamicString())
+                    data.strDynamic.Delete();  // Has to happen before the type and size of "other" are taken
 
+                type = other.type;
+                depth = other.depth;
+                identifierSize = other.identifierSize;
+                bBorrowedData = other.bBorrowedData;
+                bLazyValue = other.bLazyValue;
+                size = other.size;
+                identifier = other.identifier;
+                parentOffset = other.parentOffset;
+                arrayIndex = other.arrayIndex;
+                resource = other.resource;
             #if !FDF_NO_COMMENTS
-                if(comment.type != TokenType::NonExisting)
-                    entry.comment = comment.ToView(content);
+                borrowedComment = other.borrowedComment;
+                comment = std::move(other.comment);
             #endif
-                return true;
-            };
-            
-            if(currentToken.type == TokenType::Keyword)
-            {
-                if(currentToken.extra8 == 0 || currentToken.extra8 == 1)
-                {
-                    entry.type = Type::Null;
-                    return postProcess();
-                }
-                if(currentToken.extra8 == 2 || currentToken.extra8 == 3)
-                {
-                    entry.type = Type::Bool;
-                    entry.size = 1;
-                    entry.data.b[0] = currentToken.extra8 == 2;
-                    return postProcess();
-                }
+                
+                if(HasDynamicString())
+                    data.strDynamic = other.data.strDynamic.Move();
+                else
+                    data = other.data;
 
-                if(currentToken.extra8 == 4)
-                {
-                    entry.type = Type::Bool;
-                    entry.size = 0;
+                other.type = Type::Invalid;
+                other.bLazyValue = false;
+            }
+            return *this;
+        }
 
-                    std::string_view mdBool = currentToken.ToView(content);
-                    bool bLastWasBoolLiteral = false;
-                    while(!mdBool.empty())
-                    {
-                        if(entry.size >= VARIANT_SIZE)
-                        {
-                            entry.type = Type::Invalid;
-                            return false;
-                        }
+    public:
+        [[nodiscard]] constexpr size_t GetChildCount()         const noexcept  { return IsContainer()? data.u[0] : 0; }
+        [[nodiscard]] constexpr size_t GetTopLevelChildCount() const noexcept  { return IsContainer()? size : 0; }
 
-                        if(mdBool.starts_with(KEYWORDS[2]))
-                        {
-                            if(bLastWasBoolLiteral)
-                            {
-                                entry.type = Type::Invalid;
-                                return false;
-                            }
+        [[nodiscard]] constexpr uint8_t  GetDepth()      const noexcept  { return depth; }
+        [[nodiscard]] constexpr Type     GetType()       const noexcept  { Resolve(); return type; }
+        [[nodiscard]] constexpr bool     IsValid()       const noexcept  { Resolve(); return type != Type::Invalid; }
+        [[nodiscard]] constexpr bool     IsNull()        const noexcept  { return type == Type::Null; }  // Lazy values are never null, no need to decode
+        [[nodiscard]] constexpr bool     IsNil()         const noexcept  { return IsNull(); }
+        [[nodiscard]] constexpr bool     IsContainer()   const noexcept  { return type == Type::Array || type == Type::Map; }
+        [[nodiscard]] constexpr bool     HasValue()      const noexcept  { return IsValid() && !IsNull() && !IsContainer(); }
+        [[nodiscard]] constexpr bool     IsBorrowed()    const noexcept  { Resolve(); return bBorrowedData; }
+        [[nodiscard]] constexpr bool     IsResolved()    const noexcept  { return !bLazyValue; }
 
-                            bLastWasBoolLiteral = true;
-                            entry.data.b[entry.size++] = true;
-                            mdBool = mdBool.substr(4);
-                        }
-                        else if(mdBool.starts_with(KEYWORDS[3]))
-                        {
-                            if(bLastWasBoolLiteral)
-                            {
-                                entry.type = Type::Invalid;
-                                return false;
-                            }
+    #if !FDF_NO_COMMENTS
+        [[nodiscard]] constexpr std::string_view GetComment() const noexcept  { return comment.empty()? borrowedComment : std::string_view(comment); }
+        constexpr void SetComment(std::string_view newComment)
+        {
+            comment = newComment;
+            borrowedComment = {};
+        }
+    #endif
 
-                            bLastWasBoolLiteral = true;
-                            entry.data.b[entry.size++] = false;
-                            mdBool = mdBool.substr(5);
-                        }
-                        else if(mdBool.starts_with('x'))
-                        {
-                            if(!bLastWasBoolLiteral)
-                            {
-                                entry.type = Type::Invalid;
-                                return false;
-                            }
 
-                            bLastWasBoolLiteral = false;
-                            mdBool = mdBool.substr(1);
-                        }
-                        else
-                        {
-                            entry.type = Type::Invalid;
-                            return false;
-                        }
-                    }
+        [[nodiscard]] constexpr bool   IsArrayElement() const noexcept  { return parentOffset != 0 && identifier == nullptr; }
+        [[nodiscard]] constexpr size_t GetArrayIndex()  const noexcept  { return arrayIndex; }
 
-                    return postProcess();
-                }
-    
-                return false;  // Invalid keyword when expected a value
-            }
-    
-            entry.size = currentToken.extra8;  // Dimension count or string length
-    
-    
-    
-    
-            if(currentToken.type == TokenType::IntLiteral)
+        // View into the identifier pool of the IO that owns the entry, empty for array elements. Valid as long as that IO or a copy of it exists
+        [[nodiscard]] constexpr std::string_view GetIdentifier() const noexcept
+        {
+            return identifier? std::string_view(identifier, identifierSize) : std::string_view();
+        }
+        // Full identifiers aren't stored, they are rebuilt from the parent chain into "buffer"
+        [[nodiscard]] constexpr std::string_view GetFullIdentifier(std::string& buffer) const
+        {
+            buffer.clear();
+            AppendFullIdentifier(buffer);
+            return buffer;
+        }
+        // Array elements are identified by their position, it is formatted into "temp"
+        [[nodiscard]] constexpr std::string_view GetIdentifier(std::string& temp) const
+        {
+            if(!IsArrayElement())
+                return GetIdentifier();
+
+            temp.resize(std::numeric_limits<uint32_t>::digits10 + 1);
+            temp.resize(std::to_chars(temp.data(), temp.data() + temp.size(), arrayIndex).ptr - temp.data());
+            return temp;
+        }
+
+
+        template<Style STYLE = {}>
+        [[nodiscard]] constexpr std::string_view DataToView(std::string& temp) const
+        {
+            Resolve();
+            switch(type)
             {
-                bool bIsUnsigned = false;
-                bool bContainsAnyNegative = false;
-                bool bIsFirstChar = true;
-                bool bIsNegative = false;
-    
-                uint64_t result = 0;
-                uint8_t currentDimension = 0;
-                const uint8_t dimensionCount = entry.size;
-    
-                auto finishDimension = [&]() -> bool
+                case Type::Invalid: return detail::INVALID_TEXT;
+                case Type::Null:    if constexpr(STYLE.bUseNilInsteadOfNull) return detail::KEYWORDS[1]; return detail::KEYWORDS[0];
+                case Type::Array:   return detail::ARRAY_TEXT;
+                case Type::Map:     return detail::MAP_TEXT;
+
+                case Type::String:
+                case Type::Timestamp:
+                    return HasDynamicString()? data.strDynamic.view.substr(0, size) : std::string_view(data.str, size);
+                
+                case Type::Hex:
                 {
-                    if(bIsNegative)
+                    std::string_view view = HasDynamicString()? data.strDynamic.view.substr(0, size) : std::string_view(data.str, size);
+
+                    if constexpr(STYLE.bUppercaseHex)
                     {
-                        if(bIsUnsigned || result > INT64_MAX_VALUE)
-                            return false;
-    
-                        entry.data.i[currentDimension] = -result;
+                        temp = view;
+                        std::ranges::transform(temp, temp.begin(), [](unsigned char c)  { return std::toupper(c); });
+                        return temp;
                     }
+
+                    return view;
+                }
+
+                case Type::Version:
+                    if(data.u[3] == 0)
+                        temp = std::format("{}.{}.{}", data.u[0], data.u[1], data.u[2]);
                     else
+                        temp = std::format("{}.{}.{}.{}", data.u[0], data.u[1], data.u[2], data.u[3]);
+                    return temp;
+
+                case Type::Bool:
+                    temp = std::format("{}", (data.b[0]? detail::KEYWORDS[2] : detail::KEYWORDS[3]));
+                    for(size_t i = 1; i < size; i++)
+                        temp = std::format("{}x{}", temp, (data.b[i]? detail::KEYWORDS[2] : detail::KEYWORDS[3]));
+                    return temp;
+
+                case Type::Int:
+                    temp = std::format("{}", data.i[0]);
+                    for(size_t i = 1; i < size; i++)
+                        temp = std::format("{}x{}", temp, data.i[i]);
+                    return temp;
+
+                case Type::UInt:
+                    temp = std::format("{}", data.u[0]);
+                    for(size_t i = 1; i < size; i++)
+                        temp = std::format("{}x{}", temp, data.u[i]);
+                    return temp;
+
+                case Type::Float:
+                    temp.clear();
+                    for(size_t i = 0; i < size; i++)
                     {
-                        bool bWasUnsigned = bIsUnsigned;
-                        if(result > INT64_MAX_VALUE)
-                            bIsUnsigned = true;
-    
-                        if(bIsUnsigned)
-                        {
-                            if(bContainsAnyNegative)
-                                return false;
-    
-                            if(!bWasUnsigned)
-                            {
-                                int64_t temp[VARIANT_64BIT_ELEMENT_COUNT];
-                                for(uint8_t i = 0; i < currentDimension - 1; i++)
-                                    temp[i] = entry.data.i[i];
-    
-                                for(uint8_t i = 0; i < currentDimension - 1; i++)
-                                {
-                                    if(temp[i] > INT64_MAX_VALUE)
-                                        return false;
-    
-                                    entry.data.u[i] = temp[i];
-                                }
-                            }
-    
-                            entry.data.u[currentDimension] = result;
-                        }
-                        else
-                            entry.data.i[currentDimension] = result;
-                    }
-    
-                    return true;
-                };
-    
-    
-                for(size_t i = 0; i < view.size(); i++)
-                {
-                    char c = view[i];
-                    if(bIsFirstChar && c == '-')
-                    {
-                        bIsNegative = true;
-                        bContainsAnyNegative = true;
-                    }
-                    else if(std::isdigit(c))
-                    {
-                        if(result > UINT64_MAX_VALUE / 10)
-                            return false;  // Overflow
-    
-                        result *= 10;
-    
-                        const uint64_t digit = c - '0';
-                        if(result > UINT64_MAX_VALUE - digit)
-                            return false; // Overflow
-    
-                        result += digit;
-                    }
-                    else if(c == '.')
-                    {
-                        while(i < view.size() && (view[i] == '.' || std::isdigit(view[i])))
-                            i++;
-                    }
-                    else if(c == 'x')
-                    {
-                        if(currentDimension >= dimensionCount - 1)
-                            return false;  // Too much dimensions
-    
-                        if(!finishDimension())
-                            return false;
-    
-                        bIsFirstChar = true;
-                        bIsNegative = false;
-    
-                        result = 0;
-                        currentDimension++;
-    
-                        continue;
+                        if(i != 0)
+                            temp.push_back('x');
+                        detail::AppendFloat(temp, data.f[i]);
                     }
-                    else
-                        return false;  // unknown character
-    
-                    bIsFirstChar = false;
-                }
-    
-                if(!finishDimension())
-                    return false;
-    
-                entry.type = bIsUnsigned? Type::UInt : Type::Int;
-                return postProcess();
+                    return temp;
+
+                default:
+                    std::unreachable();
+                    return {};
             }
-    
-    
-    
-    
-            if(currentToken.type == TokenType::FloatLiteral)
-            {
-                entry.type = Type::Float;
-    
-                bool bIsFirstChar = true;
-                bool bIsNegative = false;
-                bool bAfterDot = false;
-    
-                double multiplier = 1.0;
-                double result = 0.0;
-                uint8_t currentDimension = 0;
-                const uint8_t dimensionCount = entry.size;
-    
-                for(size_t i = 0; i < view.size(); i++)
-                {
-                    char c = view[i];
-                    if(bIsFirstChar && c == '-')
-                    {
-                        bIsNegative = true;
-                    }
-                    else if(std::isdigit(c))
+        };
+
+
+
+
+        template<typename T>
+        [[nodiscard]] constexpr auto GetValue() const  { }
+        template<typename T>
+        [[nodiscard]] constexpr auto GetValueUnsafe() const  { }
+
+    private:
+        // Decodes a lazy value, defined after "detail::Utils". A value that fails to decode becomes "Type::Invalid"
+        constexpr void Resolve() const noexcept;
+
+        // The parent of an entry is "parentOffset" entries before it in the same vector
+        constexpr void AppendFullIdentifier(std::string& buffer) const
+        {
+            if(parentOffset != 0)
+            {
+                (this - parentOffset)->AppendFullIdentifier(buffer);
+                buffer.push_back('.');
+            }
+
+            if(IsArrayElement())
+            {
+                char indexBuffer[std::numeric_limits<uint32_t>::digits10 + 1] = {};
+                buffer.append(indexBuffer, std::to_chars(indexBuffer, std::end(indexBuffer), arrayIndex).ptr);
+            }
+            else
+                buffer.append(GetIdentifier());
+        }
+
+        // Owned strings that don't fit into the variant and borrowed ones both live in "data.strDynamic"
+        [[nodiscard]] constexpr bool HasDynamicString() const noexcept
+        {
+            return (type == Type::String || type == Type::Hex || type == Type::Timestamp) && (bBorrowedData || size > detail::VARIANT_SIZE - 1);
+        }
+
+        // Compares type, value and comment. Identifier and position are left to the caller, children of containers aren't compared
+        [[nodiscard]] constexpr bool HasSameValue(const Entry& other) const
+        {
+            Resolve();
+            other.Resolve();
+            if(type != other.type || size != other.size)
+                return false;
+        #if !FDF_NO_COMMENTS
+            if(GetComment() != other.GetComment())
+                return false;
+        #endif
+
+            switch(type)
+            {
+                case Type::Bool:    return std::equal(data.b, data.b + size, other.data.b);
+                case Type::Int:
+                case Type::UInt:
+                case Type::Float:   return std::equal(data.u, data.u + size, other.data.u);  // Bitwise for floats, so NaN equals itself
+                case Type::Version: return std::equal(data.u, data.u + 4, other.data.u);
+
+                case Type::String:
+                case Type::Hex:
+                case Type::Timestamp:
+                {
+                    const std::string_view view = HasDynamicString()? data.strDynamic.view.substr(0, size) : std::string_view(data.str, size);
+                    return view == (other.HasDynamicString()? other.data.strDynamic.view.substr(0, size) : std::string_view(other.data.str, size));
+                }
+
+                default: return true;
+            }
+        }
+
+        [[nodiscard]] constexpr std::pmr::memory_resource* GetMemoryResource() const noexcept  { return resource; }
+    };
+
+
+
+
+
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValue<bool>() const
+    {
+        Resolve();
+        if(type != Type::Bool)
+            throw std::runtime_error("Non matching type is not 'bool'");
+        return std::span<const bool>(data.b, size);
+    }
+
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValue<int64_t>() const
+    {
+        Resolve();
+        if(type != Type::Int)
+            throw std::runtime_error("Non matching type is not 'int64_t'");
+        return std::span<const int64_t>(data.i, size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValue<int>() const { return GetValue<int64_t>(); }
+
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValue<uint64_t>() const
+    {
+        Resolve();
+        if(type != Type::UInt && type != Type::Version)
+            throw std::runtime_error("Non matching type is not 'uint64_t'");
+        return std::span<const uint64_t>(data.u, size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValue<unsigned int>() const { return GetValue<uint64_t>(); }
+
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValue<double>() const
+    {
+        Resolve();
+        if(type != Type::Float)
+            throw std::runtime_error("Non matching type is not 'double'");
+        return std::span<const double>(data.f, size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValue<float>() const { return GetValue<double>(); }
+
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValue<char>() const
+    {
+        Resolve();
+        if(type != Type::String && type != Type::Hex && type != Type::Timestamp)
+            throw std::runtime_error("Non matching type is not 'string'");
+
+        if(HasDynamicString())
+            return data.strDynamic.view.substr(0, size);
+        return std::string_view(data.str, size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValue<std::string>() const { return GetValue<char>(); }
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValue<std::string_view>() const { return GetValue<char>(); }
+
+
+
+
+
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<bool>() const
+    {
+        Resolve();
+        return std::span<const bool>(data.b, size);
+    }
+
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<int64_t>() const
+    {
+        Resolve();
+        return std::span<const int64_t>(data.i, size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<int>() const { return GetValueUnsafe<int64_t>(); }
+
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<uint64_t>() const
+    {
+        Resolve();
+        return std::span<const uint64_t>(data.u, size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<unsigned int>() const { return GetValueUnsafe<uint64_t>(); }
+
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<double>() const
+    {
+        Resolve();
+        return std::span<const double>(data.f, size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<float>() const { return GetValueUnsafe<double>(); }
+
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<char>() const
+    {
+        Resolve();
+        if(HasDynamicString())
+            return data.strDynamic.view.substr(0, size);
+        return std::string_view(data.str, size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<std::string>() const { return GetValueUnsafe<char>(); }
+    template<>
+    [[nodiscard]] constexpr auto Entry::GetValueUnsafe<std::string_view>() const { return GetValueUnsafe<char>(); }
+}
+
+inline fdf::Entry fdf::Entry::INVALID;
+
+
+
+
+namespace fdf::detail
+{
+    using EntryVector = std::vector<Entry, Allocator<Entry>>;
+}
+
+
+
+
+namespace fdf::detail
+{
+    // Stores every distinct identifier segment once, no matter how many entries use it
+    // Blocks are never moved or freed before the pool itself, so entries can keep pointers into them
+    class IdentifierPool
+    {
+    public:
+        explicit IdentifierPool(std::pmr::memory_resource* resource_) noexcept : resource(resource_)  { }
+        ~IdentifierPool() noexcept
+        {
+            for(const Block& block : blocks)
+                Allocator<char>(resource).deallocate(block.data, block.capacity);
+        }
+
+        IdentifierPool(const IdentifierPool&) = delete;
+        IdentifierPool& operator=(const IdentifierPool&) = delete;
+
+    public:
+        [[nodiscard]] std::string_view Intern(std::string_view segment)
+        {
+            if((count + 1) * 2 > slots.size())
+                Grow(slots.empty()? 64 : slots.size() * 2);
+
+            const uint64_t hash = HashString(segment);
+            size_t i = hash & (slots.size() - 1);
+            for(; slots[i].data != nullptr; i = (i + 1) & (slots.size() - 1))
+            {
+                if(slots[i].hash == hash && std::string_view(slots[i].data, slots[i].size) == segment)
+                    return std::string_view(slots[i].data, slots[i].size);
+            }
+
+            slots[i] = { hash, Store(segment), segment.size() };
+            count++;
+            return std::string_view(slots[i].data, slots[i].size);
+        }
+
+    private:
+        [[nodiscard]] char* Store(std::string_view segment)
+        {
+            if(blocks.empty() || blocks.back().used + segment.size() > blocks.back().capacity)
+            {
+                const size_t capacity = std::max(IDENTIFIER_BLOCK_SIZE, segment.size());
+                blocks.push_back({ Allocator<char>(resource).allocate(capacity), 0, capacity });
+            }
+
+            Block& block = blocks.back();
+            char* data = block.data + block.used;
+            std::ranges::copy(segment, data);
+            block.used += segment.size();
+            return data;
+        }
+
+        void Grow(size_t newCapacity)
+        {
+            std::vector<Slot> oldSlots = std::move(slots);
+            slots.assign(newCapacity, Slot{});
+            for(const Slot& slot : oldSlots)
+            {
+                if(slot.data == nullptr)
+                    continue;
+
+                size_t i = slot.hash & (slots.size() - 1);
+                while(slots[i].data != nullptr)
+                    i = (i + 1) & (slots.size() - 1);
+                slots[i] = slot;
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            uint64_t hash = 0;
+            const char* data = nullptr;
+            size_t size = 0;
+        };
+        struct Block
+        {
+            char* data;
+            size_t used;
+            size_t capacity;
+        };
+
+        std::pmr::memory_resource* resource;
+        std::vector<Slot> slots;
+        std::vector<Block> blocks;
+        size_t count = 0;
+    };
+
+
+
+
+    // Open addressing hash table (linear probing) that maps "parent + segment" (or "parent + array index") to an index in the entry vector
+    // Only hashes and indices are stored, keys are compared against the entries themselves so there is nothing to keep in sync when the vector reallocates
+    // Parents are hashed by their container key ("data.u[1]" of maps and arrays, handed out once per index) instead of their position,
+    // so moving entries only changes the indices in the slots (see "Shift"). Renaming a container only touches the container itself
+    struct EntryIndex
+    {
+        constexpr EntryIndex() noexcept = default;
+        // Interned segments are allocated from "resource"
+        constexpr explicit EntryIndex(std::pmr::memory_resource* resource_) noexcept : resource(resource_)  { }
+
+    public:
+        [[nodiscard]] constexpr size_t Find(const EntryVector& entries, size_t parentIndex, std::string_view segment) const noexcept
+        {
+            return Find(entries, parentIndex, segment, HashString(segment));
+        }
+        // "segmentHash" is "HashString(segment)", paths compute it ahead of the lookup
+        [[nodiscard]] constexpr size_t Find(const EntryVector& entries, size_t parentIndex, std::string_view segment, uint64_t segmentHash) const noexcept
+        {
+            if(slots.empty())
+                return -1;
+
+            const uint64_t hash = HashKey(GetParentKey(entries, parentIndex), segmentHash);
+            for(size_t i = hash & (slots.size() - 1); slots[i].index != -1; i = (i + 1) & (slots.size() - 1))
+            {
+                const Entry& entry = entries[slots[i].index];
+                if(slots[i].hash == hash && entry.identifier != nullptr && GetParentIndex(entries, slots[i].index) == parentIndex && entry.GetIdentifier() == segment)
+                    return slots[i].index;
+            }
+
+            return -1;
+        }
+        [[nodiscard]] constexpr size_t FindElement(const EntryVector& entries, size_t parentIndex, size_t arrayIndex) const noexcept
+        {
+            return FindElement(entries, parentIndex, arrayIndex, HashInteger(arrayIndex));
+        }
+        [[nodiscard]] constexpr size_t FindElement(const EntryVector& entries, size_t parentIndex, size_t arrayIndex, uint64_t elementHash) const noexcept
+        {
+            if(slots.empty())
+                return -1;
+
+            const uint64_t hash = HashKey(GetParentKey(entries, parentIndex), elementHash);
+            for(size_t i = hash & (slots.size() - 1); slots[i].index != -1; i = (i + 1) & (slots.size() - 1))
+            {
+                const Entry& entry = entries[slots[i].index];
+                if(slots[i].hash == hash && entry.IsArrayElement() && GetParentIndex(entries, slots[i].index) == parentIndex && entry.arrayIndex == arrayIndex)
+                    return slots[i].index;
+            }
+
+            return -1;
+        }
+
+        // Returns "entryIndex" if it is inserted, otherwise index of the existing entry with the same identifier
+        constexpr size_t Insert(const EntryVector& entries, size_t entryIndex)
+        {
+            if((count + 1) * 2 > slots.size())
+                Grow(slots.empty()? 16 : slots.size() * 2);
+
+            const uint64_t hash = Hash(entries, entryIndex);
+            size_t i = hash & (slots.size() - 1);
+            for(; slots[i].index != -1; i = (i + 1) & (slots.size() - 1))
+            {
+                if(slots[i].hash == hash && HasSameKey(entries, slots[i].index, entryIndex))
+                    return slots[i].index;
+            }
+
+            slots[i] = { hash, entryIndex };
+            count++;
+            return entryIndex;
+        }
+
+        // Removes "entryIndex" if it is indexed, uses backward shift deletion so lookups don't need tombstones
+        constexpr void Erase(const EntryVector& entries, size_t entryIndex) noexcept
+        {
+            if(slots.empty())
+                return;
+
+            const size_t mask = slots.size() - 1;
+            size_t i = Hash(entries, entryIndex) & mask;
+            while(slots[i].index != entryIndex)
+            {
+                if(slots[i].index == -1)
+                    return;
+                i = (i + 1) & mask;
+            }
+
+            for(size_t next = (i + 1) & mask; slots[next].index != -1; next = (next + 1) & mask)
+            {
+                const size_t home = slots[next].hash & mask;
+                if(((next - home) & mask) >= ((next - i) & mask))
+                {
+                    slots[i] = slots[next];
+                    i = next;
+                }
+            }
+
+            slots[i] = Slot{};
+            count--;
+        }
+
+        // Returned view stays valid as long as any copy of this index is alive
+        [[nodiscard]] constexpr std::string_view Intern(std::string_view segment)
+        {
+            if consteval
+            {
+                return segment;  // Entries can't outlive a constant evaluation, but the parsed content does
+            }
+            else
+            {
+                if(!identifiers)
+                    identifiers = std::make_shared<IdentifierPool>(resource);
+                return (*identifiers)->Intern(segment);
+            }
+        }
+
+        [[nodiscard]] constexpr static size_t GetParentIndex(const EntryVector& entries, size_t entryIndex) noexcept
+        {
+            return entries[entryIndex].parentOffset != 0? entryIndex - entries[entryIndex].parentOffset : static_cast<size_t>(-1);
+        }
+
+        // Every map and array gets one before its children are indexed, copies from another index get a new one (see "IO::IndexNewEntries")
+        [[nodiscard]] constexpr uint64_t NewContainerKey() noexcept  { return nextContainerKey++; }
+        // Keys loaded with the slots are already taken
+        constexpr void SkipContainerKeys(uint64_t keyCount) noexcept  { nextContainerKey = std::max(nextContainerKey, keyCount); }
+
+        constexpr void Reserve(size_t entryCount)
+        {
+            size_t capacity = 16;
+            while(capacity < entryCount * 2)
+                capacity *= 2;
+
+            if(capacity > slots.size())
+                Grow(capacity);
+        }
+
+        // Containers get new keys, entries copied from other documents may bring theirs along
+        constexpr void Rebuild(EntryVector& entries)
+        {
+            Clear();
+            Reserve(entries.size());
+            for(size_t i = 0; i < entries.size(); i++)
+            {
+                if(entries[i].IsContainer())
+                    entries[i].data.u[1] = NewContainerKey();
+                Insert(entries, i);
+            }
+        }
+
+        // Entries from "firstMovedEntry" on moved by "delta" in the vector, their keys stay the same so only the indices are updated
+        // Entries removed from in front of them have to be erased before, entries added there are inserted after
+        constexpr void Shift(size_t firstMovedEntry, ptrdiff_t delta) noexcept
+        {
+            if(delta == 0)
+                return;
+
+            for(Slot& slot : slots)
+            {
+                if(slot.index != -1 && slot.index >= firstMovedEntry)
+                    slot.index += delta;
+            }
+        }
+
+        constexpr void Clear() noexcept
+        {
+            slots.clear();
+            count = 0;
+            nextContainerKey = 0;
+        }
+
+        // "IO::WriteBinary" stores the slots as they are, so loading a document doesn't hash every entry again
+        [[nodiscard]] inline std::string_view GetSlotBytes() const noexcept
+        {
+            return std::string_view(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(Slot));
+        }
+        // Fails if "bytes" aren't the slots of an index over all "entryCount" entries
+        [[nodiscard]] inline bool AssignSlotBytes(std::string_view bytes, size_t entryCount)
+        {
+            if(bytes.size() % sizeof(Slot) != 0 || (!bytes.empty() && !std::has_single_bit(bytes.size() / sizeof(Slot))))
+                return false;
+
+            slots.resize(bytes.size() / sizeof(Slot));
+            std::memcpy(slots.data(), bytes.data(), bytes.size());
+
+            count = 0;
+            for(const Slot& slot : slots)
+            {
+                if(slot.index != -1 && slot.index >= entryCount)
+                    return false;
+                count += slot.index != -1;
+            }
+            return count == entryCount && count * 2 <= slots.size();  // Probing relies on empty slots
+        }
+
+    private:
+        [[nodiscard]] constexpr static uint64_t GetParentKey(const EntryVector& entries, size_t parentIndex) noexcept
+        {
+            return parentIndex != -1? entries[parentIndex].data.u[1] : static_cast<uint64_t>(-1);
+        }
+        [[nodiscard]] constexpr static uint64_t Hash(const EntryVector& entries, size_t entryIndex) noexcept
+        {
+            const Entry& entry = entries[entryIndex];
+            const uint64_t parentKey = GetParentKey(entries, GetParentIndex(entries, entryIndex));
+            return entry.IsArrayElement()? HashElement(parentKey, entry.arrayIndex) : HashSegment(parentKey, entry.GetIdentifier());
+        }
+        [[nodiscard]] constexpr static bool HasSameKey(const EntryVector& entries, size_t lhs, size_t rhs) noexcept
+        {
+            if(GetParentIndex(entries, lhs) != GetParentIndex(entries, rhs) || entries[lhs].IsArrayElement() != entries[rhs].IsArrayElement())
+                return false;
+            return entries[lhs].IsArrayElement()? entries[lhs].arrayIndex == entries[rhs].arrayIndex : entries[lhs].GetIdentifier() == entries[rhs].GetIdentifier();
+        }
+
+        constexpr void Grow(size_t newCapacity)
+        {
+            std::vector<Slot> oldSlots = std::move(slots);
+            slots.assign(newCapacity, Slot{});
+            for(const Slot& slot : oldSlots)
+            {
+                if(slot.index == -1)
+                    continue;
+
+                size_t i = slot.hash & (slots.size() - 1);
+                while(slots[i].index != -1)
+                    i = (i + 1) & (slots.size() - 1);
+                slots[i] = slot;
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            uint64_t hash = 0;
+            size_t index = static_cast<size_t>(-1);
+        };
+
+        std::vector<Slot> slots;
+        size_t count = 0;
+        uint64_t nextContainerKey = 0;
+
+        std::pmr::memory_resource* resource = nullptr;
+        std::optional<std::shared_ptr<IdentifierPool>> identifiers;  // Shared, so copies of the index can keep pointing into it. Never engaged during constant evaluation
+    };
+
+    // Direct children of every container in a single table, so the n-th child of an entry is found without walking its subtree
+    // Built on the first lookup, the owner resets it whenever the structure of the entries changes. Copies start without a table
+    class ChildTable
+    {
+    public:
+        constexpr ChildTable() = default;
+        constexpr ChildTable(const ChildTable&) noexcept  { }
+        inline ChildTable& operator=(const ChildTable&) noexcept  { Reset(); return *this; }
+
+        // "parentIndex" is -1 for top level entries, returns -1 if there is no "id"-th child
+        // Constant evaluation (and a table that can't be built) walks the siblings instead
+        [[nodiscard]] constexpr size_t Find(const EntryVector& entries, size_t parentIndex, size_t id) const noexcept
+        {
+            if consteval
+            {
+                return FindLinear(entries, parentIndex, id);
+            }
+            else
+            {
+                if(!bBuilt.load(std::memory_order_acquire))
+                {
+                    try
+                    {
+                        Build(entries);
+                    }
+                    catch(...)
+                    {
+                        return FindLinear(entries, parentIndex, id);  // Out of memory or the mutex failed, the table stays unbuilt
+                    }
+                }
+
+                const size_t slot = parentIndex + 1;
+                return starts[slot] + id < starts[slot + 1]? children[starts[slot] + id] : static_cast<size_t>(-1);
+            }
+        }
+
+        // Only called while the entries are being changed, nothing can read the table at the same time
+        inline void Reset() noexcept  { bBuilt.store(false, std::memory_order_relaxed); }
+
+    private:
+        [[nodiscard]] constexpr static size_t FindLinear(const EntryVector& entries, size_t parentIndex, size_t id) noexcept
+        {
+            const size_t end = parentIndex != -1? parentIndex + 1 + entries[parentIndex].GetChildCount() : entries.size();
+            for(size_t i = parentIndex + 1; i < end; i += 1 + entries[i].GetChildCount())
+            {
+                if(id-- == 0)
+                    return i;
+            }
+            return -1;
+        }
+
+        // Readers of a const IO may arrive together, the first one builds the table and the others wait for it
+        inline void Build(const EntryVector& entries) const
+        {
+            std::scoped_lock lock(mutex);
+            if(bBuilt.load(std::memory_order_relaxed))
+                return;
+
+            // Slot 0 holds the top level entries and slot "i + 1" the children of entry "i". Counts are turned into the end of each slot,
+            // filling moves every end to the start of the next slot, so shifting them by one gives the starts back
+            starts.assign(entries.size() + 2, 0);
+            for(size_t i = 0; i < entries.size(); i++)
+                starts[EntryIndex::GetParentIndex(entries, i) + 2]++;
+            std::partial_sum(starts.begin(), starts.end(), starts.begin());
+
+            children.resize(entries.size());
+            for(size_t i = 0; i < entries.size(); i++)
+                children[starts[EntryIndex::GetParentIndex(entries, i) + 1]++] = i;
+            std::shift_right(starts.begin(), starts.end(), 1);
+            starts[0] = 0;
+
+            bBuilt.store(true, std::memory_order_release);
+        }
+
+    private:
+        mutable std::mutex mutex;
+        mutable std::atomic<bool> bBuilt = false;
+        mutable std::vector<size_t> starts;
+        mutable std::vector<size_t> children;
+    };
+
+    // Direct children inside "entries" (whole subtrees only), every step jumps over the descendants of the current child
+    template<typename ENTRY>
+    class SiblingView : public std::ranges::view_interface<SiblingView<ENTRY>>
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using value_type = std::remove_const_t<ENTRY>;
+            using difference_type = std::ptrdiff_t;
+
+            constexpr Iterator() noexcept = default;
+            constexpr explicit Iterator(ENTRY* entry) noexcept : entry(entry)  { }
+
+            [[nodiscard]] constexpr ENTRY& operator*() const noexcept  { return *entry; }
+            constexpr Iterator& operator++() noexcept  { entry += 1 + entry->GetChildCount(); return *this; }
+            constexpr Iterator operator++(int) noexcept  { Iterator previous = *this; ++*this; return previous; }
+            [[nodiscard]] constexpr bool operator==(const Iterator&) const noexcept = default;
+
+        private:
+            ENTRY* entry = nullptr;
+        };
+
+        constexpr SiblingView() noexcept = default;
+        constexpr explicit SiblingView(std::span<ENTRY> entries) noexcept : first(entries.data()), last(entries.data() + entries.size())  { }
+
+        [[nodiscard]] constexpr Iterator begin() const noexcept  { return Iterator(first); }
+        [[nodiscard]] constexpr Iterator end()   const noexcept  { return Iterator(last); }
+
+    private:
+        ENTRY* first = nullptr;
+        ENTRY* last = nullptr;
+    };
+}
+
+
+
+
+
+
+
+
+
+
+namespace fdf::detail
+{
+    constexpr Token Tokenizer::GetNextToken() noexcept
+    {
+        if(index >= content.size())
+            return TokenType::EndOfFile;
+
+        while(IsSpace(content[index]))
+        {
+            if(content[index] == '\n')
+            {
+                Token token = Token(TokenType::NewLine, index);
+                while(index < content.size() && IsSpace(content[index]))
+                {
+                    index++;
+                    token.count++;
+                }
+
+                return token;
+            }
+
+            index++;
+
+            if(index >= content.size())
+                return TokenType::EndOfFile;
+        }
+
+
+
+        switch(CHAR_DISPATCH[static_cast<uint8_t>(content[index])])
+        {
+            case CharDispatch::Quote:
+            {
+                size_t nextQuote = content.find_first_of(content[index], index + 1);
+                if(nextQuote == std::string_view::npos)
+                    return TokenType::Invalid;  // Non matching quotes
+
+                while(content[nextQuote - 1] == '\\' && content[nextQuote - 2] != '\\')
+                {
+                    nextQuote = content.find_first_of(content[index], nextQuote + 1);
+                    if(nextQuote == std::string_view::npos)
+                        return TokenType::Invalid;  // Non matching quotes
+                }
+
+                Token token = Token(TokenType::StringLiteral, index, nextQuote + 1 - index);
+                index = nextQuote + 1;
+                return token;
+            }
+
+
+
+            case CharDispatch::Slash:
+            {
+                if(index + 2 >= content.size())
+                    return TokenType::Invalid; // not enough space for a comment
+
+                if(content[index + 1] == '/') // single line comment
+                {
+                    size_t newLinePos = content.find_first_of('\n', index + 2);
+                    Token token = Token(TokenType::Comment, content[index + 2] == ' '? index + 3 : index + 2);
+
+                    if(newLinePos != std::string_view::npos)
+                    {
+                        token.count = newLinePos - token.startPosition;
+                        index = newLinePos;
+                        return token;
+                    }
+
+                    // There is no new lines left (comment is at the end of the file)
+                    token.count = content.size() - token.startPosition;
+                    index = -1;
+                    return token;
+                }
+
+                if(content[index + 1] == '*') // multi line comment
+                {
+                    size_t slashPos = content.find_first_of('/', index + 3);  // The star of "/*" doesn't close it, "/*/" is still open
+                    while(true)
+                    {
+                        if(slashPos == std::string_view::npos)
+                            return TokenType::Invalid; // Non matching comment scope (There is only "/*" and not "*/")
+
+                        if(content[slashPos - 1] == '*')
+                        {
+                            Token token = Token(TokenType::Comment, index + 2);
+                            token.extra8 = 1;  // Means multi line
+                            token.count = slashPos - 2 >= token.startPosition? slashPos - 2 - token.startPosition : 0;  // "/**/" is an empty comment
+
+                            index = slashPos + 1;
+                            if(index + 1 < content.size() && content[index] == '\n')
+                                index++;
+
+                            return token;
+                        }
+
+                        slashPos = content.find_first_of('/', slashPos + 2);
+                    }
+                }
+
+                return TokenType::Invalid;  // slash "/" without a comment
+            }
+
+
+
+            case CharDispatch::CurlyBraceOpen:   return Token(TokenType::CurlyBraceOpen,   index++, 1);
+            case CharDispatch::CurlyBraceClose:  return Token(TokenType::CurlyBraceClose,  index++, 1);
+            case CharDispatch::SquareBraceOpen:  return Token(TokenType::SquareBraceOpen,  index++, 1);
+            case CharDispatch::SquareBraceClose: return Token(TokenType::SquareBraceClose, index++, 1);
+
+            case CharDispatch::Equal: return Token(TokenType::Equal, index++, 1);
+            case CharDispatch::Comma: return Token(TokenType::Comma, index++, 1);
+
+
+
+            case CharDispatch::Dollar:
+            {
+                if(index + 1 < content.size() && content[index + 1] == '{')
+                {
+                    size_t braceClose = content.find_first_of('}', index + 2);
+                    if(braceClose == std::string_view::npos) // we reached eof before "}"
+                        return TokenType::Invalid;
+
+                    Token token = Token(TokenType::EvaluateLiteral, index, braceClose + 1 - index);
+                    index = braceClose + 1;
+                    return token;
+                }
+
+                return TokenType::Invalid; // Random "$" without "{"
+            }
+
+
+
+            case CharDispatch::Identifier: // identifier, keyword
+            {
+                Token token = Token(TokenType::Identifier, index);
+                auto checkKeywords = [&](std::string_view view) -> void
+                {
+                    const size_t keywordIndex = FindKeyword(view);
+                    if(keywordIndex != -1)
+                    {
+                        token.type = TokenType::Keyword;
+                        token.extra8 = keywordIndex;  // Used as keyword index
+                        return;
+                    }
+
+                    if((view[0] == 't' || view[0] == 'f') && (view.starts_with(KEYWORDS[2]) || view.starts_with(KEYWORDS[3])))
+                    {
+                        token.type = TokenType::Keyword;
+                        token.extra8 = 4;  // Used as keyword index
+                    }
+                };
+
+                size_t firstNonAlpha = FindFirstNotOf(content, CHAR_IDENTIFIER, index + 1);
+                if(firstNonAlpha == std::string_view::npos)
+                    firstNonAlpha = content.size();
+
+                token.count = firstNonAlpha - token.startPosition;
+                std::string_view view = token.ToView(content);
+
+                if(firstNonAlpha >= content.size()) // we reached eof before any space or any other token
+                {
+                    checkKeywords(view);
+                    index = -1;
+                    return token;
+                }
+
+                checkKeywords(view);
+                index = firstNonAlpha;
+                return token;
+            }
+
+
+
+            case CharDispatch::Number:
+            {
+                if(content[index] == '0' && index + 3 < content.size() && content[index + 1] == 'x')  // Hex
+                {
+                    size_t firstNonHex = FindFirstNotOf(content, CHAR_DIGIT | CHAR_HEX_LETTER, index + 2);
+                    if(firstNonHex != std::string_view::npos && content[firstNonHex] == '#') // First non hex character is "#"
+                    {
+                        Token token = Token(TokenType::HexLiteral, index, firstNonHex - index);
+                        index = firstNonHex + 1;
+                        return token;
+                    }
+
+                    if(firstNonHex == std::string_view::npos) // we reached eof before any space or any other token
+                        return TokenType::Invalid;
+
+                    if(FindFirstNotOf(content.substr(0, firstNonHex), CHAR_DIGIT, index + 2) != std::string_view::npos) // it contains hex characters, so we can't let it slide as a number
+                        return TokenType::Invalid;
+
+                    // Let it fallthrough as "multi dimensional int"
+                }
+
+
+
+                size_t firstNonDigit = FindFirstNotOf(content, CHAR_DIGIT, index + 1);
+                if(firstNonDigit == std::string_view::npos)  // we reached eof before any space or any other token
+                {
+                    Token token = Token(TokenType::IntLiteral, index, content.size() - index);
+                    token.extra8 = 1;  // Used as dimension (2d, 3d, 4d, 5d, etc)
+                    index = -1;
+                    return token;
+                }
+
+                if(IsSpace(content[firstNonDigit]) || content[firstNonDigit] == ',')
+                {
+                    Token token = Token(TokenType::IntLiteral, index, firstNonDigit - index);
+                    token.extra8 = 1;  // Used as dimension (2d, 3d, 4d, 5d, etc)
+                    index = firstNonDigit;
+                    return token;
+                }
+
+                if(content[firstNonDigit] == '.')  // float, version or multi dimensional float
+                {
+                    Token token = Token(TokenType::FloatLiteral, index);
+                    token.extra8 = 1;  // Used as dimension (2d, 3d, 4d, 5d, etc)
+
+                    size_t dotCount = 0;
+                    size_t temp = firstNonDigit;
+                    char lastChar = '.';
+                    bool bContainsDash = false;
+
+                    auto calculateResult = [&]() -> void
+                    {
+                        if(lastChar == '.' || lastChar == 'x')
+                        {
+                            token.type = TokenType::Invalid;  // Must end with a digit
+                            return;
+                        }
+
+                        token.count = temp - token.startPosition;
+
+                        if(dotCount == 2 || dotCount == 3)
+                        {
+                            if(bContainsDash)
+                            {
+                                token.type = TokenType::Invalid;  // Version cannot contain dash
+                                return;
+                            }
+
+                            token.type = TokenType::VersionLiteral;
+                            token.extra8 = dotCount + 1;
+                            return;
+                        }
+                    };
+
+                    while(temp < content.size())
+                    {
+                        lastChar = content[temp];
+                        if(IsDigit(content[temp]) || (content[temp] == '-' && lastChar == 'x'))
+                        {
+                            if(content[temp] == '-')
+                                bContainsDash = true;
+
+                            temp++;
+                            continue;
+                        }
+
+                        if(content[temp] == '.')
+                        {
+                            if(dotCount == 1 && token.extra8 > 1)
+                                return TokenType::Invalid;  // Float can't have more than 1 dot
+                            if(dotCount > 2)
+                                return TokenType::Invalid;  // Version can have 3 dots maximum
+                        
+                            dotCount++;
+                            temp++;
+                            continue;
+                        }
+
+                        if(content[temp] == 'x')
+                        {
+                            dotCount = 0;
+                            token.extra8++;
+                            temp++;
+                            continue;
+                        }
+
+                        if(IsSpace(content[temp]) || content[temp] == ',')
+                        {
+                            calculateResult();
+                            index = temp;
+                            return token;
+                        }
+
+                        return TokenType::Invalid; // Non allowed character
+                    }
+
+                    calculateResult();
+                    index = -1;
+                    return token;
+                }
+
+                if(content[firstNonDigit] == 'x')  // multi dimensional int
+                {
+                    Token token = Token(TokenType::IntLiteral, index);
+                    token.extra8 = 2;  // Used as dimension (2d, 3d, 4d, 5d, etc)
+
+                    size_t dotCount = 0;
+                    while(true)
+                    {
+                        size_t previous = firstNonDigit;
+                        firstNonDigit = FindFirstNotOf(content, CHAR_DIGIT, firstNonDigit + 1);
+
+                        if(firstNonDigit == std::string_view::npos) // we reached eof before any space or any other token
+                        {
+                            token.count = content.size() - token.startPosition;
+                            index = -1;
+                            return token;
+                        }
+
+                        if(previous + 1 == firstNonDigit && !(content[previous] == ',' && IsSpace(content[firstNonDigit])) && !(content[previous] == 'x' && content[firstNonDigit] == '-'))
+                            return TokenType::Invalid;  // It must have number(s) in between
+
+                        if(IsSpace(content[firstNonDigit]) || content[firstNonDigit] == ',')
+                        {
+                            token.count = firstNonDigit - token.startPosition;
+                            index = firstNonDigit;
+                            return token;
+                        }
+
+                        if(content[firstNonDigit] == 'x')
+                        {
+                            token.extra8++;
+                            dotCount = 0;
+                            continue;
+                        }
+
+                        if(content[firstNonDigit] == '.')
+                        {
+                            dotCount++;
+                            if(dotCount > 1)
+                                return TokenType::Invalid;  // Multi dimensional numbers can't contain more than 1 dot (for each number)
+
+                            continue;
+                        }
+                    }
+                }
+
+
+
+
+
+                /* Possible datetime formats
+                *  2024-12-24T15:30:00       -> Date + Time without timezone info (Usually interpreted as local time)
+                *  2024-12-24T15:30:00Z      -> Date + Time with timezone info (Z means utc/zulu time)
+                *  2024-12-24T15:30:00+05:30 -> Date + Time with timezone info (5 hours and 30 minutes ahead of UTC)
+                *  2024-12-24                -> Date
+                *  15:30:00                  -> Time
+                *  2024-12-24T15:30:00.123Z  -> Date + Time with timezone info (Z means utc/zulu time) and milliseconds (123ms)
+                *  2024-W52-2                -> Year + Week + Weekday (52nd week of 2024, tuesday)
+                *  2024-359                  -> Year + Day of Year (359th day of 2024)
+                */
+
+                /* Possible duration formats (if we wanna support it, currently we don't) (Note: not here, it starts with a letter)
+                *  P3D              -> 3 days
+                *  P2W              -> 2 weeks (14 days)
+                *  P1Y2M3D          -> 1 year, 2 months, 3 days
+                *  P2WT3H           -> 2 weeks and 3 hours
+                *  P5DT4H30M        -> 5 days, 4 hours, and 30 minutes
+                *  PT1H45M          -> 1 hour and 45 minutes
+                *  P1Y2M3DT4H30M10S -> 1 year, 2 months, 3 days, 4 hours, 30 minutes, and 10 seconds
+                *  P10M             -> 10 minutes
+                *  PT10M            -> 10 minutes (alternative representation for time)
+                *  PT1.5S           -> 1.5 seconds (1 second and 500 milliseconds)
+                *  PT0.000001S      -> 1 microsecond (0.000001 seconds)
+                *  P1.5Y            -> 1.5 years (1 year and 6 months)
+                *  P3DT5H30M        -> 3 days, 5 hours, and 30 minutes
+                *  PT0.5H           -> 30 minutes (0.5 hours)
+                *  P2Y3M4DT5H6M7S   -> 2 years, 3 months, 4 days, 5 hours, 6 minutes, and 7 seconds
+                */
+
+
+                if(content[firstNonDigit] == '-')  // date or datetime
+                {
+                    Token token = Token(TokenType::TimestampLiteral, index);
+                    size_t firstNonDate = FindFirstNotOf(content, CHAR_DATE, index);
+                    if(firstNonDate == std::string_view::npos)
+                    {
+                        token.count = content.size() - token.startPosition;
+                        index = -1;
+                        return token;
+                    }
+
+                    if(IsSpace(content[firstNonDate]) || content[firstNonDate] == ',')
+                    {
+                        token.count = firstNonDate - token.startPosition;
+                        index = firstNonDate;
+                        return token;
+                    }
+
+                    return TokenType::Invalid;  // Invalid character after timestamp
+                }
+
+                if(content[firstNonDigit] == ':')  // time
+                {
+                    Token token = Token(TokenType::TimestampLiteral, index);
+                    size_t firstNonDate = FindFirstNotOf(content, CHAR_TIME, index);  // idk if it can include timezone ("+" sign)
+                    if(firstNonDate == std::string_view::npos)
+                    {
+                        token.count = content.size() - token.startPosition;
+                        index = -1;
+                        return token;
+                    }
+
+                    if(IsSpace(content[firstNonDate]) || content[firstNonDate] == ',')
+                    {
+                        token.count = firstNonDate - token.startPosition;
+                        index = firstNonDate;
+                        return token;
+                    }
+
+                    return TokenType::Invalid;  // Invalid character after timestamp
+                }
+
+                return TokenType::Invalid;  // Something we didn't process yet?
+            }
+
+            default:
+                return TokenType::Invalid;  // Something we didn't process yet?
+        }
+    }
+
+
+
+
+    template<auto ERROR_CALLBACK, ParseOptions OPTIONS>
+    struct Utils
+    {
+        // The grammar below hands each parsed element to a sink, this one builds entries from them
+        // Nodes are entry indices, children are counted once they are complete so a container also counts the descendants of its children
+        struct EntrySink
+        {
+            EntryVector& entries;
+            EntryIndex& index;
+            std::vector<EntryPosition>* positions = nullptr;  // Receives the position of each top level entry and map child, if given
+
+            constexpr void MarkEntryStart(size_t sourceOffset)
+            {
+                if(positions != nullptr)
+                    positions->push_back({ .sourceOffset = sourceOffset, .entryIndex = entries.size() });
+            }
+
+            [[nodiscard]] constexpr bool BeginEntry(size_t parent, bool bArrayElement, std::string_view identifier, size_t& node)
+            {
+                node = entries.size();
+                Entry& entry = entries.emplace_back();
+
+                // Array elements only store their position, identifiers are interned so repeated keys share one allocation
+                if(bArrayElement)
+                    entry.arrayIndex = entries[parent].size;
+                else
+                {
+                    identifier = index.Intern(identifier);
+                    entry.identifier = identifier.data();
+                    entry.identifierSize = identifier.size();
+                }
+
+                if(parent != -1)
+                {
+                    Entry& parentEntry = entries[parent];
+                    entry.parentOffset = node - parent;
+                    entry.depth = parentEntry.depth + 1;
+                    if(entry.depth == 0)
+                        throw std::runtime_error("Max depth(255) is exceeded");
+
+                    parentEntry.size++;
+                }
+                return true;
+            }
+
+            [[nodiscard]] constexpr bool EndEntry(size_t node)
+            {
+                const Entry& entry = entries[node];
+                if(entry.parentOffset != 0)
+                    entries[node - entry.parentOffset].data.u[0] += 1 + entry.GetChildCount();
+                return OverrideEntry(entries, index.Insert(entries, node), node);
+            }
+
+            [[nodiscard]] constexpr bool SetValue(size_t node, std::string_view view, Token token)
+            {
+                if constexpr(OPTIONS.bLazyValues)
+                    return DeferValue(view, token, entries[node]);
+                else
+                    return DecodeValue(view, token, entries[node]);
+            }
+
+            [[nodiscard]] constexpr bool BeginContainer(size_t node, bool bIsArray)
+            {
+                Entry& entry = entries[node];
+                entry.type = bIsArray? Type::Array : Type::Map;
+                entry.data.u[0] = 0;  // Total tree size (total child count, not just top level)
+                entry.data.u[1] = index.NewContainerKey();
+                return true;
+            }
+
+            [[nodiscard]] constexpr bool EndContainer(size_t, bool) const noexcept
+            {
+                return true;
+            }
+
+        #if !FDF_NO_COMMENTS
+            [[nodiscard]] constexpr bool AddComment(size_t node, std::string_view comment)
+            {
+                SetComment(entries[node], comment);
+                return true;
+            }
+
+            // Collected by "ParseEntries" instead, a file comment can be split across several comments
+            [[nodiscard]] constexpr bool AddFileComment(std::string_view) const noexcept
+            {
+                return true;
+            }
+        #endif
+        };
+
+        // "positions" receives the position of each top level entry and map child, if given
+        [[nodiscard]] constexpr static bool ParseFileContent(std::string_view content, EntryVector& entries, EntryIndex& index,
+        #if !FDF_NO_COMMENTS
+            std::string& fileComment,
+        #endif
+            size_t& topLevelEntryCount, std::vector<EntryPosition>* positions = nullptr) noexcept
+        {
+        #if !FDF_NO_COMMENTS
+            return ParseRange(content, 1, entries, index, fileComment, entries.empty(), topLevelEntryCount, positions);
+        #else
+            return ParseRange(content, 1, entries, index, topLevelEntryCount, positions);
+        #endif
+        }
+
+        // Parses a part of a content that only consists of whole top level entries, "content" starts at the beginning of "firstLine"
+        // Only the first range of a content can have the file comment. Parsing starts at "startOffset", offsets are relative to "content"
+        // "trailingOffset" receives where the comments and new lines after the last entry start, if given
+        [[nodiscard]] constexpr static bool ParseRange(std::string_view content, size_t firstLine, EntryVector& entries, EntryIndex& index,
+        #if !FDF_NO_COMMENTS
+            std::string& fileComment, bool bFirstRange,
+        #endif
+            size_t& topLevelEntryCount, std::vector<EntryPosition>* positions = nullptr, size_t startOffset = 0, size_t* trailingOffset = nullptr) noexcept
+        {
+            if(content.size() - startOffset >= SIZE_ESTIMATE_THRESHOLD)
+            {
+                const SizeEstimate estimate = EstimateSizes(content.substr(startOffset));
+                entries.reserve(entries.size() + estimate.entryCountEstimate);
+                index.Reserve(entries.size() + estimate.entryCountEstimate);
+            }
+
+            EntrySink sink = { .entries = entries, .index = index, .positions = positions };
+            Tokenizer tokenizer(content, firstLine, startOffset);
+        #if !FDF_NO_COMMENTS
+            return ParseEntries(content, tokenizer, sink, fileComment, bFirstRange, topLevelEntryCount, trailingOffset);
+        #else
+            return ParseEntries(content, tokenizer, sink, topLevelEntryCount, trailingOffset);
+        #endif
+        }
+
+        // Parses top level entries until the end of the content of "tokenizer", each element is handed to "sink"
+        template<typename SINK>
+        [[nodiscard]] constexpr static bool ParseEntries(std::string_view content, Tokenizer& tokenizer, SINK& sink,
+        #if !FDF_NO_COMMENTS
+            std::string& fileComment, bool bFirstRange,
+        #endif
+            size_t& topLevelEntryCount, size_t* trailingOffset = nullptr) noexcept
+        {
+        #if !FDF_NO_COMMENTS
+            Token fileCommentToken = TokenType::NonExisting;
+            bool bFirstEntry = bFirstRange;
+        #endif
+            bool bEndOfFile = false;
+            while(!bEndOfFile)
+            {
+                if(trailingOffset != nullptr)
+                    *trailingOffset = tokenizer.CurrentOffset();
+            #if !FDF_NO_COMMENTS
+                if(!ParseTopLevelEntry(content, tokenizer, sink, fileComment, fileCommentToken, bFirstEntry, topLevelEntryCount, bEndOfFile))
+                    return false;
+                bFirstEntry = false;
+            #else
+                if(!ParseTopLevelEntry(content, tokenizer, sink, topLevelEntryCount, bEndOfFile))
+                    return false;
+            #endif
+            }
+
+        #if !FDF_NO_COMMENTS
+            if(fileCommentToken.type != TokenType::NonExisting)
+                TrimWhitespaceMultilineInPlace(fileCommentToken.ToView(content), fileComment);
+        #endif
+            return true;
+        }
+
+        // Parses whole children of a map at "depth" in a part of a content, "entries" receives a stand-in for the map followed by the children
+        // Parsing starts at "startOffset" and stops at the end of "content", "trailingOffset" receives where the comments and new lines after the last child start
+        [[nodiscard]] constexpr static bool ParseMapChildren(std::string_view content, uint8_t depth, EntryVector& entries, EntryIndex& index,
+            std::vector<EntryPosition>& positions, size_t startOffset, size_t& trailingOffset) noexcept
+        {
+            Entry& map = entries.emplace_back();
+            map.type = Type::Map;
+            map.depth = depth;
+            map.data.u[0] = 0;
+            map.data.u[1] = index.NewContainerKey();
+
+            EntrySink sink = { .entries = entries, .index = index, .positions = &positions };
+            Tokenizer tokenizer(content, 1, startOffset);
+            Token currentToken = tokenizer.Current();
+            while(true)
+            {
+                trailingOffset = tokenizer.CurrentOffset();
+            #if !FDF_NO_COMMENTS
+                Token childComment;
+            #endif
+                while(currentToken.type == TokenType::Comment || currentToken.type == TokenType::NewLine)
+                {
+                #if !FDF_NO_COMMENTS
+                    if(currentToken.type == TokenType::Comment)
+                    {
+                        if(!AttachComment(tokenizer, childComment, currentToken))
+                            return false;
+                    }
+                #endif
+
+                    currentToken = tokenizer.Advance();
+                    FDF_CHECK_TOKEN(currentToken);
+                }
+
+                if(currentToken.type == TokenType::EndOfFile)
+                    return true;
+                if(currentToken.type != TokenType::Identifier)
+                    return false;
+
+                sink.MarkEntryStart(trailingOffset);
+            #if !FDF_NO_COMMENTS
+                if(!ParseVariable(content, tokenizer, sink, childComment, 0, false))
+                    return false;
+            #else
+                if(!ParseVariable(content, tokenizer, sink, 0, false))
+                    return false;
+            #endif
+
+                currentToken = tokenizer.Current();
+                if(currentToken.type == TokenType::Comma)
+                {
+                    currentToken = tokenizer.Advance();
+                    FDF_CHECK_TOKEN(currentToken);
+                }
+            }
+        }
+
+
+
+
+        // Parses the comments and new lines in front of a top level entry and then the entry itself
+        // "bEndOfFile" is set instead if there is no entry left
+        template<typename SINK>
+        [[nodiscard]] constexpr static bool ParseTopLevelEntry(std::string_view content, Tokenizer& tokenizer, SINK& sink,
+        #if !FDF_NO_COMMENTS
+            const std::string& fileComment, Token& fileCommentToken, bool bFirstEntry,
+        #endif
+            size_t& topLevelEntryCount, bool& bEndOfFile)
+        {
+        #if !FDF_NO_COMMENTS
+            Token comment = TokenType::NonExisting;
+        #endif
+            const size_t entryOffset = tokenizer.CurrentOffset();
+            Token currentToken = tokenizer.Current();
+            FDF_CHECK_TOKEN(currentToken);
+
+            while(currentToken.type == TokenType::Comment || currentToken.type == TokenType::NewLine)
+            {
+            #if !FDF_NO_COMMENTS
+                if(currentToken.type == TokenType::Comment)
+                {
+                    if(bFirstEntry && fileComment.empty() && currentToken.count > 0 && content[currentToken.startPosition] == '#')
+                    {
+                        std::string_view sv = currentToken.ToView(content);
+                        size_t firstChar = sv.find_first_not_of("# ");
+                        if(firstChar == std::string_view::npos)
+                        {
+                            currentToken.startPosition += currentToken.count;
+                            currentToken.count = 0;
+                        }
+                        else
+                        {
+                            currentToken.startPosition += firstChar;
+                            currentToken.count = currentToken.count - firstChar;
+                            if(content[currentToken.startPosition] == '\n')
+                            {
+                                currentToken.startPosition++;
+                                currentToken.count--;
+                            }
+                        }
+
+                        if(!AttachComment(tokenizer, fileCommentToken, currentToken, "File"))
+                            return false;
+                        FDF_FORWARD_ERROR(sink.AddFileComment(currentToken.ToView(content)));
+                    }
+                    else
+                    {
+                        if(!AttachComment(tokenizer, comment, currentToken))
+                            return false;
+                    }
+                }
+            #endif
+
+                currentToken = tokenizer.Advance();
+            }
+
+            if(currentToken.type == TokenType::Identifier)
+            {
+                topLevelEntryCount++;
+                sink.MarkEntryStart(entryOffset);
+
+            #if !FDF_NO_COMMENTS
+                return ParseVariable(content, tokenizer, sink, comment, -1, false);
+            #else
+                return ParseVariable(content, tokenizer, sink, -1, false);
+            #endif
+            }
+
+            bEndOfFile = currentToken.type == TokenType::EndOfFile;
+            return bEndOfFile;  // First token can't be anything else
+        }
+    
+    
+    
+    
+        // "parent" is the node "sink" returned for the enclosing container, or -1 for a top level entry
+        template<typename SINK>
+        [[nodiscard]] constexpr static bool ParseVariable(std::string_view content, Tokenizer& tokenizer, SINK& sink,
+        #if !FDF_NO_COMMENTS
+            Token comment,
+        #endif
+            size_t parent, bool bArrayElement)
+        {
+            Token currentToken = tokenizer.Current();
+            std::string_view identifier;
+            if(!bArrayElement)
+            {
+                identifier = currentToken.ToView(content);
+
+                // Reported instead of thrown, parsing is noexcept
+                if(identifier.size() > std::numeric_limits<uint8_t>::max())
+                {
+                    ReportError<ERROR_CALLBACK>(Diagnostic(Error::IdentifierTooLong, content, tokenizer.GetFirstLine(), "Identifier", identifier));
+                    return false;
+                }
+
+                currentToken = tokenizer.Advance();
+            }
+
+            size_t node = 0;
+            FDF_FORWARD_ERROR(sink.BeginEntry(parent, bArrayElement, identifier, node));
+    
+            FDF_CHECK_TOKEN(currentToken);
+            FDF_CHECK_TOKEN_FOR_EOF(currentToken);
+    
+            bool bHasEqual = false;
+            if(currentToken.type == TokenType::Equal)
+            {
+                bHasEqual = true;
+                currentToken = tokenizer.Advance();
+                FDF_CHECK_TOKEN(currentToken);
+                FDF_CHECK_TOKEN_FOR_EOF(currentToken);
+            }
+
+            while(currentToken.type == TokenType::Comment || currentToken.type == TokenType::NewLine)
+            {
+            #if !FDF_NO_COMMENTS
+                if(currentToken.type == TokenType::Comment)
+                {
+                    if(!AttachComment(tokenizer, comment, currentToken))
+                        return false;
+                }
+            #endif
+
+                currentToken = tokenizer.Advance();
+                FDF_CHECK_TOKEN(currentToken);
+                FDF_CHECK_TOKEN_FOR_EOF(currentToken);
+            }
+
+            const bool bIsContainer = currentToken.type == TokenType::CurlyBraceOpen || currentToken.type == TokenType::SquareBraceOpen;
+        #if !FDF_NO_COMMENTS
+            if(IsValueLiteral(currentToken.type) && (bHasEqual || bArrayElement))
+                return ParseSimpleValue(content, tokenizer, sink, comment, node) && sink.EndEntry(node);
+            if(bIsContainer)
+                return ParseContainer(content, tokenizer, sink, comment, node, currentToken.type == TokenType::SquareBraceOpen) && sink.EndEntry(node);
+        #else
+            if(IsValueLiteral(currentToken.type) && (bHasEqual || bArrayElement))
+                return ParseSimpleValue(content, tokenizer, sink, node) && sink.EndEntry(node);
+            if(bIsContainer)
+                return ParseContainer(content, tokenizer, sink, node, currentToken.type == TokenType::SquareBraceOpen) && sink.EndEntry(node);
+        #endif
+    
+            return false;  // Something we didn't process yet?
+        }
+    
+    
+    
+    
+    #if !FDF_NO_COMMENTS
+        constexpr static void SetComment(Entry& entry, std::string_view comment)
+        {
+            if constexpr(OPTIONS.bBorrowSource)
+                entry.borrowedComment = comment;
+            else
+                entry.comment = comment;
+        }
+
+        // Makes "newComment" the comment of "target", only one comment can be attached to the same entry (or file)
+        // With "ParseOptions::bSkipComments" nothing is attached, so comments are neither tracked nor reported
+        [[nodiscard]] constexpr static bool AttachComment(const Tokenizer& tokenizer, Token& target, Token newComment, std::string_view owner = "Token")
+        {
+            if constexpr(OPTIONS.bSkipComments)
+            {
+                return true;
+            }
+            else
+            {
+                const std::string_view content = tokenizer.GetContent();
+                if(target.type != TokenType::NonExisting)
+                    if(!ReportError<ERROR_CALLBACK>(Diagnostic(Error::AlreadyHasComment, content, tokenizer.GetFirstLine(), owner, newComment.ToView(content), target.ToView(content))))
+                        return false;
+
+                target = newComment;
+                return true;
+            }
+        }
+    #endif
+
+        // Points the string payload of "entry" to "view" instead of copying it, only used with "ParseOptions::bBorrowSource"
+        constexpr static void BorrowString(Entry& entry, std::string_view view) noexcept
+        {
+            entry.bBorrowedData = true;
+            entry.size = view.size();
+            entry.data.strDynamic.capacity = 0;
+            entry.data.strDynamic.data = nullptr;
+            entry.data.strDynamic.view = view;
+            entry.data.strDynamic.resource = nullptr;
+        }
+
+
+
+
+        template<typename SINK>
+        [[nodiscard]] constexpr static bool ParseSimpleValue(std::string_view content, Tokenizer& tokenizer, SINK& sink,
+        #if !FDF_NO_COMMENTS
+            Token comment,
+        #endif
+            size_t node)
+        {
+            Token currentToken = tokenizer.Current();
+            FDF_FORWARD_ERROR(sink.SetValue(node, currentToken.ToView(content), currentToken));
+
+            currentToken = tokenizer.Advance();
+            if(currentToken.type == TokenType::Comment)
+            {
+            #if !FDF_NO_COMMENTS
+                if(!AttachComment(tokenizer, comment, currentToken))
+                    return false;
+            #endif
+                currentToken = tokenizer.Advance();
+            }
+    
+            if(currentToken.type == TokenType::NewLine)
+                tokenizer.Advance();
+
+        #if !FDF_NO_COMMENTS
+            if(comment.type != TokenType::NonExisting)
+                return sink.AddComment(node, comment.ToView(content));
+        #endif
+            return true;
+        }
+
+        // Only records the token, the value is decoded by "Entry::Resolve" on first access
+        // Keywords and evaluate literals are as cheap to decode as to record, so they are decoded right away
+        [[nodiscard]] constexpr static bool DeferValue(std::string_view view, Token currentToken, Entry& entry) noexcept
+        {
+            switch(currentToken.type)
+            {
+                case TokenType::IntLiteral:       entry.type = Type::Int;       break;  // Might become "Type::UInt" once decoded
+                case TokenType::FloatLiteral:     entry.type = Type::Float;     break;
+                case TokenType::VersionLiteral:   entry.type = Type::Version;   break;
+                case TokenType::StringLiteral:    entry.type = Type::String;    break;
+                case TokenType::HexLiteral:       entry.type = Type::Hex;       break;
+                case TokenType::TimestampLiteral: entry.type = Type::Timestamp; break;
+                default:
+                    return DecodeValue(view, currentToken, entry);
+            }
+
+            if((currentToken.type == TokenType::IntLiteral || currentToken.type == TokenType::FloatLiteral) && currentToken.extra8 > VARIANT_64BIT_ELEMENT_COUNT)
+                return false;  // Too much dimensions
+
+            BorrowString(entry, view);
+            entry.bLazyValue = true;
+            entry.size = static_cast<uint32_t>(currentToken.type) | (static_cast<uint32_t>(currentToken.extra8) << 8);  // Token type and extra data, needed for decoding
+            return true;
+        }
+
+        // Decodes the value token "view" into "entry", shared by eager parsing and "Entry::Resolve"
+        [[nodiscard]] constexpr static bool DecodeValue(std::string_view view, Token currentToken, Entry& entry)
+        {
+            if(currentToken.type == TokenType::Keyword)
+            {
+                if(currentToken.extra8 == 0 || currentToken.extra8 == 1)
+                {
+                    entry.type = Type::Null;
+                    return true;
+                }
+                if(currentToken.extra8 == 2 || currentToken.extra8 == 3)
+                {
+                    entry.type = Type::Bool;
+                    entry.size = 1;
+                    entry.data.b[0] = currentToken.extra8 == 2;
+                    return true;
+                }
+
+                if(currentToken.extra8 == 4)
+                {
+                    entry.type = Type::Bool;
+                    entry.size = 0;
+
+                    std::string_view mdBool = view;
+                    bool bLastWasBoolLiteral = false;
+                    while(!mdBool.empty())
+                    {
+                        if(entry.size >= VARIANT_SIZE)
+                        {
+                            entry.type = Type::Invalid;
+                            return false;
+                        }
+
+                        if(mdBool.starts_with(KEYWORDS[2]))
+                        {
+                            if(bLastWasBoolLiteral)
+                            {
+                                entry.type = Type::Invalid;
+                                return false;
+                            }
+
+                            bLastWasBoolLiteral = true;
+                            entry.data.b[entry.size++] = true;
+                            mdBool = mdBool.substr(4);
+                        }
+                        else if(mdBool.starts_with(KEYWORDS[3]))
+                        {
+                            if(bLastWasBoolLiteral)
+                            {
+                                entry.type = Type::Invalid;
+                                return false;
+                            }
+
+                            bLastWasBoolLiteral = true;
+                            entry.data.b[entry.size++] = false;
+                            mdBool = mdBool.substr(5);
+                        }
+                        else if(mdBool.starts_with('x'))
+                        {
+                            if(!bLastWasBoolLiteral)
+                            {
+                                entry.type = Type::Invalid;
+                                return false;
+                            }
+
+                            bLastWasBoolLiteral = false;
+                            mdBool = mdBool.substr(1);
+                        }
+                        else
+                        {
+                            entry.type = Type::Invalid;
+                            return false;
+                        }
+                    }
+
+                    return true;
+                }
+    
+                return false;  // Invalid keyword when expected a value
+            }
+    
+            entry.size = currentToken.extra8;  // Dimension count or string length
+    
+    
+    
+    
+            if((currentToken.type == TokenType::IntLiteral || currentToken.type == TokenType::FloatLiteral) && entry.size > VARIANT_64BIT_ELEMENT_COUNT)
+                return false;  // Too much dimensions
+    
+    
+    
+    
+            if(currentToken.type == TokenType::IntLiteral)
+            {
+                // Any dimension above the int64 range makes all of them unsigned, so negative values can't be mixed with those
+                bool bIsUnsigned = false;
+                bool bContainsAnyNegative = false;
+                uint64_t values[VARIANT_64BIT_ELEMENT_COUNT] = {};  // Two's complement, only one union member can be written during constant evaluation
+                uint8_t currentDimension = 0;
+                while(true)
+                {
+                    const bool bIsNegative = view.starts_with('-');
+                    if(bIsNegative)
+                        view.remove_prefix(1);
+
+                    uint64_t result = 0;
+                    const size_t digitCount = ParseDigits(view, result);
+                    if(digitCount == std::string_view::npos)
+                        return false;  // Overflow
+                    view.remove_prefix(digitCount);
+
+                    if(view.starts_with('.'))  // Fractions of multi dimensional ints are dropped
+                    {
+                        size_t fractionEnd = 1;
+                        while(fractionEnd < view.size() && (view[fractionEnd] == '.' || IsDigit(view[fractionEnd])))
+                            fractionEnd++;
+                        view.remove_prefix(fractionEnd);
+                    }
+
+                    if(bIsNegative)
+                    {
+                        if(result > INT64_MAX_VALUE)
+                            return false;
+
+                        bContainsAnyNegative = true;
+                        values[currentDimension] = static_cast<uint64_t>(-static_cast<int64_t>(result));
+                    }
+                    else
+                    {
+                        bIsUnsigned = bIsUnsigned || result > INT64_MAX_VALUE;
+                        values[currentDimension] = result;
+                    }
+
+                    if(bIsUnsigned && bContainsAnyNegative)
+                        return false;
+
+                    if(view.empty())
+                        break;
+                    if(view[0] != 'x')
+                        return false;  // unknown character
+                    if(currentDimension >= entry.size - 1)
+                        return false;  // Too much dimensions
+
+                    view.remove_prefix(1);
+                    currentDimension++;
+                }
+    
+                for(size_t i = 0; i <= currentDimension; i++)
+                {
+                    if(bIsUnsigned)
+                        entry.data.u[i] = values[i];
+                    else
+                        entry.data.i[i] = static_cast<int64_t>(values[i]);
+                }
+
+                entry.type = bIsUnsigned? Type::UInt : Type::Int;
+                return true;
+            }
+    
+    
+    
+    
+            if(currentToken.type == TokenType::FloatLiteral)
+            {
+                entry.type = Type::Float;
+    
+                uint8_t currentDimension = 0;
+                while(true)
+                {
+                    const size_t dimensionEnd = std::min(view.find('x'), view.size());
+                    if(!ParseFloat(view.substr(0, dimensionEnd), entry.data.f[currentDimension]))
+                        return false;
+
+                    if(dimensionEnd == view.size())
+                        break;
+                    if(currentDimension >= entry.size - 1)
+                        return false;  // Too much dimensions
+
+                    view.remove_prefix(dimensionEnd + 1);
+                    currentDimension++;
+                }
+    
+                return true;
+            }
+    
+    
+    
+    
+            if(currentToken.type == TokenType::VersionLiteral)
+            {
+                entry.type = Type::Version;
+                entry.data.u[3] = 0;
+    
+                uint8_t currentDimension = 0;
+                while(true)
+                {
+                    uint64_t result = 0;
+                    const size_t digitCount = ParseDigits(view, result);
+                    if(digitCount == std::string_view::npos)
+                        return false;  // Overflow
+
+                    view.remove_prefix(digitCount);
+                    entry.data.u[currentDimension] = result;
+
+                    if(view.empty())
+                        break;
+                    if(view[0] != '.')
+                        return false;  // unknown character
+                    if(currentDimension >= entry.size - 1)
+                        return false;  // Too much dimensions
+
+                    view.remove_prefix(1);
+                    currentDimension++;
+                }
+    
+                return true;
+            }
+    
+    
+    
+            
+            size_t size = 0;
+            bool bDynamic = false;
+            auto writeCharacter = [&](char c)
+            {
+                if(size < VARIANT_SIZE)
+                {
+                    entry.data.str[size++] = c;
+                }
+                else
+                {
+                    if(!bDynamic)
+                    {
+                        bDynamic = true;
+                        char buffer[VARIANT_SIZE] = {};
+                        constexpr_memcpy(buffer, entry.data.str, size);
+                        entry.data.strDynamic.InitialAllocate(entry.GetMemoryResource(), entry.size + 1);
+                        constexpr_memcpy(entry.data.strDynamic.data, buffer, size);
+                    }
+    
+                    entry.data.strDynamic[size++] = c;
+                }
+            };
+            auto writeDynamicCharacter = [&](char c)
+            {
+                entry.data.strDynamic[size++] = c;
+            };
+    
+            if(currentToken.type == TokenType::StringLiteral)
+            {
+                entry.size = view.size() - 2;
+                entry.type = Type::String;
+
+                const size_t start = 1;
+                const size_t end = view.size() - 1;
+
+                if constexpr(OPTIONS.bBorrowSource)
+                {
+                    // Only strings that contain escapes need a buffer of their own
+                    if(view.find('\\', start) >= end)
+                    {
+                        BorrowString(entry, view.substr(start, end - start));
+                        return true;
+                    }
+                }
+
+                auto isEscapableChar     = [](char c) -> bool  { return c == '\"' || c == '\'' || c == '\\'; };
+                auto isMergeEscapeChar   = [](char c) -> bool  { return c == 'n'  || c == 'r'  || c == 't' || c == 'v' || c == 'b' || c == 'f' || c == 'a'; };
+                auto isUnicodeEscapeChar = [](char c) -> bool  { return c == 'u'  || c == 'U'; };  // TODO: Maybe handle unicode?
+
+                auto convertMergedEscapeChar = [](char c) -> char
+                {
+                    if(c == 'n')
+                        return '\n';
+                    if(c == 'r')
+                        return '\r';
+                    if(c == 't')
+                        return '\t';
+                    if(c == 'v')
+                        return '\v';
+                    if(c == 'b')
+                        return '\b';
+                    if(c == 'f')
+                        return '\f';
+                    if(c == 'a')
+                        return '\a';
+                    return c;
+                };
+    
+                size_t escapeCharacters = 0;
+                if(view.size() < VARIANT_DYNAMIC_STRING_HARD_LIMIT)
+                {
+                    for(size_t i = start; i < end; i++)
+                    {
+                        if(view[i] == '\\' && i + 1 < end && (isEscapableChar(view[i + 1]) || isMergeEscapeChar(view[i + 1])))
+                        {
+                            i++;
+                            entry.size--;
+
+                            if(isEscapableChar(view[i]))
+                                writeCharacter(view[i]);
+                            else
+                                writeCharacter(convertMergedEscapeChar(view[i]));
+                        }
+                        else
+                        {
+                            writeCharacter(view[i]);
+                        }
+                    }
+                    writeCharacter('\0');
+                }
+                else
+                {
+                    entry.data.strDynamic.InitialAllocate(entry.GetMemoryResource(), entry.size + 1);
+                    for(size_t i = start; i < end; i++)
+                    {
+                        if(view[i] == '\\' && i + 1 < end && (isEscapableChar(view[i + 1]) || isMergeEscapeChar(view[i + 1])))
+                        {
+                            i++;
+                            entry.size--;
+
+                            if(isEscapableChar(view[i]))
+                                writeDynamicCharacter(view[i]);
+                            else
+                                writeDynamicCharacter(convertMergedEscapeChar(view[i]));
+                        }
+                        else
+                        {
+                            writeDynamicCharacter(view[i]);
+                        }
+                    }
+    
+                    writeDynamicCharacter('\0');
+                    entry.data.strDynamic.RefreshView();
+                }
+
+                return true;
+            }
+    
+    
+    
+    
+            if(currentToken.type == TokenType::HexLiteral || currentToken.type == TokenType::TimestampLiteral)
+            {
+                entry.size = view.size();
+                entry.type = currentToken.type == TokenType::HexLiteral? Type::Hex : Type::Timestamp;
+    
+                if constexpr(OPTIONS.bBorrowSource)
+                {
+                    BorrowString(entry, view);
+                    return true;
+                }
+
+                if(view.size() + 1 < VARIANT_SIZE)
+                {
+                    constexpr_memcpy(entry.data.str, view.data(), view.size());
+                    entry.data.str[view.size()] = '\0';
+                }
+                else
+                {
+                    entry.data.strDynamic.InitialAllocate(entry.GetMemoryResource(), entry.size + 1);
+                    constexpr_memcpy(entry.data.strDynamic.data, view.data(), view.size());
+                    entry.data.strDynamic.data[view.size()] = '\0';
+                    entry.data.strDynamic.RefreshView();
+                }
+
+                return true;
+            }
+    
+    
+    
+    
+            if(currentToken.type == TokenType::EvaluateLiteral)
+            {
+                entry.size = EVALUATE_LITERAL_TEXT.size();
+                entry.type = Type::String;
+                constexpr_memcpy(entry.data.str, EVALUATE_LITERAL_TEXT.data(), EVALUATE_LITERAL_TEXT.size());
+
+                return true;
+            }
+    
+            return false;  // Something we didn't process yet?
+        }
+    
+    
+    
+    
+        // Parses an array or a map, "node" is the container itself
+        template<typename SINK>
+        [[nodiscard]] constexpr static bool ParseContainer(std::string_view content, Tokenizer& tokenizer, SINK& sink,
+        #if !FDF_NO_COMMENTS
+            Token comment,
+        #endif
+            size_t node, bool bIsArray)
+        {
+            FDF_FORWARD_ERROR(sink.BeginContainer(node, bIsArray));
+    
+            Token currentToken = tokenizer.Advance();
+            FDF_CHECK_TOKEN(currentToken);
+            FDF_CHECK_TOKEN_FOR_EOF(currentToken);
+
+            const TokenType closeType = bIsArray? TokenType::SquareBraceClose : TokenType::CurlyBraceClose;
+            while(true)
+            {
+                const size_t childOffset = tokenizer.CurrentOffset();
+            #if !FDF_NO_COMMENTS
+                Token childComment;
+            #endif
+                while(currentToken.type == TokenType::Comment || currentToken.type == TokenType::NewLine)
+                {
+                #if !FDF_NO_COMMENTS
+                    if(currentToken.type == TokenType::Comment)
+                    {
+                        if(!AttachComment(tokenizer, childComment, currentToken))
+                            return false;
+                    }
+                #endif
+    
+                    currentToken = tokenizer.Advance();
+                    FDF_CHECK_TOKEN(currentToken);
+                    FDF_CHECK_TOKEN_FOR_EOF(currentToken);
+                }
+    
+    
+                const bool bIsChild = bIsArray? IsValueLiteral(currentToken.type) || currentToken.type == TokenType::CurlyBraceOpen || currentToken.type == TokenType::SquareBraceOpen
+                                              : currentToken.type == TokenType::Identifier;
+                if(bIsChild)
+                {
+                    // Map children can be parsed again on their own (see "IO::Reparse"), array elements can't
+                    if(!bIsArray)
+                        sink.MarkEntryStart(childOffset);
+
+                #if !FDF_NO_COMMENTS
+                    if(!ParseVariable(content, tokenizer, sink, childComment, node, bIsArray))
+                        return false;
+                #else
+                    if(!ParseVariable(content, tokenizer, sink, node, bIsArray))
+                        return false;
+                #endif
+    
+                    currentToken = tokenizer.Current();
+                    if(currentToken.type == TokenType::Comma)
+                    {
+                        currentToken = tokenizer.Advance();
+                        FDF_CHECK_TOKEN(currentToken);
+                        FDF_CHECK_TOKEN_FOR_EOF(currentToken);
+                    }
+                }
+                else if(currentToken.type == closeType)
+                {
+                    currentToken = tokenizer.Advance();
+                    FDF_CHECK_TOKEN(currentToken);
+
+                    if(currentToken.type == TokenType::Comment)
+                    {
+                    #if !FDF_NO_COMMENTS
+                        if(!AttachComment(tokenizer, comment, currentToken))
+                            return false;
+                    #endif
+                        currentToken = tokenizer.Advance();
+                        FDF_CHECK_TOKEN(currentToken);
+                    }
+    
+                    if(currentToken.type == TokenType::NewLine)
+                    {
+                        currentToken = tokenizer.Advance();
+                        FDF_CHECK_TOKEN(currentToken);
+                    }
+
+                    FDF_FORWARD_ERROR(sink.EndContainer(node, bIsArray));
+                #if !FDF_NO_COMMENTS
+                    if(comment.type != TokenType::NonExisting)
+                        return sink.AddComment(node, comment.ToView(content));
+                #endif
+                    return true;
+                }
+                else
+                    return false;
+            }
+        }
+    
+    
+    
+        constexpr static void CopyEntryDeep(EntryVector& target, const EntryVector& source, size_t sourceID)
+        {
+            size_t targetID = target.size() - 1;
+    
+            target[targetID].type = source[sourceID].type;
+            target[targetID].size = source[sourceID].size;
+    
+            for(size_t i = 0; i < source[sourceID].size; i++)
+            {
+                const size_t index = sourceID + i + 1;
+                Entry& last = target.emplace_back(source[index]);
+                last.depth += target[targetID].depth;
+                last.parentOffset = target.size() - 1 - targetID;
+                if(last.type == Type::Array || last.type == Type::Map)
+                    CopyEntryDeep(target, source, index);
+            }
+        }
+    
+        [[nodiscard]] constexpr static bool OverrideEntry(EntryVector& entries, size_t targetID, size_t sourceID)
+        {
+            // TODO: implement or completely get rid of overriding...
+            // For now, we don't allow any kind of name collision (we don't override anything)
+            return targetID == sourceID;
+
+
+            /*
+            if(targetID == sourceID)
+                return true;
+    
+            if(entries[targetID].type == entries[sourceID].type)
+            {
+                if(entries[targetID].type != Type::Array && entries[targetID].type != Type::Map)
+                {
+                    entries[targetID] = entries[sourceID];
+                    entries.pop_back();
+                    return true;
+                }
+                else
+                {
+                    // TODO: handle Array and Map
+                    // TODO: Just override every child and their childs and so on... Don't bother with merging or something like that
+                    return false;
+                }
+            }
+    
+            return false;  // Something we didn't process yet?
+            */
+        }
+
+
+
+
+
+
+
+
+
+
+        template<Style STYLE>
+        constexpr static void WriteFileContent(std::string& buffer, const EntryVector& entries
+        #if !FDF_NO_COMMENTS
+            , const std::string& fileComment
+        #endif
+            )
+        {
+            auto isShortArray   = [ ](const Entry& e) -> bool  { return e.data.u[0] <= STYLE.singleLineArrayLimit; };
+            auto isShortMap     = [ ](const Entry& e) -> bool  { return e.data.u[0] <= STYLE.singleLineMapLimit; };
+            auto writeEntryName = [&](const Entry& e) -> void  { buffer.append(e.GetIdentifier()); };
+            auto addTab = [&buffer](size_t count) -> void
+            {
+                if constexpr(STYLE.bUseSpacesOverTabs)
+                    buffer.append(count * STYLE.tabSize, ' ');
+                else
+                    buffer.append(count, '\t');
+            };
+            auto addEqualSign = [&buffer]() -> void
+            {
+                if constexpr(STYLE.bSpaceBeforeAndAfterEqualSign)
+                    buffer.append(" = ");
+                else
+                    buffer.push_back('=');
+            };
+            auto addComma = [&buffer]() -> void
+            {
+                if constexpr(STYLE.bSpaceAfterComma)
+                    buffer.append(", ");
+                else
+                    buffer.push_back(',');
+            };
+
+            auto writeLambda = [&](std::ranges::range auto&& order) -> void
+            {
+                buffer.clear();
+                buffer.reserve(entries.size() * 50);
+
+            #if !FDF_NO_COMMENTS
+                if constexpr(STYLE.bFileComment)
+                {
+                    if(!fileComment.empty())
+                    {
+                        buffer.append("/*#\n");
+                        size_t prevNewLinePos = -1;
+                        size_t newLinePos = fileComment.find_first_of('\n');
+                        while(newLinePos != std::string::npos)
+                        {
+                            addTab(1);
+                            buffer.append(fileComment, prevNewLinePos + 1, newLinePos - prevNewLinePos);
+                            prevNewLinePos = newLinePos;
+                            newLinePos = fileComment.find_first_of('\n', newLinePos + 1);
+                        }
+                        addTab(1);
+                        buffer.append(fileComment, prevNewLinePos + 1);
+                        buffer.append("\n*/\n\n\n");
+                    }
+                }
+            #endif
+
+                auto writeSimpleEntryValue = [&](const Entry& e) -> void
+                {
+                    std::string temp;
+                    std::string_view view = e.DataToView<STYLE>(temp);
+                    if(e.type != Type::String)
+                    {
+                        buffer.append(view);
+                    }
+                    else
+                    {
+                        bool bContainsQuote = view.find_first_of('\"') != std::string_view::npos; // does it contain double quote?
+                        if(bContainsQuote)
+                        {
+                            if constexpr(STYLE.bAlwaysUseDoubleQuoteForStrings)
+                            {
+                                buffer.push_back('\"');
+                                for(char c : view)
+                                {
+                                    if(c == '\"')
+                                        buffer.append("\\\"");
+                                    else
+                                        buffer.push_back(c);
+                                }
+                                buffer.push_back('\"');
+                            }
+                            else
+                            {
+                                bContainsQuote = view.find_first_of('\'') != std::string_view::npos; // does it contain single quote?
+                                if(bContainsQuote)
+                                {
+                                    buffer.push_back('\"');
+                                    for(char c : view)
+                                    {
+                                        if(c == '\"')
+                                            buffer.append("\\\"");
+                                        else
+                                            buffer.push_back(c);
+                                    }
+                                    buffer.push_back('\"');
+                                }
+                                else
+                                {
+                                    buffer.push_back('\'');
+                                    buffer.append(view);
+                                    buffer.push_back('\'');
+                                }
+                            }
+                        }
+                        else
+                        {
+                            buffer.push_back('\"');
+                            buffer.append(view);
+                            buffer.push_back('\"');
+                        }
+                    }
+                };
+
+                auto writeSimpleEntry = [&](const Entry& e) -> void
+                {
+                    writeEntryName(e);
+                    addEqualSign();
+                    writeSimpleEntryValue(e);
+                };
+
+
+
+
+                auto it = order.begin();
+                auto writeSingleLine = [&]<bool bIsArray>(this auto self, uint8_t depth) -> void
+                {
+                    if constexpr(bIsArray)
+                    {
+                        if constexpr(STYLE.bSpaceWithinParentheses)
+                            buffer.append("[ ");
+                        else
+                            buffer.push_back('[');
+                    }
+                    else
+                    {
+                        if constexpr(STYLE.bSpaceWithinParentheses)
+                            buffer.append("{ ");
+                        else
+                            buffer.push_back('{');
+                    }
+
+                    ++it;
+                    while(it != order.end())
+                    {
+                        const size_t index = *it;
+                        if(entries[index].depth < depth)
+                            break;
+
+                        if(!entries[index].IsContainer())
+                        {
+                            if constexpr(bIsArray)
+                                writeSimpleEntryValue(entries[index]);
+                            else
+                                writeSimpleEntry(entries[index]);
+
+                            addComma();
+                            ++it;
+                        }
+                        else
+                        {
+                            if constexpr(!bIsArray)
+                            {
+                                writeEntryName(entries[index]);
+                                if constexpr(STYLE.bUseEqualSignForSingleLineArraysAndMaps)
+                                    addEqualSign();
+                            }
+
+                            if(entries[index].type == Type::Array)
+                            {
+                                self.template operator()<true>(depth + 1);
+                                addComma();
+                            }
+                            else if(entries[index].type == Type::Map)
+                            {
+                                self.template operator()<false>(depth + 1);
+                                addComma();
+                            }
+                            else
+                                std::unreachable();
+                        }
+                    }
+
+                    if constexpr(STYLE.bSpaceAfterComma)
+                        buffer.erase(buffer.size() - 2);
+                    else
+                        buffer.pop_back();
+
+                    if constexpr(bIsArray)
+                    {
+                        if constexpr(STYLE.bSpaceWithinParentheses)
+                            buffer.append(" ]");
+                        else
+                            buffer.append("]");
+                    }
+                    else
+                    {
+                        if constexpr(STYLE.bSpaceWithinParentheses)
+                            buffer.append(" }");
+                        else
+                            buffer.append("}");
+                    }
+                };
+
+
+
+
+                auto writeMultiLine = [&]<bool bIsArray>(this auto self, uint8_t depth) -> void
+                {
+                    if constexpr(bIsArray)
+                    {
+                        if constexpr(STYLE.bParenthesesOnNewLine)
+                        {
+                            buffer.push_back('\n');
+                            addTab(depth - 1);
+                            buffer.append("[\n");
+                        }
+                        else
+                            buffer.append("[\n");
+                    }
+                    else
+                    {
+                        if constexpr(STYLE.bParenthesesOnNewLine)
+                        {
+                            buffer.push_back('\n');
+                            addTab(depth - 1);
+                            buffer.append("{\n");
+                        }
+                        else
+                            buffer.append("{\n");
+                    }
+
+                    ++it;
+                    while(it != order.end())
+                    {
+                        const size_t index = *it;
+                        if(entries[index].depth < depth)
+                            break;
+
+                        addTab(depth);
+
+                        if(!entries[index].IsContainer())
+                        {
+                            if constexpr(bIsArray)
+                                writeSimpleEntryValue(entries[index]);
+                            else
+                                writeSimpleEntry(entries[index]);
+
+                            ++it;
+                        }
+                        else if(entries[index].type == Type::Array)
+                        {
+                            if(isShortArray(entries[index]))
+                            {
+                                if constexpr(!bIsArray)
+                                {
+                                    writeEntryName(entries[index]);
+                                    if constexpr(STYLE.bUseEqualSignForSingleLineArraysAndMaps)
+                                        addEqualSign();
+                                }
+                                writeSingleLine.template operator()<true>(depth + 1);
+                            }
+                            else
+                            {
+                                buffer.push_back('\n');
+                                if constexpr(!bIsArray)
+                                    writeEntryName(entries[index]);
+                                self.template operator()<true>(depth + 1);
+                            }
+                        }
+                        else if(entries[index].type == Type::Map)
+                        {
+                            if(isShortMap(entries[index]))
+                            {
+                                if constexpr(!bIsArray)
+                                {
+                                    writeEntryName(entries[index]);
+                                    if constexpr(STYLE.bUseEqualSignForSingleLineArraysAndMaps)
+                                        addEqualSign();
+                                }
+                                writeSingleLine.template operator()<false>(depth + 1);
+                            }
+                            else
+                            {
+                                buffer.push_back('\n');
+                                if constexpr(!bIsArray)
+                                    writeEntryName(entries[index]);
+                                self.template operator()<false>(depth + 1);
+                            }
+                        }
+                        else
+                            std::unreachable();
+
+                        if constexpr((bIsArray && STYLE.bCommasOnArrays) || (!bIsArray && STYLE.bCommasOnMaps))
+                            buffer.append(",\n");
+                        else
+                            buffer.push_back('\n');
+                    }
+
+                    if constexpr(!STYLE.bCommasOnLastElement)
+                        buffer.erase(buffer.size() - 2, 1);
+
+                    addTab(depth - 1);
+                    if constexpr(bIsArray)
+                        buffer.append("]\n");
+                    else
+                        buffer.append("}\n");
+                };
+
+
+
+
+                while(it != order.end())
+                {
+                    const size_t index = *it;
+
+                    if(!entries[index].IsContainer())
+                    {
+                        writeSimpleEntry(entries[index]);
+                        ++it;
+                    }
+                    else if(entries[index].type == Type::Array)
+                    {
+                        if(isShortArray(entries[index]))
+                        {
+                            writeEntryName(entries[index]);
+                            if constexpr(STYLE.bUseEqualSignForSingleLineArraysAndMaps)
+                                addEqualSign();
+
+                            writeSingleLine.template operator()<true>(1);
+                        }
+                        else
+                        {
+                            buffer.push_back('\n');
+                            writeEntryName(entries[index]);
+                            writeMultiLine.template operator()<true>(1);
+                        }
+                    }
+                    else if(entries[index].type == Type::Map)
+                    {
+                        if(isShortMap(entries[index]))
+                        {
+                            writeEntryName(entries[index]);
+                            if constexpr(STYLE.bUseEqualSignForSingleLineArraysAndMaps)
+                                addEqualSign();
+                            
+                            writeSingleLine.template operator()<false>(1);
+                        }
+                        else
+                        {
+                            buffer.push_back('\n');
+                            writeEntryName(entries[index]);
+                            writeMultiLine.template operator()<false>(1);
+                        }
+                    }
+                    else
+                        std::unreachable();
+
+                    buffer.push_back('\n');
+                }
+
+                const size_t lastNonNewLine = buffer.find_last_not_of('\n');
+                if(lastNonNewLine != std::string::npos)
+                {
+                    if constexpr(STYLE.bEmptyLineAtEOF)
+                        buffer.erase(lastNonNewLine + 2);
+                    else
+                        buffer.erase(lastNonNewLine + 1);
+                }
+            };
+
+
+
+
+            if constexpr(STYLE.bGroupSimilarTypes)
+            {
+                std::vector<size_t> sortVec;
+                sortVec.reserve(entries.size());
+
+                // Every pass steps from sibling to sibling, subtrees are only entered by the recursion
+                auto sortFn = [&entries, &sortVec](this auto self, std::span<const Entry> children) -> void
+                {
+                    const SiblingView<const Entry> siblings(children);
+                    for(const Entry& entry : siblings)
+                    {
+                        if(!entry.IsContainer())
+                            sortVec.push_back(&entry - entries.data());
+                    }
+
+                    for(const Entry& entry : siblings)
+                    {
+                        if(entry.type == Type::Array)
+                        {
+                            sortVec.push_back(&entry - entries.data());
+                            self(std::span(&entry + 1, entry.GetChildCount()));
+                        }
+                    }
+
+                    for(const Entry& entry : siblings)
+                    {
+                        if(entry.type == Type::Map)
+                        {
+                            sortVec.push_back(&entry - entries.data());
+                            self(std::span(&entry + 1, entry.GetChildCount()));
+                        }
+                    }
+                };
+                sortFn(std::span(entries.data(), entries.size()));
+                writeLambda(sortVec);
+            }
+            else
+            {
+                writeLambda(std::views::iota(static_cast<size_t>(0), entries.size()));
+            }
+        }
+    };
+}
+
+
+
+
+FDF_EXPORT namespace fdf
+{
+    constexpr void Entry::Resolve() const noexcept
+    {
+        if(!bLazyValue) [[likely]]
+            return;
+
+        // Lazy entries are only created by the parser inside non-const storage, so decoding them through a const access is fine
+        Entry& self = const_cast<Entry&>(*this);
+
+        const std::string_view view = data.strDynamic.view;
+        detail::Token token(static_cast<detail::TokenType>(size & 0xFF), 0, view.size());
+        token.extra8 = static_cast<uint8_t>(size >> 8);
+
+        self.bLazyValue = false;
+        self.bBorrowedData = false;
+        self.data.strDynamic = {};
+        self.size = 0;
+
+        // The source is alive as long as the entry, so strings without escapes can keep referencing it
+        // Only copying escaped strings allocates, running out of memory there leaves the value invalid
+        try
+        {
+            if(!detail::Utils<detail::DefaultErrorCallback, ParseOptions{.bBorrowSource = true}>::DecodeValue(view, token, self))
+                self.type = Type::Invalid;
+        }
+        catch(...)
+        {
+            self.type = Type::Invalid;
+        }
+    }
+}
+
+
+
+
+namespace fdf::detail
+{
+    // Sink for the grammar in Utils that reports each parsed element to the handler instead of building entries (see "fdf::ParseEvents")
+    // Nothing is stored per element, strings are reported as views into the source and only numbers and keywords are decoded to be validated
+    template<auto ERROR_CALLBACK, typename HANDLER>
+    struct EventSink
+    {
+        using Utils = detail::Utils<ERROR_CALLBACK, ParseOptions{.bBorrowSource = true}>;
+
+        HANDLER& handler;
+
+        // Handler functions may return void or bool, returning false stops the parsing
+        template<typename FUNCTION>
+        [[nodiscard]] constexpr static bool Invoke(FUNCTION&& function)
+        {
+            if constexpr(std::is_same_v<std::invoke_result_t<FUNCTION>, bool>)
+                return function();
+            else
+            {
+                function();
+                return true;
+            }
+        }
+
+        constexpr void MarkEntryStart(size_t) const noexcept
+        {
+        }
+
+        [[nodiscard]] constexpr bool BeginEntry(size_t, bool bArrayElement, std::string_view identifier, size_t&)
+        {
+            if constexpr(requires { handler.OnKey(identifier); })
+                if(!bArrayElement)
+                    return Invoke([&]() { return handler.OnKey(identifier); });
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool EndEntry(size_t) const noexcept
+        {
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool SetValue(size_t, std::string_view view, Token token)
+        {
+            if constexpr(requires(const Entry& value) { handler.OnValue(value); })
+            {
+                Entry value;  // Borrows the source, so it is only valid until the handler returns
+                return Utils::DecodeValue(view, token, value) && Invoke([&]() { return handler.OnValue(std::as_const(value)); });
+            }
+            else
+            {
+                Type type;
+                switch(token.type)
+                {
+                    case TokenType::StringLiteral:    type = Type::String;    view = view.substr(1, view.size() - 2); break;
+                    case TokenType::EvaluateLiteral:  type = Type::String;    view = EVALUATE_LITERAL_TEXT;           break;
+                    case TokenType::HexLiteral:       type = Type::Hex;       break;
+                    case TokenType::TimestampLiteral: type = Type::Timestamp; break;
+                    default:
+                    {
+                        // Numbers, versions and keywords, none of them allocates
+                        Entry value;
+                        if(!Utils::DecodeValue(view, token, value))
+                            return false;
+                        type = value.GetType();
+                        break;
+                    }
+                }
+
+                if constexpr(requires { handler.OnValue(type, view); })
+                    return Invoke([&]() { return handler.OnValue(type, view); });
+                return true;
+            }
+        }
+
+        [[nodiscard]] constexpr bool BeginContainer(size_t, bool bIsArray)
+        {
+            if constexpr(requires { handler.OnBeginArray(); })
+                if(bIsArray)
+                    return Invoke([&]() { return handler.OnBeginArray(); });
+            if constexpr(requires { handler.OnBeginMap(); })
+                if(!bIsArray)
+                    return Invoke([&]() { return handler.OnBeginMap(); });
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool EndContainer(size_t, bool bIsArray)
+        {
+            if constexpr(requires { handler.OnEndArray(); })
+                if(bIsArray)
+                    return Invoke([&]() { return handler.OnEndArray(); });
+            if constexpr(requires { handler.OnEndMap(); })
+                if(!bIsArray)
+                    return Invoke([&]() { return handler.OnEndMap(); });
+            return true;
+        }
+
+    #if !FDF_NO_COMMENTS
+        [[nodiscard]] constexpr bool AddComment(size_t, std::string_view comment)
+        {
+            if constexpr(requires { handler.OnComment(comment); })
+                return Invoke([&]() { return handler.OnComment(comment); });
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool AddFileComment(std::string_view comment)
+        {
+            if constexpr(requires { handler.OnComment(comment); })
+            {
+                std::string fileComment;
+                TrimWhitespaceMultilineInPlace(comment, fileComment);
+                return Invoke([&]() { return handler.OnComment(std::string_view(fileComment)); });
+            }
+            return true;
+        }
+    #endif
+    };
+}
+
+
+
+
+FDF_EXPORT namespace fdf
+{
+    // Parses "content" without building any entries, "handler" is notified about each element in document order instead
+    // The handler can implement any of these, missing ones are skipped at compile time (returning false from any of them stops the parsing):
+    //     OnKey(std::string_view identifier)         -> Map child or top level entry, followed by its value or container
+    //     OnValue(fdf::Type type, std::string_view)  -> View into "content", strings are given without quotes and their escape sequences are not decoded
+    //     OnValue(const fdf::Entry& value)           -> Decoded value instead of its text, only valid until the handler returns
+    //     OnBeginMap(), OnEndMap()
+    //     OnBeginArray(), OnEndArray()
+    //     OnComment(std::string_view comment)        -> Comment of the value or container that just ended, file comment if it comes before any key
+    template<auto ERROR_CALLBACK = detail::DefaultErrorCallback, typename HANDLER> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
+    [[nodiscard]] constexpr bool ParseEvents(std::string_view content, HANDLER& handler)
+    {
+        detail::EventSink<ERROR_CALLBACK, HANDLER> sink = { .handler = handler };
+        detail::Tokenizer tokenizer = content;
+        size_t topLevelEntryCount = 0;
+    #if !FDF_NO_COMMENTS
+        std::string fileComment;
+        return detail::Utils<ERROR_CALLBACK>::ParseEntries(content, tokenizer, sink, fileComment, true, topLevelEntryCount);
+    #else
+        return detail::Utils<ERROR_CALLBACK>::ParseEntries(content, tokenizer, sink, topLevelEntryCount);
+    #endif
+    }
+}
+
+
+
+
+FDF_EXPORT namespace fdf
+{
+    // Template argument that holds a string, "StaticDocument<"a = 1">", "IO::Get<"a.b">" or a character array filled with #embed
+    template<size_t N>
+    struct FixedString
+    {
+        consteval FixedString(const char (&text)[N]) noexcept  { std::copy_n(text, N, data); }
+
+        [[nodiscard]] constexpr std::string_view View() const noexcept  { return std::string_view(data, N > 0 && data[N - 1] == '\0'? N - 1 : N); }
+
+        char data[N] = {};
+    };
+
+
+    // Dotted path that is split and hashed once, so resolving it costs one index probe per segment instead of splitting and hashing the text again
+    // Numeric segments ("projects.1.name") are array positions if their parent is an array, identifiers otherwise
+    class Path
+    {
+        template<auto ERROR_CALLBACK> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
+        friend class IO;
+        friend class FrozenDocument;
+
+    public:
+        constexpr Path() noexcept = default;
+        constexpr explicit Path(std::string_view path) : text(path), segments(detail::CountPathSegments(path))
+        {
+            detail::SplitPath(text, segments);
+        }
+
+    public:
+        [[nodiscard]] constexpr std::string_view GetText()         const noexcept  { return text; }
+        [[nodiscard]] constexpr size_t           GetSegmentCount() const noexcept  { return segments.size(); }
+
+    private:
+        std::string text;
+        std::vector<detail::PathSegment> segments;
+    };
+}
+
+
+
+
+namespace fdf::detail
+{
+    template<FixedString PATH>
+    [[nodiscard]] consteval auto BuildPathSegments() noexcept
+    {
+        std::array<PathSegment, CountPathSegments(PATH.View())> segments = {};
+        SplitPath(PATH.View(), segments);
+        return segments;
+    }
+
+    // Segments of a literal path, hashed at compile time
+    template<FixedString PATH>
+    inline constexpr auto PATH_SEGMENTS = BuildPathSegments<PATH>();
+}
+
+
+
+
+FDF_EXPORT namespace fdf
+{
+    enum class ChangeType : uint8_t
+    {
+        Added,
+        Removed,
+        Changed
+    };
+
+    // Changes that turn one document into another, made by "IO::Diff" and applied with "IO::Apply"
+    // Added and changed entries are stored with their whole subtree, so the patch doesn't depend on the documents it was made from
+    class Patch
+    {
+        template<auto ERROR_CALLBACK> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
+        friend class IO;
+
+    public:
+        struct Change
+        {
+            ChangeType type = ChangeType::Changed;
+            std::string identifier;  // Full identifier of the entry
+            size_t entryIndex = static_cast<size_t>(-1);  // First entry of the new subtree, -1 for removed entries
+        };
+
+    public:
+        [[nodiscard]] constexpr std::span<const Change> GetChanges() const noexcept  { return changes; }
+        [[nodiscard]] constexpr bool IsEmpty() const noexcept  { return changes.empty(); }
+
+        // New value of an added or changed entry, nullptr for removed ones. Children of containers follow it in pre-order
+        [[nodiscard]] constexpr const Entry* GetEntry(const Change& change) const noexcept
+        {
+            return change.entryIndex != -1? &entries[change.entryIndex] : nullptr;
+        }
+
+    private:
+        std::vector<Change> changes;
+        detail::EntryVector entries;  // Top level entry of each subtree has depth 0, no parent and no array index
+        detail::EntryIndex identifiers;  // Only used to intern the identifiers of "entries"
+        std::vector<std::shared_ptr<const void>> pinnedSources;  // Copied entries may borrow from them
+    };
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+FDF_EXPORT namespace fdf
+{
+    template<auto ERROR_CALLBACK> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
+    class IO
+    {
+        friend struct detail::Test;
+        friend class StreamParser<ERROR_CALLBACK>;
+
+    public:
+        constexpr IO() noexcept = default;
+        // Every entry, identifier, comment and string is allocated from "resource", it has to outlive the IO
+        constexpr explicit IO(std::pmr::memory_resource* resource) noexcept : entries(detail::Allocator<Entry>(resource)), identifierIndex(resource)  { }
+
+        // Copies use new/delete and intern their identifiers again, neither the arena nor the identifier pool of "other" is thread safe to share
+        inline IO(const IO& other)
+            : entries(other.entries), topLevelEntryCount(other.topLevelEntryCount), pinnedSources(other.pinnedSources), entryPositions(other.entryPositions), sourceSize(other.sourceSize)
+        #if !FDF_NO_COMMENTS
+            , fileComment(other.fileComment)
+        #endif
+        {
+            (void)IndexNewEntries(0);  // Identifiers of "other" are already unique
+        }
+        IO(IO&&) noexcept = default;
+
+        inline IO& operator=(const IO& other)
+        {
+            if(this != &other)
+                *this = IO(other);
+            return *this;
+        }
+        // Entries and the identifier pool are released before the arena they were allocated from
+        inline IO& operator=(IO&& other) noexcept
+        {
+            entries = std::move(other.entries);
+            identifierIndex = std::move(other.identifierIndex);
+            childTable.Reset();
+            arena = std::move(other.arena);
+            bPoolArena = other.bPoolArena;
+            topLevelEntryCount = other.topLevelEntryCount;
+            pinnedSources = std::move(other.pinnedSources);
+            entryPositions = std::move(other.entryPositions);
+            sourceSize = other.sourceSize;
+        #if !FDF_NO_COMMENTS
+            fileComment = std::move(other.fileComment);
+        #endif
+            return *this;
+        }
+
+        // The IO owns a monotonic arena, destroying the document releases it at once instead of freeing each allocation
+        // Memory freed by changes (Apply, Combine, SetIdentifier, an incremental Reparse, ...) is only reclaimed with the whole arena,
+        // a "Reparse" from scratch moves the document into a new one. Documents that keep changing should use "WithPool" instead
+        [[nodiscard]] static IO WithArena(size_t initialSize = detail::DEFAULT_ARENA_SIZE)
+        {
+            IO io;
+            io.UseArena(std::make_shared<std::pmr::monotonic_buffer_resource>(initialSize), false);
+            return io;
+        }
+        // Owned arena like "WithArena", but freed memory is reused by later allocations
+        [[nodiscard]] static IO WithPool()
+        {
+            IO io;
+            io.UseArena(std::make_shared<std::pmr::unsynchronized_pool_resource>(), true);
+            return io;
+        }
+
+        [[nodiscard]] constexpr std::pmr::memory_resource* GetMemoryResource() const noexcept  { return entries.get_allocator().resource; }
+
+    public:
+        // With "ParseOptions::bBorrowSource" or "ParseOptions::bLazyValues" the caller has to keep "content" alive as long as the entries, prefer "ParseOwned" if that's not possible
+        // Such documents don't record where their entries start, so "Reparse" parses them from scratch instead of keeping entries that view the previous content
+        template<ParseOptions OPTIONS = {}>
+        [[nodiscard]] constexpr bool Parse(std::string_view content, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty) noexcept
+        {
+            IO other(GetMemoryResource());
+            std::vector<detail::EntryPosition>* const positions = OPTIONS.ReferencesSource()? nullptr : &other.entryPositions;
+        #if !FDF_NO_COMMENTS
+            if(!detail::Utils<ERROR_CALLBACK, OPTIONS>::ParseFileContent(content, other.entries, other.identifierIndex, other.fileComment, other.topLevelEntryCount, positions))
+                return false;
+        #else
+            if(!detail::Utils<ERROR_CALLBACK, OPTIONS>::ParseFileContent(content, other.entries, other.identifierIndex, other.topLevelEntryCount, positions))
+                return false;
+        #endif
+            other.sourceSize = content.size();
+
+            return Combine(std::move(other), fileCommentCombineStrategy);
+        }
+        // Takes the ownership of "content" and keeps it alive inside the IO, so borrowed entries can reference it
+        template<ParseOptions OPTIONS = ParseOptions{.bBorrowSource = true}>
+        [[nodiscard]] inline bool ParseOwned(std::string content, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty) noexcept
+        {
+            auto source = std::make_shared<const std::string>(std::move(content));
+            if(!Parse<OPTIONS>(std::string_view(*source), fileCommentCombineStrategy))
+                return false;
+
+            if constexpr(OPTIONS.ReferencesSource())
+                pinnedSources.push_back(std::move(source));
+            return true;
+        }
+        // On Linux the file is mapped and parsed in place, "bKeepFileMapped" keeps the mapping alive until "ReleasePinnedSources" so views into it stay valid
+        // With "ParseOptions::bBorrowSource" or "ParseOptions::bLazyValues" the file content is always kept alive
+        // While the mapping is kept, truncating the file kills the process with SIGBUS once a view into the lost part is read. Use "ParseOwned" for files others may write to
+        template<ParseOptions OPTIONS = {}>
+        [[nodiscard]] inline bool Parse(std::filesystem::path filepath, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty, bool bKeepFileMapped = false) noexcept
+        {
+        #if FDF_MMAP
+            auto file = std::make_shared<detail::MappedFile>();
+            if(!file->Open(filepath))
+                return false;
+
+            if(!Parse<OPTIONS>(file->View(), fileCommentCombineStrategy))
+                return false;
+
+            if(bKeepFileMapped || OPTIONS.ReferencesSource())
+                pinnedSources.push_back(std::move(file));
+            return true;
+        #else
+            if(!std::filesystem::exists(filepath) || !std::filesystem::is_regular_file(filepath))
+                return false;
+
+            std::ifstream file(filepath);
+            if(!file)
+                return false;
+
+            if constexpr(OPTIONS.ReferencesSource())
+                return ParseOwned<OPTIONS>(std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()), fileCommentCombineStrategy);
+            else
+                return Parse(file, fileCommentCombineStrategy);
+        #endif
+        }
+        // Loads the image "cache" has for the file instead of parsing it, on a miss the file is parsed and its image is stored for the next time
+        // Unchanged files cost a single stat, changed or unknown ones are hashed since the same contents may already be cached under another name
+        template<ParseOptions OPTIONS = {}>
+        [[nodiscard]] inline bool Parse(std::filesystem::path filepath, ParseCache& cache, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty) noexcept
+        {
+            constexpr uint64_t FLAVOR = detail::HashInteger(!FDF_NO_COMMENTS && !OPTIONS.bSkipComments, detail::HashInteger(detail::BINARY_VERSION));
+
+            std::optional<ParseCache::Stamp> stamp = ParseCache::Stat(filepath);
+            if(!stamp)
+                return false;
+
+            const uint64_t pathKey = ParseCache::GetPathKey(filepath, FLAVOR);
+            if(const std::optional<uint64_t> contentKey = cache.FindContentKey(pathKey, *stamp); contentKey && LoadBinary(cache.GetImagePath(*contentKey), fileCommentCombineStrategy))
+            {
+                cache.Touch(*contentKey);
+                return true;
+            }
+
+        #if FDF_MMAP
+            auto source = std::make_shared<detail::MappedFile>();
+            if(!source->Open(filepath))
+                return false;
+            const std::string_view content = source->View();
+        #else
+            std::ifstream file(filepath, std::ios::binary);
+            if(!file)
+                return false;
+            auto source = std::make_shared<const std::string>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            const std::string_view content = *source;
+        #endif
+
+            stamp->contentKey = detail::HashInteger(detail::Checksum(content), FLAVOR);
+            if(LoadBinary(cache.GetImagePath(stamp->contentKey), fileCommentCombineStrategy))
+            {
+                cache.Touch(stamp->contentKey);
+                cache.Remember(pathKey, *stamp);
+                return true;
+            }
+
+            IO other(GetMemoryResource());
+            if(!other.Parse<OPTIONS>(content))
+                return false;
+            if constexpr(OPTIONS.ReferencesSource())
+                other.pinnedSources.push_back(std::move(source));
+
+            std::string image;
+            other.WriteBinary(image);
+            cache.StoreImage(stamp->contentKey, image);
+            cache.Remember(pathKey, *stamp);
+
+            return Combine(std::move(other), fileCommentCombineStrategy);
+        }
+        // Splits "content" between top level entries and parses the parts on "threadCount" threads (0 for one per hardware thread)
+        // The parts are merged in order, so the result is the same as "Parse". Calls to ERROR_CALLBACK are serialized, but their order isn't deterministic
+        template<ParseOptions OPTIONS = {}>
+        [[nodiscard]] inline bool ParseParallel(std::string_view content, size_t threadCount = 0, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty) noexcept
+        {
+            if(threadCount == 0)
+                threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+            threadCount = std::min(threadCount, content.size() / detail::PARALLEL_PARSE_MIN_RANGE_SIZE);
+
+            struct Range
+            {
+                std::string_view content;
+                size_t firstLine = 1;
+                detail::EntryVector entries;  // Arenas aren't thread safe, so the entries are moved into the memory resource of the IO while merging
+                detail::EntryIndex identifierIndex;
+                size_t topLevelEntryCount = 0;
+                std::string fileComment;
+                bool bResult = false;
+            };
+
+            std::vector<Range> ranges;
+            detail::TopLevelScanner scanner;
+            size_t rangeStart = 0;
+            size_t line = 1;
+            for(size_t i = 1; i < threadCount; i++)
+            {
+                const size_t boundary = scanner.Scan(content.substr(0, content.size() / threadCount * i));
+                if(boundary == std::string_view::npos || boundary <= rangeStart)
+                    continue;  // A single top level entry spans the whole part
+
+                ranges.push_back({ .content = content.substr(rangeStart, boundary - rangeStart), .firstLine = line });
+                line += std::ranges::count(ranges.back().content, '\n');
+                rangeStart = boundary;
+            }
+            ranges.push_back({ .content = content.substr(rangeStart), .firstLine = line });
+
+            if(ranges.size() == 1)
+                return Parse<OPTIONS>(content, fileCommentCombineStrategy);
+
+            auto parseRange = [&ranges](size_t id) noexcept
+            {
+                using Utils = detail::Utils<detail::SerializedErrorCallback<ERROR_CALLBACK>, OPTIONS>;
+                Range& range = ranges[id];
+            #if !FDF_NO_COMMENTS
+                range.bResult = Utils::ParseRange(range.content, range.firstLine, range.entries, range.identifierIndex, range.fileComment, id == 0, range.topLevelEntryCount);
+            #else
+                range.bResult = Utils::ParseRange(range.content, range.firstLine, range.entries, range.identifierIndex, range.topLevelEntryCount);
+            #endif
+            };
+
+            {
+                std::vector<std::jthread> workers;
+                workers.reserve(ranges.size() - 1);
+                for(size_t i = 1; i < ranges.size(); i++)
+                    workers.emplace_back(parseRange, i);
+                parseRange(0);
+            }
+
+            IO other(GetMemoryResource());
+            size_t entryCount = 0;
+            for(const Range& range : ranges)
+            {
+                if(!range.bResult)
+                    return false;
+                entryCount += range.entries.size();
+            }
+
+            other.entries.reserve(entryCount);
+            for(Range& range : ranges)
+            {
+                const size_t firstNewEntry = other.entries.size();
+                other.entries.insert(other.entries.end(), std::make_move_iterator(range.entries.begin()), std::make_move_iterator(range.entries.end()));
+                other.topLevelEntryCount += range.topLevelEntryCount;
+                if(!other.IndexNewEntries(firstNewEntry))
+                    return false;  // Same top level identifier in two ranges, "Parse" rejects it too
+
+                range.entries = detail::EntryVector();  // Releases the memory while the rest is merged
+            }
+        #if !FDF_NO_COMMENTS
+            other.fileComment = std::move(ranges.front().fileComment);
+        #endif
+
+            return Combine(std::move(other), fileCommentCombineStrategy);
+        }
+        // Reads the stream in chunks, memory used for the input is bounded by the largest top level entry instead of the stream size
+        [[nodiscard]] inline bool Parse(std::istream& stream, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty) noexcept
+        {
+            StreamParser<ERROR_CALLBACK> parser(*this, fileCommentCombineStrategy);
+            std::string chunk(detail::STREAM_CHUNK_SIZE, '\0');
+            while(stream)
+            {
+                stream.read(chunk.data(), chunk.size());
+                if(!parser.Feed(std::span<const char>(chunk.data(), stream.gcount())))
+                    return false;
+            }
+
+            return !stream.bad() && parser.Finish();
+        }
+        // Fails if a top level entry of "other" has the same identifier as one of this IO, nothing is changed in that case
+        template<auto OTHER_ERROR_CALLBACK>
+        [[nodiscard]] constexpr bool Combine(const IO<OTHER_ERROR_CALLBACK>& other, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty) noexcept
+        {
+            const size_t firstNewEntry = entries.size();
+            entries.insert(entries.end(), other.entries.begin(), other.entries.end());
+            if(!IndexNewEntries(firstNewEntry))
+            {
+                RemoveNewEntries(firstNewEntry);
+                return false;
+            }
+
+        #if !FDF_NO_COMMENTS
+            CombineFileComment(other.fileComment, fileCommentCombineStrategy);
+        #endif
+            childTable.Reset();
+            topLevelEntryCount += other.topLevelEntryCount;
+            ForgetSource();
+            pinnedSources.insert(pinnedSources.end(), other.pinnedSources.begin(), other.pinnedSources.end());  // Copied entries may borrow from them
+            return true;
+        }
+        // Moves the entries instead of copying them, if this IO is empty the parsed entries and their index are taken over as they are
+        // On a collision "other" is left without its entries and this IO is unchanged
+        [[nodiscard]] constexpr bool Combine(IO&& other, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty) noexcept
+        {
+            if(entries.empty() && entries.get_allocator() == other.entries.get_allocator())
+            {
+                entries = std::move(other.entries);
+                identifierIndex = std::move(other.identifierIndex);
+                entryPositions = std::move(other.entryPositions);
+                sourceSize = other.sourceSize;
+            }
+            else
+            {
+                const size_t firstNewEntry = entries.size();
+                entries.insert(entries.end(), std::make_move_iterator(other.entries.begin()), std::make_move_iterator(other.entries.end()));
+                if(!IndexNewEntries(firstNewEntry))
+                {
+                    RemoveNewEntries(firstNewEntry);
+                    return false;
+                }
+                ForgetSource();
+            }
+
+        #if !FDF_NO_COMMENTS
+            CombineFileComment(other.fileComment, fileCommentCombineStrategy);
+        #endif
+            topLevelEntryCount += other.topLevelEntryCount;
+            pinnedSources.insert(pinnedSources.end(), other.pinnedSources.begin(), other.pinnedSources.end());
+            childTable.Reset();
+            return true;
+        }
+
+        // Updates a document parsed with "Parse(content)" after "edits" (sorted, not overlapping, offsets into the previous content) turned it into "newContent"
+        // Only the entries the edits touch are parsed again: the top level entries around them, or the children of the innermost map that holds all of them
+        // Entries after them are shifted and the ancestors of the parsed ones are updated, the index only changes where entries were replaced
+        // The result is always the same as parsing "newContent" from scratch, which is what happens if the edited part can't be parsed on its own
+        // Documents that don't know where their entries start (combined, parsed from a stream, borrowing their content, ...) are parsed from scratch as well
+        template<ParseOptions OPTIONS = {}> requires(!OPTIONS.ReferencesSource())  // Untouched entries would keep referencing the previous content
+        [[nodiscard]] constexpr bool Reparse(std::string_view newContent, std::span<const TextEdit> edits) noexcept
+        {
+            auto parseFromScratch = [this, newContent]() -> bool
+            {
+                // An owned arena is replaced as well, so the memory of the previous entries is released instead of piling up
+                IO other = arena == nullptr? IO(GetMemoryResource()) : bPoolArena? WithPool() : WithArena();
+                if(!other.Parse<OPTIONS>(newContent))
+                    return false;
+
+                other.pinnedSources = std::move(pinnedSources);  // Views handed out before might still point into them
+                *this = std::move(other);
+                return true;
+            };
+
+            size_t previousEnd = 0;
+            size_t expectedSize = sourceSize;
+            for(const TextEdit& edit : edits)
+            {
+                if(edit.offset < previousEnd || edit.offset > sourceSize || edit.removedSize > sourceSize - edit.offset)
+                    return parseFromScratch();
+                previousEnd = edit.offset + edit.removedSize;
+                expectedSize += edit.insertedText.size() - edit.removedSize;
+            }
+            if(edits.empty() || entryPositions.empty() || expectedSize != newContent.size())
+                return parseFromScratch();
+
+            auto findPosition = [this](size_t entryIndex) -> size_t
+            {
+                return std::ranges::lower_bound(entryPositions, entryIndex, {}, &detail::EntryPosition::entryIndex) - entryPositions.begin();
+            };
+            auto getNextSibling = [this](size_t entryIndex) -> size_t  { return entryIndex + 1 + entries[entryIndex].GetChildCount(); };
+            // Position of the child of "parent" (-1 for top level entries) that holds "offset", -1 if "offset" is in front of its first child
+            auto findChild = [&](size_t parent, size_t offset) -> size_t
+            {
+                const size_t position = std::ranges::upper_bound(entryPositions, offset, {}, &detail::EntryPosition::sourceOffset) - entryPositions.begin();
+                if(position == 0)
+                    return parent == -1? 0 : static_cast<size_t>(-1);
+
+                size_t entryIndex = entryPositions[position - 1].entryIndex;
+                if(parent != -1 && entryIndex <= parent)
+                    return -1;
+                while(detail::EntryIndex::GetParentIndex(entries, entryIndex) != parent)
+                    entryIndex = detail::EntryIndex::GetParentIndex(entries, entryIndex);
+                return findPosition(entryIndex);
+            };
+            // Children of a map can only be parsed on their own if another child follows them, where the map is closed isn't known
+            auto hasNextSibling = [&](size_t parent, size_t position) -> bool
+            {
+                return parent == -1 || getNextSibling(entryPositions[position].entryIndex) < getNextSibling(parent);
+            };
+
+            // Children of "parent" at "first" to "last" (positions) are parsed again, neighbours of the edits too since an edit right at the end of an entry can change its last token
+            // Levels are tried from the innermost one, a level is left if the entries after its last child would have to be parsed too
+            struct Level
+            {
+                size_t parent;
+                size_t first;
+                size_t last;
+            };
+            const size_t low = edits.front().offset > 0? edits.front().offset - 1 : 0;
+            const size_t high = edits.back().offset + edits.back().removedSize;
+            std::vector<Level> levels = { { static_cast<size_t>(-1), findChild(-1, low), findChild(-1, high) } };
+            while(levels.back().first == levels.back().last && entries[entryPositions[levels.back().first].entryIndex].type == Type::Map)
+            {
+                const size_t map = entryPositions[levels.back().first].entryIndex;
+                const size_t first = findChild(map, low);
+                const size_t last = findChild(map, high);
+                if(first == -1 || last == -1 || !hasNextSibling(map, last))
+                    break;
+                levels.push_back({ map, first, last });
+            }
+
+            using Utils = detail::Utils<detail::DefaultErrorCallback, OPTIONS>;
+            const size_t sizeDelta = newContent.size() - sourceSize;
+            detail::EntryVector newEntries = detail::EntryVector(detail::Allocator<Entry>(GetMemoryResource()));
+            detail::EntryIndex newIndex;
+            std::vector<detail::EntryPosition> newPositions;
+            size_t newTopLevelEntryCount = 0;
+        #if !FDF_NO_COMMENTS
+            std::string newFileComment;
+        #endif
+            size_t nextEntry = 0;
+            size_t end = 0;
+            while(true)
+            {
+                const auto [parent, first, last] = levels.back();
+                nextEntry = getNextSibling(entryPositions[last].entryIndex);
+                const bool bFinal = parent == -1 && nextEntry == entries.size();
+                const size_t start = entryPositions[first].sourceOffset;
+                end = (bFinal? sourceSize : entryPositions[findPosition(nextEntry)].sourceOffset) + sizeDelta;
+
+                // Parsed on its own, errors are only reported by "parseFromScratch" so they aren't reported twice
+                newEntries.clear();
+                newIndex = detail::EntryIndex(GetMemoryResource());
+                newPositions.clear();
+                newTopLevelEntryCount = 0;
+                size_t trailingOffset = end;
+                bool bParsed = false;
+                if(parent != -1)
+                    bParsed = Utils::ParseMapChildren(newContent.substr(0, end), entries[parent].depth, newEntries, newIndex, newPositions, start, trailingOffset);
+                else
+                {
+                #if !FDF_NO_COMMENTS
+                    newFileComment.clear();
+                    bParsed = Utils::ParseRange(newContent.substr(0, end), 1, newEntries, newIndex, newFileComment, first == 0, newTopLevelEntryCount, &newPositions, start, &trailingOffset);
+                #else
+                    bParsed = Utils::ParseRange(newContent.substr(0, end), 1, newEntries, newIndex, newTopLevelEntryCount, &newPositions, start, &trailingOffset);
+                #endif
+                }
+                if(!bParsed)
+                    return parseFromScratch();
+                if(bFinal || trailingOffset == end)
+                    break;
+
+                // New lines or comments after the last entry belong to the entry that follows it
+                const size_t next = findPosition(nextEntry);
+                if(hasNextSibling(parent, next))
+                    levels.back().last = next;
+                else
+                    levels.pop_back();
+            }
+
+            const auto [parent, first, last] = levels.back();
+            const size_t firstNewEntry = parent != -1? 1 : 0;  // Stand-in for the map in front of its children
+            const size_t newEntryCount = newEntries.size() - firstNewEntry;
+            const size_t entryBegin = entryPositions[first].entryIndex;
+            const size_t entryEnd = nextEntry;
+            const uint8_t depth = parent != -1? entries[parent].depth + 1 : 0;
+
+            // Identifiers have to stay unique among the children of "parent", only the replaced entries may have the same ones
+            for(size_t i = firstNewEntry; i < newEntries.size(); i++)
+            {
+                if(newEntries[i].depth != depth)
+                    continue;
+                const size_t existing = identifierIndex.Find(entries, parent, newEntries[i].GetIdentifier());
+                if(existing != -1 && (existing < entryBegin || existing >= entryEnd))
+                    return parseFromScratch();
+            }
+
+            size_t oldChildCount = 0;
+            for(size_t i = entryBegin; i < entryEnd; i = getNextSibling(i))
+                oldChildCount++;
+            for(size_t i = entryBegin; i < entryEnd; i++)
+                identifierIndex.Erase(entries, i);
+
+            const size_t oldEntryCount = entryEnd - entryBegin;
+            const size_t entryDelta = newEntryCount - oldEntryCount;
+            const size_t sharedCount = std::min(oldEntryCount, newEntryCount);
+            std::move(newEntries.begin() + firstNewEntry, newEntries.begin() + firstNewEntry + sharedCount, entries.begin() + entryBegin);
+            if(newEntryCount > oldEntryCount)
+                entries.insert(entries.begin() + entryEnd, std::make_move_iterator(newEntries.begin() + firstNewEntry + sharedCount), std::make_move_iterator(newEntries.end()));
+            else
+                entries.erase(entries.begin() + entryBegin + sharedCount, entries.begin() + entryEnd);
+            childTable.Reset();
+            identifierIndex.Shift(entryEnd, static_cast<ptrdiff_t>(entryDelta));
+
+            if(parent != -1)
+            {
+                // Children were parsed under the stand-in, ancestors count the entries that came and went
+                for(size_t i = entryBegin; i < entryBegin + newEntryCount; i++)
+                {
+                    if(entries[i].depth == depth)
+                        entries[i].parentOffset = static_cast<uint32_t>(i - parent);
+                }
+
+                entries[parent].size += static_cast<uint32_t>(newEntries.front().size - oldChildCount);
+                size_t topLevelEntry = parent;
+                for(size_t ancestor = parent; ancestor != -1; ancestor = detail::EntryIndex::GetParentIndex(entries, ancestor))
+                {
+                    entries[ancestor].data.u[0] += entryDelta;
+                    topLevelEntry = ancestor;
+                }
+
+                // Later children of the ancestors still point in front of the shifted entries
+                for(size_t i = entryBegin + newEntryCount; i < getNextSibling(topLevelEntry) && entryDelta != 0; i = getNextSibling(i))
+                    entries[i].parentOffset += static_cast<uint32_t>(entryDelta);
+            }
+            else
+                topLevelEntryCount = topLevelEntryCount - oldChildCount + newTopLevelEntryCount;
+
+            // New identifiers point into "newIndex", which goes away. Containers get keys of this index before their children are indexed
+            for(size_t i = entryBegin; i < entryBegin + newEntryCount; i++)
+            {
+                if(!entries[i].IsArrayElement())
+                    entries[i].identifier = identifierIndex.Intern(entries[i].GetIdentifier()).data();
+                if(entries[i].IsContainer())
+                    entries[i].data.u[1] = identifierIndex.NewContainerKey();
+                identifierIndex.Insert(entries, i);
+            }
+
+            const size_t positionEnd = findPosition(entryEnd);
+            for(size_t i = positionEnd; i < entryPositions.size() && (sizeDelta != 0 || entryDelta != 0); i++)
+            {
+                entryPositions[i].sourceOffset += sizeDelta;
+                entryPositions[i].entryIndex += entryDelta;
+            }
+            for(detail::EntryPosition& position : newPositions)
+                position.entryIndex += entryBegin - firstNewEntry;
+            if(newPositions.size() != positionEnd - first)
+            {
+                entryPositions.erase(entryPositions.begin() + first, entryPositions.begin() + positionEnd);
+                entryPositions.insert(entryPositions.begin() + first, newPositions.begin(), newPositions.end());
+            }
+            else
+                std::ranges::copy(newPositions, entryPositions.begin() + first);
+            sourceSize = newContent.size();
+        #if !FDF_NO_COMMENTS
+            if(parent == -1 && first == 0)
+                fileComment = std::move(newFileComment);
+        #endif
+            return true;
+        }
+
+        // Changes that turn this document into "target". Map children are matched by identifier and array elements by position
+        // Identical subtrees are skipped after comparing them entry by entry, so only the paths leading to changes are walked child by child
+        // Entries that change type, and containers whose comment changes, are replaced with their whole subtree. The order of map children is ignored
+        template<auto OTHER_ERROR_CALLBACK>
+        [[nodiscard]] Patch Diff(const IO<OTHER_ERROR_CALLBACK>& target) const
+        {
+            Patch patch;
+            patch.pinnedSources = target.pinnedSources;
+            std::string identifier;
+            DiffChildren(target, -1, -1, identifier, patch);
+            return patch;
+        }
+
+        // Applies the changes in order, added entries become the last children of their parent (or the array element at their index)
+        // Stops at the first change that doesn't fit this document (missing entry, already existing one, ...), changes before it stay applied
+        // Changes refer to the document before the patch (as "Diff" creates them), so all of them are looked up first and the index is rebuilt once
+        [[nodiscard]] constexpr bool Apply(const Patch& patch)
+        {
+            ForgetSource();
+            childTable.Reset();
+            pinnedSources.insert(pinnedSources.end(), patch.pinnedSources.begin(), patch.pinnedSources.end());
+
+            // Changes that move entries, positions are in the document before any of them is applied
+            struct Splice
+            {
+                size_t position;
+                size_t removedCount;
+                std::span<const Entry> subtree;
+                std::string_view segment;  // Identifier of the root of "subtree", array elements get their index from the position
+                uint8_t depth;  // Of the root of "subtree"
+                bool bArrayElement;
+            };
+            std::vector<Splice> splices;
+            auto getRootDepth = [this](size_t parentIndex) -> uint8_t  { return parentIndex != -1? entries[parentIndex].depth + 1 : 0; };
+            auto isArray = [this](size_t parentIndex)  { return parentIndex != -1 && entries[parentIndex].type == Type::Array; };
+            std::unordered_map<size_t, uint32_t> appendedElements;  // Elements added to the end of each array so far
+
+            bool bResult = true;
+            for(const Patch::Change& change : patch.changes)
+            {
+                const std::span<const Entry> subtree = change.entryIndex != -1
+                    ? std::span<const Entry>(patch.entries).subspan(change.entryIndex, 1 + patch.entries[change.entryIndex].GetChildCount())
+                    : std::span<const Entry>();
+                if(change.type == ChangeType::Added)
+                {
+                    const size_t dot = change.identifier.rfind('.');
+                    const size_t parentIndex = dot != std::string::npos? FindEntry(-1, std::string_view(change.identifier).substr(0, dot)) : static_cast<size_t>(-1);
+                    const std::string_view segment = std::string_view(change.identifier).substr(dot + 1);  // npos + 1 wraps to 0
+                    if(subtree.empty() || (dot != std::string::npos && (parentIndex == -1 || !entries[parentIndex].IsContainer())))
                     {
-                        if(result > DOUBLE_MAX_VALUE / 10)
-                            return false;  // Overflow
-    
-                        if(!bAfterDot)
-                            result *= 10;
-    
-                        const double value = static_cast<double>(c - '0') * multiplier;
-                        if(result > DOUBLE_MAX_VALUE - value)
-                            return false; // Overflow
-    
-                        result += value;
+                        bResult = false;
+                        break;
                     }
-                    else if(c == '.')
+
+                    size_t position = parentIndex != -1? parentIndex + 1 + entries[parentIndex].GetChildCount() : entries.size();
+                    uint32_t arrayIndex = 0;
+                    if(isArray(parentIndex))
                     {
-                        if(bAfterDot)
-                            return false;  // Can't contain multiple dots
-    
-                        bAfterDot = true;
+                        uint32_t& appendedCount = appendedElements[parentIndex];
+                        const auto [end, error] = std::from_chars(segment.data(), segment.data() + segment.size(), arrayIndex);
+                        if(error != std::errc() || end != segment.data() + segment.size() || arrayIndex > entries[parentIndex].size + appendedCount)
+                        {
+                            bResult = false;
+                            break;
+                        }
+                        if(arrayIndex < entries[parentIndex].size)
+                            position = identifierIndex.FindElement(entries, parentIndex, arrayIndex);
+                        else
+                            appendedCount++;
                     }
-                    else if(c == 'x')
+                    else if(identifierIndex.Find(entries, parentIndex, segment) != -1)
                     {
-                        if(currentDimension >= dimensionCount - 1)
-                            return false;  // Too much dimensions
-    
-                        entry.data.f[currentDimension] = bIsNegative? -result : result;
-    
-                        bIsFirstChar = true;
-                        bIsNegative = false;
-                        bAfterDot = false;
-    
-                        multiplier = 1.0;
-                        result = 0.0;
-                        currentDimension++;
-    
-                        continue;
+                        bResult = false;
+                        break;
                     }
-                    else
-                        return false;  // unknown character
-    
-                    bIsFirstChar = false;
-                    if(bAfterDot)
-                        multiplier *= 0.1;
+
+                    splices.push_back({ position, 0, subtree, segment, getRootDepth(parentIndex), isArray(parentIndex) });
+                    continue;
                 }
-    
-                entry.data.f[currentDimension] = bIsNegative? -result : result;
-                return postProcess();
+
+                const size_t index = FindEntry(-1, change.identifier);
+                if(index == -1 || (change.type == ChangeType::Changed && subtree.empty()))
+                {
+                    bResult = false;
+                    break;
+                }
+
+                // Values replaced by values keep their position, so they are applied right away
+                Entry& entry = entries[index];
+                if(change.type == ChangeType::Changed && subtree.size() == 1 && entry.GetChildCount() == 0)
+                {
+                    const uint8_t depth = entry.depth;
+                    const char* identifier = entry.identifier;
+                    const uint32_t parentOffset = entry.parentOffset;
+                    const uint32_t arrayIndex = entry.arrayIndex;
+                    entry = Entry(subtree.front(), GetMemoryResource());
+                    if(entry.IsContainer())
+                        entry.data.u[1] = identifierIndex.NewContainerKey();  // Empty container, the key of the patch might be taken
+                    entry.depth = depth;
+                    entry.identifier = identifier;
+                    entry.parentOffset = parentOffset;
+                    entry.arrayIndex = arrayIndex;
+                    continue;
+                }
+
+                const size_t parentIndex = detail::EntryIndex::GetParentIndex(entries, index);
+                splices.push_back({ index, 1 + entry.GetChildCount(), subtree, entry.GetIdentifier(), getRootDepth(parentIndex), isArray(parentIndex) });
             }
-    
-    
-    
-    
-            if(currentToken.type == TokenType::VersionLiteral)
+
+            // Merged into a new vector in one pass, at the same position entries added to the end of a container come before the replaced entry that follows it
+            std::ranges::stable_sort(splices, [](const Splice& lhs, const Splice& rhs)
             {
-                entry.type = Type::Version;
-                entry.data.u[3] = 0;
-    
-                uint8_t currentDimension = 0;
-                const uint8_t dimensionCount = entry.size;
-    
-                uint64_t result = 0;
-                for(size_t i = 0; i < view.size(); i++)
+                return lhs.position != rhs.position? lhs.position < rhs.position : lhs.removedCount < rhs.removedCount;
+            });
+
+            if(!splices.empty())
+            {
+                detail::EntryVector merged(entries.get_allocator());
+                merged.reserve(entries.size());
+                size_t next = 0;
+                for(const Splice& splice : splices)
                 {
-                    char c = view[i];
-                    if(std::isdigit(c))
-                    {
-                        if(result > UINT64_MAX_VALUE / 10)
-                            return false;  // Overflow
-    
-                        result *= 10;
-    
-                        const uint64_t digit = c - '0';
-                        if(result > UINT64_MAX_VALUE - digit)
-                            return false; // Overflow
-    
-                        result += digit;
-                    }
-                    else if(c == '.')
+                    merged.insert(merged.end(), std::make_move_iterator(entries.begin() + next), std::make_move_iterator(entries.begin() + splice.position));
+                    next = splice.position + splice.removedCount;
+                    if(splice.subtree.empty())
+                        continue;
+
+                    const size_t root = merged.size();
+                    for(const Entry& entry : splice.subtree)
                     {
-                        if(currentDimension >= dimensionCount - 1)
-                            return false;  // Too much dimensions
-    
-                        entry.data.u[currentDimension] = result;
-    
-                        result = 0;
-                        currentDimension++;
+                        Entry& copy = merged.emplace_back(entry, GetMemoryResource());
+                        copy.depth += splice.depth;
+                        if(copy.identifier != nullptr)
+                            copy.identifier = identifierIndex.Intern(copy.GetIdentifier()).data();
                     }
-                    else
-                        return false;  // unknown character
+
+                    merged[root].identifier = splice.bArrayElement? nullptr : identifierIndex.Intern(splice.segment).data();
+                    merged[root].identifierSize = splice.bArrayElement? 0 : static_cast<uint8_t>(splice.segment.size());
                 }
-    
-                entry.data.u[currentDimension] = result;
-                return postProcess();
+                merged.insert(merged.end(), std::make_move_iterator(entries.begin() + next), std::make_move_iterator(entries.end()));
+
+                entries = std::move(merged);
+                RecountStructure();
+                identifierIndex.Rebuild(entries);
             }
-    
-    
-    
-            
-            size_t size = 0;
-            bool bDynamic = false;
-            auto writeCharacter = [&](char c)
+            return bResult;
+        }
+
+        // Decodes every value that "ParseOptions::bLazyValues" left for later, after that the IO can be read from several threads
+        constexpr void ResolveValues() noexcept
+        {
+            for(const Entry& entry : entries)
+                entry.Resolve();
+        }
+
+    private:
+        inline void UseArena(std::shared_ptr<std::pmr::memory_resource> newArena, bool bPool)
+        {
+            arena = std::move(newArena);
+            bPoolArena = bPool;
+            entries = detail::EntryVector(detail::Allocator<Entry>(arena.get()));
+            identifierIndex = detail::EntryIndex(arena.get());
+        }
+
+        // Entries taken from another IO no longer match a single parsed content, so "Reparse" can't be used on them
+        constexpr void ForgetSource() noexcept
+        {
+            entryPositions.clear();
+            sourceSize = 0;
+        }
+
+        // Entries taken from another IO still point into its identifier pool, so their identifiers are interned again
+        // Returns false if any of them has the same identifier as an existing entry
+        constexpr bool IndexNewEntries(size_t firstNewEntry)
+        {
+            bool bUnique = true;
+            identifierIndex.Reserve(entries.size());
+            for(size_t i = firstNewEntry; i < entries.size(); i++)
+            {
+                if(!entries[i].IsArrayElement())
+                    entries[i].identifier = identifierIndex.Intern(entries[i].GetIdentifier()).data();
+                if(entries[i].IsContainer())
+                    entries[i].data.u[1] = identifierIndex.NewContainerKey();  // Might be taken already in this index
+                bUnique = identifierIndex.Insert(entries, i) == i && bUnique;
+            }
+            return bUnique;
+        }
+
+        // Rolls back the entries from "firstNewEntry" on, for example after "IndexNewEntries" found a collision
+        constexpr void RemoveNewEntries(size_t firstNewEntry) noexcept
+        {
+            for(size_t i = entries.size(); i-- > firstNewEntry;)
+                identifierIndex.Erase(entries, i);
+            entries.erase(entries.begin() + firstNewEntry, entries.end());
+        }
+
+        // Walks "path" one segment at a time, starting from the children of "parentIndex" (-1 for top level entries)
+        [[nodiscard]] constexpr size_t FindEntry(size_t parentIndex, std::string_view path) const noexcept
+        {
+            while(true)
+            {
+                const size_t dot = path.find('.');
+                const std::string_view segment = path.substr(0, dot);
+                if(parentIndex != -1 && entries[parentIndex].type == Type::Array)
+                {
+                    size_t arrayIndex = 0;
+                    const auto [end, error] = std::from_chars(segment.data(), segment.data() + segment.size(), arrayIndex);
+                    if(error != std::errc() || end != segment.data() + segment.size())
+                        return -1;
+                    parentIndex = identifierIndex.FindElement(entries, parentIndex, arrayIndex);
+                }
+                else
+                    parentIndex = identifierIndex.Find(entries, parentIndex, segment);
+
+                if(parentIndex == -1 || dot == std::string_view::npos)
+                    return parentIndex;
+                path.remove_prefix(dot + 1);
+            }
+        }
+        // Same walk with segments that are already split and hashed, "text" is the path they were split from
+        [[nodiscard]] constexpr size_t FindEntry(size_t parentIndex, std::span<const detail::PathSegment> segments, std::string_view text) const noexcept
+        {
+            if(segments.empty())
+                return -1;
+
+            for(const detail::PathSegment& segment : segments)
+            {
+                if(parentIndex != -1 && entries[parentIndex].type == Type::Array)
+                    parentIndex = segment.bArrayIndex? identifierIndex.FindElement(entries, parentIndex, segment.arrayIndex, segment.elementHash) : static_cast<size_t>(-1);
+                else
+                    parentIndex = identifierIndex.Find(entries, parentIndex, text.substr(segment.offset, segment.size), segment.hash);
+
+                if(parentIndex == -1)
+                    return -1;
+            }
+            return parentIndex;
+        }
+
+        // Subtrees are identical if their entries are, in the same order. Cheaper than matching children and doesn't touch the index
+        template<auto OTHER_ERROR_CALLBACK>
+        [[nodiscard]] constexpr bool HasSameSubtree(const IO<OTHER_ERROR_CALLBACK>& target, size_t index, size_t targetIndex) const
+        {
+            const size_t count = 1 + entries[index].GetChildCount();
+            if(count != 1 + target.entries[targetIndex].GetChildCount())
+                return false;
+
+            for(size_t i = 0; i < count; i++)
+            {
+                const Entry& entry = entries[index + i];
+                const Entry& targetEntry = target.entries[targetIndex + i];
+                if(i != 0 && (entry.parentOffset != targetEntry.parentOffset || entry.arrayIndex != targetEntry.arrayIndex || entry.GetIdentifier() != targetEntry.GetIdentifier()))
+                    return false;
+                if(!entry.HasSameValue(targetEntry))
+                    return false;
+            }
+            return true;
+        }
+
+        // Children of "parentIndex" and "targetParentIndex" (-1 for top level entries), "identifier" is the full identifier of the parents
+        template<auto OTHER_ERROR_CALLBACK>
+        void DiffChildren(const IO<OTHER_ERROR_CALLBACK>& target, size_t parentIndex, size_t targetParentIndex, std::string& identifier, Patch& patch) const
+        {
+            const size_t begin = parentIndex + 1;  // -1 wraps to 0
+            const size_t end = parentIndex != -1? begin + entries[parentIndex].GetChildCount() : entries.size();
+            const size_t targetBegin = targetParentIndex + 1;
+            const size_t targetEnd = targetParentIndex != -1? targetBegin + target.entries[targetParentIndex].GetChildCount() : target.entries.size();
+            const size_t childCount = parentIndex != -1? entries[parentIndex].size : topLevelEntryCount;
+            const size_t prefixSize = identifier.size();
+
+            auto appendSegment = [&identifier, prefixSize](const Entry& entry)
+            {
+                identifier.resize(prefixSize);
+                if(prefixSize != 0)
+                    identifier.push_back('.');
+                if(entry.IsArrayElement())
+                {
+                    char indexBuffer[std::numeric_limits<uint32_t>::digits10 + 1] = {};
+                    identifier.append(indexBuffer, std::to_chars(indexBuffer, std::end(indexBuffer), entry.arrayIndex).ptr);
+                }
+                else
+                    identifier.append(entry.GetIdentifier());
+            };
+            auto diffEntry = [&](size_t index, size_t targetIndex)
+            {
+                if(HasSameSubtree(target, index, targetIndex))
+                    return;
+
+                const Entry& entry = entries[index];
+                const Entry& targetEntry = target.entries[targetIndex];
+                bool bSameContainer = entry.IsContainer() && entry.type == targetEntry.type;
+            #if !FDF_NO_COMMENTS
+                bSameContainer = bSameContainer && entry.GetComment() == targetEntry.GetComment();
+            #endif
+                if(bSameContainer)
+                    DiffChildren(target, index, targetIndex, identifier, patch);
+                else
+                    AddToPatch(patch, ChangeType::Changed, identifier, target.entries, targetIndex);
+            };
+
+            // Documents usually keep their order, so the next unmatched child is tried before the index
+            size_t matchedCount = 0;
+            size_t next = begin;
+            const bool bArray = parentIndex != -1 && entries[parentIndex].type == Type::Array;
+            for(size_t targetIndex = targetBegin; targetIndex < targetEnd; targetIndex += 1 + target.entries[targetIndex].GetChildCount())
+            {
+                const Entry& targetEntry = target.entries[targetIndex];
+                appendSegment(targetEntry);
+
+                size_t index = -1;
+                if(bArray)
+                    index = next < end? next : static_cast<size_t>(-1);
+                else if(next < end && entries[next].GetIdentifier() == targetEntry.GetIdentifier())
+                    index = next;
+                else
+                    index = identifierIndex.Find(entries, parentIndex, targetEntry.GetIdentifier());
+
+                if(index == -1)
+                    AddToPatch(patch, ChangeType::Added, identifier, target.entries, targetIndex);
+                else
+                {
+                    diffEntry(index, targetIndex);
+                    next = index + 1 + entries[index].GetChildCount();
+                    matchedCount++;
+                }
+            }
+
+            // Array elements past the end of the target are removed from the last one, so the indices of the others stay valid
+            if(matchedCount != childCount)
+            {
+                std::vector<size_t> removed;
+                for(size_t index = begin; index < end; index += 1 + entries[index].GetChildCount())
+                {
+                    if(bArray? entries[index].arrayIndex >= matchedCount : target.identifierIndex.Find(target.entries, targetParentIndex, entries[index].GetIdentifier()) == -1)
+                        removed.push_back(index);
+                }
+                if(bArray)
+                    std::ranges::reverse(removed);
+
+                for(const size_t index : removed)
+                {
+                    appendSegment(entries[index]);
+                    patch.changes.push_back({ .type = ChangeType::Removed, .identifier = identifier });
+                }
+            }
+            identifier.resize(prefixSize);
+        }
+
+        // Copies the subtree of "source[index]" into the patch, the copy doesn't depend on the IO it came from
+        static void AddToPatch(Patch& patch, ChangeType type, const std::string& identifier, const detail::EntryVector& source, size_t index)
+        {
+            const size_t entryIndex = patch.entries.size();
+            patch.entries.insert(patch.entries.end(), source.begin() + index, source.begin() + index + 1 + source[index].GetChildCount());
+            for(size_t i = entryIndex; i < patch.entries.size(); i++)
+            {
+                Entry& entry = patch.entries[i];
+                entry.depth -= source[index].depth;
+                if(entry.identifier != nullptr)
+                    entry.identifier = patch.identifiers.Intern(entry.GetIdentifier()).data();
+            }
+
+            Entry& root = patch.entries[entryIndex];
+            root.parentOffset = 0;
+            root.arrayIndex = 0;
+            patch.changes.push_back({ .type = type, .identifier = identifier, .entryIndex = entryIndex });
+        }
+
+        // Parent offsets, child counts and array indices follow from the depths of the entries, recounted after entries were added or removed anywhere
+        constexpr void RecountStructure()
+        {
+            std::vector<size_t> openContainers;
+            auto closeContainers = [this, &openContainers](uint8_t depth, size_t end)
+            {
+                while(!openContainers.empty() && entries[openContainers.back()].depth >= depth)
+                {
+                    entries[openContainers.back()].data.u[0] = end - openContainers.back() - 1;
+                    openContainers.pop_back();
+                }
+            };
+
+            topLevelEntryCount = 0;
+            for(size_t i = 0; i < entries.size(); i++)
+            {
+                Entry& entry = entries[i];
+                closeContainers(entry.depth, i);
+                if(openContainers.empty())
+                {
+                    entry.parentOffset = 0;
+                    entry.arrayIndex = 0;
+                    topLevelEntryCount++;
+                }
+                else
+                {
+                    Entry& parent = entries[openContainers.back()];
+                    entry.parentOffset = static_cast<uint32_t>(i - openContainers.back());
+                    entry.arrayIndex = parent.type == Type::Array? parent.size : 0;
+                    parent.size++;
+                }
+
+                if(entry.IsContainer())
+                {
+                    entry.size = 0;
+                    openContainers.push_back(i);
+                }
+            }
+            closeContainers(0, entries.size());
+        }
+
+    #if !FDF_NO_COMMENTS
+        constexpr void CombineFileComment(const std::string& otherFileComment, CommentCombineStrategy fileCommentCombineStrategy)
+        {
+            switch(fileCommentCombineStrategy)
+            {
+                case CommentCombineStrategy::UseExisting: break;
+                case CommentCombineStrategy::UseNew: fileComment = otherFileComment; break;
+                case CommentCombineStrategy::UseNewIfExistingIsEmpty: 
+                    if(fileComment.empty())
+                        fileComment = otherFileComment;
+                    break;
+                case CommentCombineStrategy::Merge:
+                    if(fileComment.empty())
+                        fileComment = otherFileComment;
+                    else if(!otherFileComment.empty())
+                        fileComment = fileComment + '\n' + otherFileComment;
+                    break;
+                case CommentCombineStrategy::Clear: fileComment.clear(); break;
+                default: std::unreachable();
+            }
+        }
+    #endif
+
+    public:
+        template<Style STYLE = {}>
+        constexpr void WriteToBuffer(std::string& buffer) const noexcept
+        {
+        #if !FDF_NO_COMMENTS
+            detail::Utils<ERROR_CALLBACK>::template WriteFileContent<STYLE>(buffer, entries, fileComment);
+        #else
+            detail::Utils<ERROR_CALLBACK>::template WriteFileContent<STYLE>(buffer, entries);
+        #endif
+        }
+        template<Style STYLE = {}>
+        [[nodiscard]] inline bool WriteToFile(std::filesystem::path filepath, bool bCreateIfNotExists = true) const noexcept
+        {
+            std::ofstream file = OpenOutputFile(filepath, bCreateIfNotExists, std::ios::out);
+            if(!file)
+                return false;
+
+            std::string buffer;
+            WriteToBuffer(buffer);
+
+            file << buffer;
+            return static_cast<bool>(file);
+        }
+
+    public:
+        // Snapshot of the entries that "LoadBinary" reads back without tokenizing or decoding anything (see "detail::BinaryHeader")
+        // Appended to "buffer", the format only stays the same between builds with the same byte order
+        inline void WriteBinary(std::string& buffer) const
+        {
+            detail::BinaryHeader header;
+            header.recordSize = sizeof(detail::BinaryRecord);
+            header.entryCount = entries.size();
+            header.topLevelEntryCount = topLevelEntryCount;
+
+            std::vector<detail::BinaryRecord> records(entries.size());
+            std::string blob;
+            std::unordered_map<std::string_view, uint64_t> identifierOffsets;  // Same identifiers repeat a lot, each is stored once
+            auto appendBlob = [&blob](std::string_view view) -> uint64_t
+            {
+                blob.append(view);
+                return blob.size() - view.size();
+            };
+
+            for(size_t i = 0; i < entries.size(); i++)
             {
-                if(size < VARIANT_SIZE)
+                const Entry& entry = entries[i];
+                detail::BinaryRecord& record = records[i];
+                record.type = entry.GetType();  // Decodes lazy values
+                record.depth = entry.depth;
+                record.parentOffset = entry.parentOffset;
+                record.arrayIndex = entry.arrayIndex;
+
+                if(entry.identifier != nullptr)
                 {
-                    entry.data.str[size++] = c;
+                    const auto [it, bInserted] = identifierOffsets.try_emplace(entry.GetIdentifier(), blob.size());
+                    if(bInserted)
+                        appendBlob(entry.GetIdentifier());
+
+                    record.bHasIdentifier = true;
+                    record.identifierSize = entry.identifierSize;
+                    record.identifierOffset = it->second;
+                }
+
+                if(record.type == Type::String || record.type == Type::Hex || record.type == Type::Timestamp)
+                {
+                    const std::string_view value = entry.GetValue<char>();
+                    record.size = value.size();
+                    record.payload[0] = appendBlob(value);
                 }
                 else
                 {
-                    if(!bDynamic)
-                    {
-                        bDynamic = true;
-                        char buffer[VARIANT_SIZE] = {};
-                        constexpr_memcpy(buffer, entry.data.str, size);
-                        entry.data.strDynamic.InitialAllocate(entry.size + 1);
-                        constexpr_memcpy(entry.data.strDynamic.data, buffer, size);
-                    }
-    
-                    entry.data.strDynamic[size++] = c;
+                    record.size = entry.size;
+                    std::memcpy(record.payload, static_cast<const void*>(&entry.data), sizeof(record.payload));
                 }
-            };
-            auto writeDynamicCharacter = [&](char c)
+
+            #if !FDF_NO_COMMENTS
+                if(!entry.GetComment().empty())
+                {
+                    record.commentSize = entry.GetComment().size();
+                    record.commentOffset = appendBlob(entry.GetComment());
+                }
+            #endif
+            }
+
+        #if !FDF_NO_COMMENTS
+            header.fileCommentSize = fileComment.size();
+            header.fileCommentOffset = appendBlob(fileComment);
+        #endif
+            const std::string_view slots = identifierIndex.GetSlotBytes();
+            header.slotsSize = slots.size();
+            header.blobSize = blob.size();
+
+            const size_t headerStart = buffer.size();
+            buffer.resize(headerStart + sizeof(header) + records.size() * sizeof(detail::BinaryRecord));
+            std::memcpy(buffer.data() + headerStart + sizeof(header), records.data(), records.size() * sizeof(detail::BinaryRecord));
+            buffer.append(slots);
+            buffer.append(blob);
+
+            header.checksum = detail::Checksum(std::string_view(buffer).substr(headerStart + sizeof(header)));
+            std::memcpy(buffer.data() + headerStart, &header, sizeof(header));
+        }
+        // Failing to allocate the snapshot is reported as a failed write
+        [[nodiscard]] inline bool WriteBinaryToFile(std::filesystem::path filepath, bool bCreateIfNotExists = true) const noexcept
+        {
+            try
             {
-                entry.data.strDynamic[size++] = c;
-            };
-    
-            if(currentToken.type == TokenType::StringLiteral)
+                std::ofstream file = OpenOutputFile(filepath, bCreateIfNotExists, std::ios::out | std::ios::binary);
+                if(!file)
+                    return false;
+
+                std::string buffer;
+                WriteBinary(buffer);
+
+                file.write(buffer.data(), buffer.size());
+                return static_cast<bool>(file);
+            }
+            catch(...)
             {
-                entry.size = view.size() - 2;
-                entry.type = Type::String;
+                return false;
+            }
+        }
 
-                const size_t start = 1;
-                const size_t end = view.size() - 1;
+        // Loads what "WriteBinary" wrote. Entries are rebuilt in a single pass over the records and the identifier index is copied as it is
+        // Records can't be used as entries in place, entries hold pointers (identifier, string payload, comment, memory resource) that only mean something in
+        // the process that made them. So each record becomes an entry pointing into "data" instead, nothing is copied, tokenized or decoded
+        // The only other pass over the data is "bVerifyChecksum"
+        // Strings, identifiers and comments point into "data", so the caller has to keep it alive as long as the entries, prefer the overload taking a path
+        [[nodiscard]] inline bool LoadBinary(std::string_view data, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty, bool bVerifyChecksum = true) noexcept
+        {
+            detail::BinaryHeader header;
+            if(data.size() < sizeof(header))
+                return false;
 
-                auto isEscapableChar     = [](char c) -> bool  { return c == '\"' || c == '\'' || c == '\\'; };
-                auto isMergeEscapeChar   = [](char c) -> bool  { return c == 'n'  || c == 'r'  || c == 't' || c == 'v' || c == 'b' || c == 'f' || c == 'a'; };
-                auto isUnicodeEscapeChar = [](char c) -> bool  { return c == 'u'  || c == 'U'; };  // TODO: Maybe handle unicode?
+            std::memcpy(&header, data.data(), sizeof(header));
+            if(header.magic != detail::BINARY_MAGIC || header.version != detail::BINARY_VERSION || header.recordSize != sizeof(detail::BinaryRecord))
+                return false;
 
-                auto convertMergedEscapeChar = [](char c) -> char
+            const std::string_view body = data.substr(sizeof(header));
+            const uint64_t recordsSize = header.entryCount * sizeof(detail::BinaryRecord);
+            if(header.entryCount > body.size() / sizeof(detail::BinaryRecord) || header.slotsSize > body.size() - recordsSize || body.size() - recordsSize - header.slotsSize != header.blobSize)
+                return false;
+            if(bVerifyChecksum && detail::Checksum(body) != header.checksum)
+                return false;
+
+            // The checksum only catches corruption, offsets and counts are checked too so a crafted file can't point outside of "data"
+            const std::string_view blob = body.substr(recordsSize + header.slotsSize);
+            auto isInBlob = [&blob](uint64_t offset, uint64_t size) -> bool  { return offset <= blob.size() && size <= blob.size() - offset; };
+
+            IO other(GetMemoryResource());
+            if(!other.identifierIndex.AssignSlotBytes(body.substr(recordsSize, header.slotsSize), header.entryCount))
+                return false;
+
+            other.entries.reserve(header.entryCount);
+            for(size_t i = 0; i < header.entryCount; i++)
+            {
+                detail::BinaryRecord record;
+                std::memcpy(&record, body.data() + i * sizeof(record), sizeof(record));
+
+                if(record.type > Type::Map || record.parentOffset > i || (record.parentOffset == 0) != (record.depth == 0))
+                    return false;
+                if(record.parentOffset != 0 && (!other.entries[i - record.parentOffset].IsContainer() || other.entries[i - record.parentOffset].depth + 1 != record.depth))
+                    return false;
+                if(record.bHasIdentifier? !isInBlob(record.identifierOffset, record.identifierSize) || record.identifierSize == 0 : record.parentOffset == 0)
+                    return false;
+                if(!isInBlob(record.commentOffset, record.commentSize))
+                    return false;
+
+                Entry& entry = other.entries.emplace_back();
+                entry.type = record.type;
+                entry.depth = record.depth;
+                entry.parentOffset = record.parentOffset;
+                entry.arrayIndex = record.arrayIndex;
+                if(record.bHasIdentifier)
                 {
-                    if(c == 'n')
-                        return '\n';
-                    if(c == 'r')
-                        return '\r';
-                    if(c == 't')
-                        return '\t';
-                    if(c == 'v')
-                        return '\v';
-                    if(c == 'b')
-                        return '\b';
-                    if(c == 'f')
-                        return '\f';
-                    if(c == 'a')
-                        return '\a';
-                    return c;
-                };
-    
-                size_t escapeCharacters = 0;
-                if(view.size() < VARIANT_DYNAMIC_STRING_HARD_LIMIT)
+                    entry.identifier = blob.data() + record.identifierOffset;
+                    entry.identifierSize = record.identifierSize;
+                }
+
+                switch(record.type)
                 {
-                    for(int i = start; i < end; i++)
-                    {
-                        if(view[i] == '\\' && i + 1 < end && (isEscapableChar(view[i + 1]) || isMergeEscapeChar(view[i + 1])))
-                        {
-                            i++;
-                            entry.size--;
+                    case Type::String:
+                    case Type::Hex:
+                    case Type::Timestamp:
+                        if(!isInBlob(record.payload[0], record.size))
+                            return false;
+                        detail::Utils<ERROR_CALLBACK>::BorrowString(entry, blob.substr(record.payload[0], record.size));
+                        break;
+
+                    case Type::Array:
+                    case Type::Map:
+                        if(record.payload[0] >= header.entryCount - i || record.size > record.payload[0])
+                            return false;
+                        other.identifierIndex.SkipContainerKeys(record.payload[1] + 1);
+                        [[fallthrough]];
+
+                    default:
+                        if(record.size > (record.type == Type::Bool? detail::VARIANT_SIZE : detail::VARIANT_64BIT_ELEMENT_COUNT) && !entry.IsContainer())
+                            return false;
+                        entry.size = record.size;
+                        std::memcpy(static_cast<void*>(&entry.data), record.payload, sizeof(record.payload));
+                        break;
+                }
+                // Infinity and NaN can't be written as text, so a document never holds them
+                if(entry.type == Type::Float && !std::ranges::all_of(std::span(entry.data.f, entry.size), [](double value) { return std::isfinite(value); }))
+                    return false;
+
+            #if !FDF_NO_COMMENTS
+                entry.borrowedComment = blob.substr(record.commentOffset, record.commentSize);
+            #endif
+            }
+
+            other.topLevelEntryCount = header.topLevelEntryCount;
+        #if !FDF_NO_COMMENTS
+            if(!isInBlob(header.fileCommentOffset, header.fileCommentSize))
+                return false;
+            other.fileComment = blob.substr(header.fileCommentOffset, header.fileCommentSize);
+        #endif
+
+            return Combine(std::move(other), fileCommentCombineStrategy);
+        }
+        // On Linux the file is mapped and the entries point into the mapping, it is kept alive until "ReleasePinnedSources"
+        [[nodiscard]] inline bool LoadBinary(std::filesystem::path filepath, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty, bool bVerifyChecksum = true) noexcept
+        {
+        #if FDF_MMAP
+            auto source = std::make_shared<detail::MappedFile>();
+            if(!source->Open(filepath))
+                return false;
+
+            if(!LoadBinary(source->View(), fileCommentCombineStrategy, bVerifyChecksum))
+                return false;
+        #else
+            std::ifstream file(filepath, std::ios::binary);
+            if(!file)
+                return false;
+
+            auto source = std::make_shared<const std::string>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            if(!LoadBinary(std::string_view(*source), fileCommentCombineStrategy, bVerifyChecksum))
+                return false;
+        #endif
+
+            pinnedSources.push_back(std::move(source));
+            return true;
+        }
+
+    private:
+        [[nodiscard]] static std::ofstream OpenOutputFile(const std::filesystem::path& filepath, bool bCreateIfNotExists, std::ios::openmode mode)
+        {
+            if(!std::filesystem::exists(filepath))
+            {
+                if(!bCreateIfNotExists)
+                    return {};
+
+                auto parentDir = filepath.parent_path();
+                if(!parentDir.empty() && !std::filesystem::exists(parentDir))
+                {
+                    std::error_code ec;
+                    std::filesystem::create_directories(parentDir, ec);
+                    if(ec)
+                        return {};
+                }
+            }
+            else if(!std::filesystem::is_regular_file(filepath))
+            {
+                return {};
+            }
+
+            return std::ofstream(filepath, mode);
+        }
+
+    private:
+        #define REQ requires(!IS_CONST)
+        template<bool IS_CONST>
+        struct EntryWrapper
+        { 
+            std::conditional_t<IS_CONST, const IO&, IO&> io;
+            const size_t index = static_cast<size_t>(-1);
+
+            [[nodiscard]] constexpr bool IsMutable() const noexcept  { return !IS_CONST; }
+            
+            [[nodiscard]] constexpr       Entry& operator*()        noexcept REQ  { return index != -1?  io.entries[index] :  Entry::INVALID; }
+            [[nodiscard]] constexpr const Entry& operator*()  const noexcept      { return index != -1?  io.entries[index] :  Entry::INVALID; }
+                          constexpr       Entry* operator->()       noexcept REQ  { return index != -1? &io.entries[index] : &Entry::INVALID; }
+                          constexpr const Entry* operator->() const noexcept      { return index != -1? &io.entries[index] : &Entry::INVALID; }
+
+            [[nodiscard]] constexpr       Entry& Get()       noexcept REQ  { return index != -1?  io.entries[index] :  Entry::INVALID; }
+            [[nodiscard]] constexpr const Entry& Get() const noexcept      { return index != -1?  io.entries[index] :  Entry::INVALID; }
+
+            [[nodiscard]] constexpr auto Iterator()               noexcept REQ  { return Span() | ChildFilter()                    | Wrap(); }
+            [[nodiscard]] constexpr auto Iterator()         const noexcept      { return Span() | ChildFilter()                    | Wrap(); }
+            [[nodiscard]] constexpr auto TopLevelIterator()       noexcept REQ  { return detail::SiblingView<      Entry>(Span()) | Wrap(); }
+            [[nodiscard]] constexpr auto TopLevelIterator() const noexcept      { return detail::SiblingView<const Entry>(Span()) | Wrap(); }
+
+            [[nodiscard]] constexpr size_t GetEntryCount()         const noexcept  { return io.entries[index].IsContainer()? io.entries[index].data.u[0] : 0; }
+            [[nodiscard]] constexpr size_t GetTopLevelEntryCount() const noexcept  { return io.entries[index].IsContainer()? io.entries[index].size : 0; }
+
+        public:
+            // Call const versions, so we don't duplicate the code
+            [[nodiscard]] constexpr EntryWrapper<false> GetEntryMutable(size_t id) noexcept REQ
+            {
+                return {io, GetEntry(id).index};
+            }
+            [[nodiscard]] constexpr EntryWrapper<false> GetEntryMutable(std::string_view identifier) noexcept REQ
+            {
+                return {io, GetEntry(identifier).index};
+            }
+            [[nodiscard]] constexpr EntryWrapper<false> GetEntryMutable(const Path& path) noexcept REQ
+            {
+                return {io, GetEntry(path).index};
+            }
+            [[nodiscard]] constexpr EntryWrapper<false> GetTopLevelEntryMutable(size_t id) noexcept REQ
+            {
+                return {io, GetTopLevelEntry(id).index};
+            }
+
+            [[nodiscard]] constexpr EntryWrapper<true> GetEntry(size_t id) const noexcept
+            {
+                return GetEntryCount() > id? EntryWrapper<true>{io, id + index + 1} : EntryWrapper<true>{io};
+            }
+            [[nodiscard]] constexpr EntryWrapper<true> GetEntry(std::string_view identifier) const noexcept
+            {
+                const size_t id = index != -1? io.FindEntry(index, identifier) : static_cast<size_t>(-1);
+                return io.entries.size() > id? EntryWrapper<true>{io, id} : EntryWrapper<true>{io};
+            }
+            [[nodiscard]] constexpr EntryWrapper<true> GetEntry(const Path& path) const noexcept
+            {
+                const size_t id = index != -1? io.FindEntry(index, path.segments, path.text) : static_cast<size_t>(-1);
+                return io.entries.size() > id? EntryWrapper<true>{io, id} : EntryWrapper<true>{io};
+            }
+            // Array elements are found through the identifier index, children of maps through the child table (built on first use)
+            [[nodiscard]] constexpr EntryWrapper<true> GetTopLevelEntry(size_t id) const noexcept
+            {
+                if(index == -1 || id >= GetTopLevelEntryCount())
+                    return {io};
+
+                const size_t child = io.entries[index].type == Type::Array? io.identifierIndex.FindElement(io.entries, index, id) : io.childTable.Find(io.entries, index, id);
+                return io.entries.size() > child? EntryWrapper<true>{io, child} : EntryWrapper<true>{io};
+            }
+
+            [[nodiscard]] constexpr EntryWrapper<true> GetParent() const noexcept
+            {
+                return index != -1? EntryWrapper<true>{io, detail::EntryIndex::GetParentIndex(io.entries, index)} : EntryWrapper<true>{io};
+            }
+
+        public:
+            // Full identifiers aren't stored, they are rebuilt from the parent chain into "buffer"
+            [[nodiscard]] constexpr std::string_view GetFullIdentifier(std::string& buffer) const
+            {
+                buffer.clear();
+                return index != -1? Get().GetFullIdentifier(buffer) : buffer;
+            }
+            [[nodiscard]] constexpr std::string_view GetParentIdentifier(std::string& buffer) const
+            {
+                return GetParent().GetFullIdentifier(buffer);
+            }
+            [[nodiscard]] constexpr std::string_view GetIdentifier(std::string& temp) const
+            {
+                return Get().GetIdentifier(temp);
+            }
+
+            // Children are keyed by the index of their parent, so a container is renamed without touching them
+            constexpr void SetIdentifier(std::string_view newIdentifier) REQ
+            {
+                if(newIdentifier.empty())
+                    throw std::runtime_error("Identifier can't be empty");
+                if(newIdentifier.size() > std::numeric_limits<uint8_t>::max())
+                    throw std::runtime_error("Max identifier length(255) is exceeded");
+                if(index == -1 || Get().IsArrayElement())
+                    throw std::runtime_error("Only valid entries that aren't array elements can be renamed");
+
+                const size_t existing = io.identifierIndex.Find(io.entries, detail::EntryIndex::GetParentIndex(io.entries, index), newIdentifier);
+                if(existing == index)
+                    return;
+                if(existing != -1)
+                    throw std::runtime_error("Identifier already exists");
+
+                io.identifierIndex.Erase(io.entries, index);
+                const std::string_view identifier = io.identifierIndex.Intern(newIdentifier);
+                Get().identifier = identifier.data();
+                Get().identifierSize = identifier.size();
+                io.identifierIndex.Insert(io.entries, index);
+            }
+        
+        private:
+            constexpr auto Span()       noexcept REQ  { return index != -1? std::span(io.entries.data() + index + 1, io.entries[index].IsContainer()? io.entries[index].data.u[0] : 0) : std::span<Entry>(); }
+            constexpr auto Span() const noexcept      { return index != -1? std::span(io.entries.data() + index + 1, io.entries[index].IsContainer()? io.entries[index].data.u[0] : 0) : std::span<Entry>(); }
+
+            constexpr auto ChildFilter() const noexcept  { return std::views::take_while([this](const Entry& e) { return io.entries[&e - io.entries.data()].depth > io.entries[index].depth; }); }
+
+            constexpr auto Wrap()       noexcept REQ  { return std::views::transform([this](      Entry& e) { return EntryWrapper<false>{io, static_cast<size_t>(&e - io.entries.data())}; }); }
+            constexpr auto Wrap() const noexcept      { return std::views::transform([this](const Entry& e) { return EntryWrapper<true >{io, static_cast<size_t>(&e - io.entries.data())}; }); }
+        };
+        #undef REQ
+
+        constexpr auto Wrap()       noexcept  { return std::views::transform([this](      Entry& e) { return EntryWrapper<false>{*this, static_cast<size_t>(&e - entries.data())}; }); }
+        constexpr auto Wrap() const noexcept  { return std::views::transform([this](const Entry& e) { return EntryWrapper<true >{*this, static_cast<size_t>(&e - entries.data())}; }); }
+
+    public:
+        [[nodiscard]] constexpr auto Iterator()               noexcept  { return entries                    | Wrap(); }
+        [[nodiscard]] constexpr auto Iterator()         const noexcept  { return entries                    | Wrap(); }
+        [[nodiscard]] constexpr auto TopLevelIterator()       noexcept  { return detail::SiblingView<      Entry>(entries) | Wrap(); }
+        [[nodiscard]] constexpr auto TopLevelIterator() const noexcept  { return detail::SiblingView<const Entry>(entries) | Wrap(); }
+
+        [[nodiscard]] constexpr size_t GetEntryCount()         const noexcept  { return entries.size(); }
+        [[nodiscard]] constexpr size_t GetTopLevelEntryCount() const noexcept  { return topLevelEntryCount; }
+
+    public:
+        // Call const versions, so we don't duplicate the code
+        [[nodiscard]] constexpr EntryWrapper<false> GetEntryMutable(size_t id) noexcept
+        {
+            return {*this, GetEntry(id).index};
+        }
+        [[nodiscard]] constexpr EntryWrapper<false> GetEntryMutable(std::string_view identifier) noexcept
+        {
+            return {*this, GetEntry(identifier).index};
+        }
+        [[nodiscard]] constexpr EntryWrapper<false> GetEntryMutable(const Path& path) noexcept
+        {
+            return {*this, GetEntry(path).index};
+        }
+        template<FixedString PATH>
+        [[nodiscard]] constexpr EntryWrapper<false> GetMutable() noexcept
+        {
+            return {*this, Get<PATH>().index};
+        }
+        [[nodiscard]] constexpr EntryWrapper<false> GetTopLevelEntryMutable(size_t id) noexcept
+        {
+            return {*this, GetTopLevelEntry(id).index};
+        }
+
+        [[nodiscard]] constexpr EntryWrapper<true> GetEntry(size_t id) const noexcept
+        {
+            return GetEntryCount() > id? EntryWrapper<true>{*this, id} : EntryWrapper<true>{*this};
+        }
+        [[nodiscard]] constexpr EntryWrapper<true> GetEntry(std::string_view identifier) const noexcept
+        {
+            return GetEntry(FindEntry(static_cast<size_t>(-1), identifier));
+        }
+        [[nodiscard]] constexpr EntryWrapper<true> GetEntry(const Path& path) const noexcept
+        {
+            return GetEntry(FindEntry(static_cast<size_t>(-1), path.segments, path.text));
+        }
+        // Segments of "PATH" are hashed at compile time, "io.Get<"projects.1.name">()"
+        template<FixedString PATH>
+        [[nodiscard]] constexpr EntryWrapper<true> Get() const noexcept
+        {
+            return GetEntry(FindEntry(static_cast<size_t>(-1), detail::PATH_SEGMENTS<PATH>, PATH.View()));
+        }
+        // The child table is built on the first call after the structure changed, later calls are a lookup
+        [[nodiscard]] constexpr EntryWrapper<true> GetTopLevelEntry(size_t id) const noexcept
+        {
+            return GetEntry(id < topLevelEntryCount? childTable.Find(entries, -1, id) : static_cast<size_t>(-1));
+        }
+
+        // Read only copy for documents that aren't changed anymore, see "FrozenDocument"
+        [[nodiscard]] inline FrozenDocument Freeze() const;
+
+    public:
+        // Only safe if no entry borrows from the sources anymore (see "Entry::IsBorrowed"), entries from "LoadBinary" always do
+        inline void ReleasePinnedSources() noexcept  { pinnedSources.clear(); }
+
+    private:
+        std::shared_ptr<std::pmr::memory_resource> arena;  // Declared before "entries" so it is destroyed after them
+        bool bPoolArena = false;  // "arena" comes from "WithPool"
+        detail::EntryVector entries;
+        detail::EntryIndex identifierIndex;
+        detail::ChildTable childTable;  // Reset by everything that adds, removes or moves entries
+        size_t topLevelEntryCount = 0;
+        std::vector<std::shared_ptr<const void>> pinnedSources;  // Parsed contents that are kept alive (mapped files, owned strings), shared so copies of the IO keep them alive too
+        std::vector<detail::EntryPosition> entryPositions;  // Top level entries and map children in the content they were parsed from, used by "Reparse"
+        size_t sourceSize = 0;
+
+#if !FDF_NO_COMMENTS
+    public:
+        std::string fileComment;
+#endif
+    };
+}
+
 
-                            if(isEscapableChar(view[i]))
-                                writeCharacter(view[i]);
-                            else
-                                writeCharacter(convertMergedEscapeChar(view[i]));
-                        }
-                        else
-                        {
-                            writeCharacter(view[i]);
-                        }
-                    }
-                    writeCharacter('\0');
-                }
-                else
-                {
-                    entry.data.strDynamic.InitialAllocate(entry.size + 1);
-                    for(int i = start; i < end; i++)
-                    {
-                        if(view[i] == '\\' && i + 1 < end && (isEscapableChar(view[i + 1]) || isMergeEscapeChar(view[i + 1])))
-                        {
-                            i++;
-                            entry.size--;
 
-                            if(isEscapableChar(view[i]))
-                                writeDynamicCharacter(view[i]);
-                            else
-                                writeDynamicCharacter(convertMergedEscapeChar(view[i]));
-                        }
-                        else
-                        {
-                            writeDynamicCharacter(view[i]);
-                        }
-                    }
-    
-                    writeDynamicCharacter('\0');
-                    entry.data.strDynamic.RefreshView();
-                }
 
-                return postProcess();
-            }
-    
-    
-    
-    
-            if(currentToken.type == TokenType::HexLiteral || currentToken.type == TokenType::TimestampLiteral)
-            {
-                entry.size = view.size();
-                entry.type = currentToken.type == TokenType::HexLiteral? Type::Hex : Type::Timestamp;
-    
-                if(view.size() + 1 < VARIANT_SIZE)
-                {
-                    constexpr_memcpy(entry.data.str, view.data(), view.size());
-                    entry.data.str[view.size()] = '\0';
-                }
-                else
-                {
-                    entry.data.strDynamic.InitialAllocate(entry.size + 1);
-                    constexpr_memcpy(entry.data.strDynamic.data, view.data(), view.size());
-                    entry.data.strDynamic.data[view.size()] = '\0';
-                    entry.data.strDynamic.RefreshView();
-                }
+FDF_EXPORT namespace fdf
+{
+    // Push parser, content can be given in arbitrary chunks and every complete top level entry is parsed as soon as it arrives
+    // Only the unfinished part of the content is kept in memory. Like IO::Parse(std::string_view), entries are parsed into a separate IO
+    // that is combined with the target by "Finish", so the target is unchanged if the content fails to parse or collides with its entries
+    template<auto ERROR_CALLBACK> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
+    class StreamParser
+    {
+    public:
+        constexpr StreamParser(IO<ERROR_CALLBACK>& target_, CommentCombineStrategy fileCommentCombineStrategy_ = CommentCombineStrategy::UseNewIfExistingIsEmpty) noexcept
+            : target(target_), parsed(target_.GetMemoryResource()), fileCommentCombineStrategy(fileCommentCombineStrategy_)  { }
 
-                return postProcess();
-            }
-    
-    
-    
-    
-            if(currentToken.type == TokenType::EvaluateLiteral)
-            {
-                entry.size = EVALUATE_LITERAL_TEXT.size();
-                entry.type = Type::String;
-                constexpr_memcpy(entry.data.str, EVALUATE_LITERAL_TEXT.data(), EVALUATE_LITERAL_TEXT.size());
+    public:
+        [[nodiscard]] constexpr bool Feed(std::span<const char> chunk) noexcept
+        {
+            if(bFailed || bFinished)
+                return false;
 
-                return postProcess();
-            }
-    
-            return false;  // Something we didn't process yet?
+            buffer.append(chunk.data(), chunk.size());
+            const size_t boundary = scanner.Scan(buffer);
+            if(boundary == std::string_view::npos)
+                return true;
+
+            bFailed = !ParseBuffered(boundary, false);
+            return !bFailed;
         }
-    
-    
-    
-    
-        [[nodiscard]] constexpr static bool ParseArray(std::string_view content, Tokenizer& tokenizer, std::vector<Entry>& entries
+        [[nodiscard]] constexpr bool Feed(std::string_view chunk) noexcept
+        {
+            return Feed(std::span<const char>(chunk.data(), chunk.size()));
+        }
+
+        [[nodiscard]] constexpr bool Finish() noexcept
+        {
+            if(bFailed || bFinished)
+                return false;
+
+            bFinished = true;
+            if(!ParseBuffered(buffer.size(), true))
+                return false;
+
+            buffer.clear();
+            buffer.shrink_to_fit();
         #if !FDF_NO_COMMENTS
-            , Token comment
+            parsed.fileComment = std::move(fileComment);
         #endif
-            )
+            return target.Combine(std::move(parsed), fileCommentCombineStrategy);
+        }
+
+        [[nodiscard]] constexpr size_t GetBufferedSize() const noexcept  { return buffer.size(); }
+
+    private:
+        [[nodiscard]] constexpr bool ParseBuffered(size_t limit, bool bFinal)
         {
-            size_t entryID = entries.size() - 1;
-            entries[entryID].type = Type::Array;
-            entries[entryID].data.u[0] = 0;  // Total tree size (total child count, not just top level)
-    
-            Token currentToken = tokenizer.Advance();
-            FDF_CHECK_TOKEN(currentToken);
-            FDF_CHECK_TOKEN_FOR_EOF(currentToken);
-    
-            size_t currentChildID = entryID + 1;
-            while(true)
+            using Utils = detail::Utils<ERROR_CALLBACK>;
+
+            const std::string_view content = std::string_view(buffer).substr(0, limit);
+            typename Utils::EntrySink sink = { .entries = parsed.entries, .index = parsed.identifierIndex };
+            detail::Tokenizer tokenizer = content;
+        #if !FDF_NO_COMMENTS
+            detail::Token fileCommentToken = detail::TokenType::NonExisting;  // Nothing is consumed while it is pending, so it is found again on every call
+        #endif
+
+            size_t consumed = 0;
+            bool bEndOfFile = false;
+            while(!bEndOfFile)
             {
+                const size_t entryCount = parsed.entries.size();
+                const size_t topLevelEntryCount = parsed.topLevelEntryCount;
+
             #if !FDF_NO_COMMENTS
-                Token childComment;
+                const bool bResult = Utils::ParseTopLevelEntry(content, tokenizer, sink, fileComment, fileCommentToken, !bParsedEntry, parsed.topLevelEntryCount, bEndOfFile);
+            #else
+                const bool bResult = Utils::ParseTopLevelEntry(content, tokenizer, sink, parsed.topLevelEntryCount, bEndOfFile);
             #endif
-                while(currentToken.type == TokenType::Comment || currentToken.type == TokenType::NewLine)
-                {
-                #if !FDF_NO_COMMENTS
-                    if(currentToken.type == TokenType::Comment)
-                    {
-                        if(childComment.type != TokenType::NonExisting)
-                            if(!ERROR_CALLBACK(Error::AlreadyHasComment, std::format("Token already has a comment\nOld Comment: \"{}\" ({}:{})\nNew Comment: \"{}\" ({}:{})", childComment.ToView(content), childComment.line, childComment.column, currentToken.ToView(content), currentToken.line, currentToken.column)))
-                                return false;
-                        childComment = currentToken;
-                    }
-                #endif
-    
-                    currentToken = tokenizer.Advance();
-                    FDF_CHECK_TOKEN(currentToken);
-                    FDF_CHECK_TOKEN_FOR_EOF(currentToken);
-                }
-    
-    
-                if(IsValueLiteral(currentToken.type) || currentToken.type == TokenType::CurlyBraceOpen || currentToken.type == TokenType::SquareBraceOpen)
-                {
-                    entries[entryID].data.u[0]++;
 
-                #if !FDF_NO_COMMENTS
-                    if(!ParseVariable(content, tokenizer, entries, childComment, entryID))
-                        return false;
-                #else
-                    if(!ParseVariable(content, tokenizer, entries, entryID))
+                if(!bResult)
+                {
+                    if(bFinal || tokenizer.Current().type != detail::TokenType::EndOfFile)
                         return false;
-                #endif
 
-                    if(entries[currentChildID].IsContainer())
-                        entries[entryID].data.u[0] += entries[currentChildID].data.u[0];
-                    currentChildID = entries.size();
-    
-                    currentToken = tokenizer.Current();
-                    if(currentToken.type == TokenType::Comma)
-                    {
-                        currentToken = tokenizer.Advance();
-                        FDF_CHECK_TOKEN(currentToken);
-                        FDF_CHECK_TOKEN_FOR_EOF(currentToken);
-                    }
+                    // The entry continues after "limit", roll it back and try again when more content is available
+                    parsed.RemoveNewEntries(entryCount);
+                    parsed.topLevelEntryCount = topLevelEntryCount;
+                    break;
                 }
-                else if(currentToken.type == TokenType::SquareBraceClose)
-                {
-                    currentToken = tokenizer.Advance();
-                    FDF_CHECK_TOKEN(currentToken);
 
-                    if(currentToken.type == TokenType::Comment)
-                    {
-                    #if !FDF_NO_COMMENTS
-                        if(comment.type != TokenType::NonExisting)
-                            if(!ERROR_CALLBACK(Error::AlreadyHasComment, std::format("Token already has a comment\nOld Comment: \"{}\" ({}:{})\nNew Comment: \"{}\" ({}:{})", comment.ToView(content), comment.line, comment.column, currentToken.ToView(content), currentToken.line, currentToken.column)))
-                                return false;
-                        comment = currentToken;
-                    #endif
-                        currentToken = tokenizer.Advance();
-                        FDF_CHECK_TOKEN(currentToken);
-                    }
-    
-                    if(currentToken.type == TokenType::NewLine)
-                    {
-                        currentToken = tokenizer.Advance();
-                        FDF_CHECK_TOKEN(currentToken);
-                    }
+                if(bEndOfFile)
+                    break;
 
-                #if !FDF_NO_COMMENTS
-                    if(comment.type != TokenType::NonExisting)
-                        entries[entryID].comment = comment.ToView(content);
-                #endif
-                    return true;
+            #if !FDF_NO_COMMENTS
+                if(fileCommentToken.type != detail::TokenType::NonExisting)
+                {
+                    detail::TrimWhitespaceMultilineInPlace(fileCommentToken.ToView(content), fileComment);
+                    fileCommentToken = detail::TokenType::NonExisting;
                 }
-                else
-                    return false;
+                bParsedEntry = true;
+            #endif
+                consumed = tokenizer.CurrentOffset();
             }
-        }
-    
-    
-    
-    
-        [[nodiscard]] constexpr static bool ParseMap(std::string_view content, Tokenizer& tokenizer, std::vector<Entry>& entries
+
         #if !FDF_NO_COMMENTS
-            , Token comment
+            if(bFinal && fileCommentToken.type != detail::TokenType::NonExisting)
+                detail::TrimWhitespaceMultilineInPlace(fileCommentToken.ToView(content), fileComment);
         #endif
-            )
-        {
-            size_t entryID = entries.size() - 1;
-            entries[entryID].type = Type::Map;
-            entries[entryID].data.u[0] = 0;  // Total tree size (total child count, not just top level)
-    
-            //if(entries[entryID].typeID == 1)
-            //    CopyEntryDeep(entries, userTypes, userTypeID);
-    
-            Token currentToken = tokenizer.Advance();
-            FDF_CHECK_TOKEN(currentToken);
-            FDF_CHECK_TOKEN_FOR_EOF(currentToken);
 
-            size_t currentChildID = entryID + 1;
-            while(true)
-            {
-            #if !FDF_NO_COMMENTS
-                Token childComment;
-            #endif
-                while(currentToken.type == TokenType::Comment || currentToken.type == TokenType::NewLine)
-                {
-                #if !FDF_NO_COMMENTS
-                    if(currentToken.type == TokenType::Comment)
-                    {
-                        if(childComment.type != TokenType::NonExisting)
-                            if(!ERROR_CALLBACK(Error::AlreadyHasComment, std::format("Token already has a comment\nOld Comment: \"{}\" ({}:{})\nNew Comment: \"{}\" ({}:{})", childComment.ToView(content), childComment.line, childComment.column, currentToken.ToView(content), currentToken.line, currentToken.column)))
-                                return false;
-                        childComment = currentToken;
-                    }
-                #endif
-    
-                    currentToken = tokenizer.Advance();
-                    FDF_CHECK_TOKEN(currentToken);
-                    FDF_CHECK_TOKEN_FOR_EOF(currentToken);
-                }
-    
-    
-                if(currentToken.type == TokenType::Identifier)
-                {
-                    entries[entryID].data.u[0]++;
+            buffer.erase(0, consumed);
+            scanner.Rebase(consumed);
+            return true;
+        }
 
-                #if !FDF_NO_COMMENTS
-                    if(!ParseVariable(content, tokenizer, entries, childComment, entryID))
-                        return false;
-                #else
-                    if(!ParseVariable(content, tokenizer, entries, entryID))
-                        return false;
-                #endif
+    private:
+        IO<ERROR_CALLBACK>& target;
+        IO<ERROR_CALLBACK> parsed;  // Entries parsed so far, combined with "target" by "Finish"
+        CommentCombineStrategy fileCommentCombineStrategy;
 
-                    if(entries[currentChildID].IsContainer())
-                        entries[entryID].data.u[0] += entries[currentChildID].data.u[0];
-                    currentChildID = entries.size();
-    
-                    currentToken = tokenizer.Current();
-                    if(currentToken.type == TokenType::Comma)
-                    {
-                        currentToken = tokenizer.Advance();
-                        FDF_CHECK_TOKEN(currentToken);
-                        FDF_CHECK_TOKEN_FOR_EOF(currentToken);
-                    }
-                }
-                else if(currentToken.type == TokenType::CurlyBraceClose)
-                {
-                    currentToken = tokenizer.Advance();
-                    FDF_CHECK_TOKEN(currentToken);
+        std::string buffer;
+        detail::TopLevelScanner scanner;
+        bool bFailed = false;
+        bool bFinished = false;
 
-                    if(currentToken.type == TokenType::Comment)
-                    {
-                    #if !FDF_NO_COMMENTS
-                        if(comment.type != TokenType::NonExisting)
-                            if(!ERROR_CALLBACK(Error::AlreadyHasComment, std::format("Token already has a comment\nOld Comment: \"{}\" ({}:{})\nNew Comment: \"{}\" ({}:{})", comment.ToView(content), comment.line, comment.column, currentToken.ToView(content), currentToken.line, currentToken.column)))
-                                return false;
-                        comment = currentToken;
-                    #endif
-                        currentToken = tokenizer.Advance();
-                        FDF_CHECK_TOKEN(currentToken);
-                    }
-    
-                    if(currentToken.type == TokenType::NewLine)
-                    {
-                        currentToken = tokenizer.Advance();
-                        FDF_CHECK_TOKEN(currentToken);
-                    }
+#if !FDF_NO_COMMENTS
+        std::string fileComment;
+        bool bParsedEntry = false;
+#endif
+    };
+}
 
-                #if !FDF_NO_COMMENTS
-                    if(comment.type != TokenType::NonExisting)
-                        entries[entryID].comment = comment.ToView(content);
-                #endif
-                    return true;
-                }
-                else
-                    return false;
-            }
-        }
-    
-    
-    
-    
-        [[nodiscard]] constexpr static size_t FindEntry(const std::vector<Entry>& entries, std::string_view fullIdentifier, uint8_t depth, size_t startIndex)
-        {
-            for(size_t i = startIndex; i < entries.size(); i++)
-            {
-                if(entries[i].depth == depth && entries[i].fullIdentifier == fullIdentifier)
-                    return i;
-            }
-    
-            return -1;
-        }
 
-        [[nodiscard]] constexpr static size_t FindChildEntry(const std::vector<Entry>& entries, std::string_view parentIdentifier, std::string_view identifier, uint8_t depth, size_t startIndex)
-        {
-            if(parentIdentifier.empty())
-                return -1;
 
-            std::array<std::string_view, 3> parts = {parentIdentifier, ".", identifier};
-            const size_t totalSize = parentIdentifier.size() + identifier.size() + 1;
-            auto compareEntry = [&](const Entry& e) -> bool
-            {
-                if(e.depth != depth || e.fullIdentifier.size() != totalSize)
-                    return false;
 
-                size_t index = 0;
-                for(auto sv : parts)
-                {
-                    for(char c : sv)
-                    {
-                        if(index >= e.fullIdentifier.size() || e.fullIdentifier[index++] != c)
-                            return false;
-                    }
-                }
-                return true;
-            };
+#if FDF_INOTIFY
+FDF_EXPORT namespace fdf
+{
+    // Keeps documents of watched files up to date on a background thread (Linux only)
+    // Writes that quickly follow each other (editors saving in several steps) cause a single reload, files with unchanged contents aren't parsed again
+    template<auto ERROR_CALLBACK = detail::DefaultErrorCallback> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
+    class FileWatcher
+    {
+        using Clock = std::chrono::steady_clock;
 
-            for(size_t i = startIndex; i < entries.size(); i++)
-            {
-                if(entries[i].depth < depth)
-                    return -1;
-                if(compareEntry(entries[i]))
-                    return i;
-            }
-    
-            return -1;
+    public:
+        // Documents are never modified after they are published, a reload publishes a new one
+        using Document = std::shared_ptr<const IO<ERROR_CALLBACK>>;
+
+        struct Change
+        {
+            std::filesystem::path filepath;
+            std::string identifier;  // Full identifier of the entry
+            ChangeType type = ChangeType::Changed;
+            Document document;  // Document after the change
+        };
+        using Subscriber = std::function<void(const Change&)>;
+
+    public:
+        explicit FileWatcher(std::chrono::milliseconds debounceTime = std::chrono::milliseconds(50))
+            : debounceTime(debounceTime), inotifyFd(::inotify_init1(IN_NONBLOCK | IN_CLOEXEC)), wakeFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        {
+            if(inotifyFd >= 0 && wakeFd >= 0)
+                thread = std::thread([this]() { Run(); });
         }
-    
-        constexpr static void CopyEntryDeep(std::vector<Entry>& target, const std::vector<Entry>& source, size_t sourceID)
+        ~FileWatcher()
         {
-            size_t targetID = target.size() - 1;
-    
-            target[targetID].type = source[sourceID].type;
-            target[targetID].size = source[sourceID].size;
-    
-            for(size_t i = 0; i < source[sourceID].size; i++)
+            if(thread.joinable())
             {
-                const size_t index = sourceID + i + 1;
-                Entry& last = target.emplace_back(source[index]);
-                last.depth += target[targetID].depth;
-                last.fullIdentifier = std::format("{}{}", target[targetID].fullIdentifier, source[index].GetIdentifierWithDot());
-                if(last.type == Type::Array || last.type == Type::Map)
-                    CopyEntryDeep(target, source, index);
+                const uint64_t value = 1;
+                [[maybe_unused]] const ssize_t written = ::write(wakeFd, &value, sizeof(value));
+                thread.join();
             }
+
+            if(inotifyFd >= 0)
+                ::close(inotifyFd);
+            if(wakeFd >= 0)
+                ::close(wakeFd);
         }
-    
-        [[nodiscard]] constexpr static bool OverrideEntry(std::vector<Entry>& entries, size_t targetID, size_t sourceID)
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+    public:
+        // Parses the file and starts watching it, fails if it can't be parsed or watched
+        [[nodiscard]] inline bool Watch(const std::filesystem::path& filepath)
         {
-            // TODO: implement or completely get rid of overriding...
-            // For now, we don't allow any kind of name collision (we don't override anything)
-            return targetID == sourceID;
+            std::error_code ec;
+            const std::filesystem::path path = std::filesystem::absolute(filepath, ec);
+            if(ec || !thread.joinable())
+                return false;
 
+            // Editors often save by replacing the file, so its directory is watched instead of the file itself
+            const int watchDescriptor = ::inotify_add_watch(inotifyFd, path.parent_path().c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+            if(watchDescriptor < 0)
+                return false;
 
-            /*
-            if(targetID == sourceID)
-                return true;
-    
-            if(entries[targetID].type == entries[sourceID].type)
+            bool bInserted;
             {
-                if(entries[targetID].type != Type::Array && entries[targetID].type != Type::Map)
-                {
-                    entries[targetID] = entries[sourceID];
-                    entries.pop_back();
-                    return true;
-                }
-                else
-                {
-                    // TODO: handle Array and Map
-                    // TODO: Just override every child and their childs and so on... Don't bother with merging or something like that
-                    return false;
-                }
+                std::lock_guard lock(mutex);
+                bInserted = files.try_emplace(path.native(), WatchedFile{ .path = path, .watchDescriptor = watchDescriptor }).second;
             }
-    
-            return false;  // Something we didn't process yet?
-            */
+            const bool bReloaded = Reload(path);
+            if(bReloaded || !bInserted)
+                return bReloaded;  // A file that was already watched keeps its last document
+
+            // inotify returns the same descriptor for a directory that is already watched, so it's only removed when no other file uses it
+            std::lock_guard lock(mutex);
+            files.erase(path.native());
+            if(std::ranges::none_of(files, [watchDescriptor](const auto& file) { return file.second.watchDescriptor == watchDescriptor; }))
+                ::inotify_rm_watch(inotifyFd, watchDescriptor);
+            return false;
         }
 
+        // Last version of the file that could be parsed, nullptr if it isn't watched
+        [[nodiscard]] inline Document Get(const std::filesystem::path& filepath) const
+        {
+            std::error_code ec;
+            std::lock_guard lock(mutex);
+            const auto it = files.find(std::filesystem::absolute(filepath, ec).native());
+            return it != files.end()? it->second.document : nullptr;
+        }
 
+        // "subscriber" is called outside of any lock (see "Reload") for each change of "IO::Diff" whose full identifier is "prefix", starts with "prefix." or is a parent of "prefix"
+        // An empty prefix matches every change. Added, removed and replaced containers are reported once, not for each entry inside them
+        inline size_t Subscribe(std::string prefix, Subscriber subscriber)
+        {
+            std::lock_guard lock(mutex);
+            subscribers.push_back({ nextSubscriberId, std::move(prefix), std::move(subscriber) });
+            return nextSubscriberId++;
+        }
+        inline void Unsubscribe(size_t id)
+        {
+            std::lock_guard lock(mutex);
+            std::erase_if(subscribers, [id](const SubscriberEntry& entry) { return entry.id == id; });
+        }
 
+        // What the watcher thread does after the file changes, can be called to reload without waiting for it
+        // Fails if the file can't be read or parsed, the previous document stays published in that case
+        // Subscribers are called after the locks are released, so they may call "Reload", "Watch" or "Subscribe" themselves.
+        // Their changes are queued and delivered in reload order, by whichever thread is already delivering
+        inline bool Reload(const std::filesystem::path& filepath)
+        {
+            if(!ReloadFile(filepath))
+                return false;
+            Deliver();
+            return true;
+        }
 
+    private:
+        struct FileState
+        {
+            int64_t modificationTime = 0;  // Nanoseconds
+            uint64_t size = 0;
+            uint64_t contentHash = 0;
+        };
+        struct WatchedFile
+        {
+            std::filesystem::path path;
+            int watchDescriptor = -1;
+            FileState state;
+            Document document;
+            std::optional<Clock::time_point> reloadTime;  // Set while changes wait for "debounceTime" to pass
+        };
+        struct PendingPatch
+        {
+            std::filesystem::path filepath;
+            Patch patch;
+            Document document;
+        };
+        struct SubscriberEntry
+        {
+            size_t id = 0;
+            std::string prefix;
+            Subscriber subscriber;
+        };
 
+        // Publishes the new document and queues its changes, subscribers aren't called here
+        inline bool ReloadFile(const std::filesystem::path& filepath)
+        {
+            std::error_code ec;
+            const std::string key = std::filesystem::absolute(filepath, ec).native();
+            std::lock_guard reloadLock(reloadMutex);  // One reload at a time, so changes are queued in order
 
+            FileState previousState;
+            Document previous;
+            {
+                std::lock_guard lock(mutex);
+                const auto it = files.find(key);
+                if(it == files.end())
+                    return false;
+                previousState = it->second.state;
+                previous = it->second.document;
+            }
 
+            auto readState = [&key](FileState& state)
+            {
+                struct stat status;
+                if(::stat(key.c_str(), &status) != 0)
+                    return false;
+                state = { .modificationTime = status.st_mtim.tv_sec * 1'000'000'000ll + status.st_mtim.tv_nsec, .size = static_cast<uint64_t>(status.st_size) };
+                return true;
+            };
 
+            FileState state;
+            if(!readState(state))
+                return false;
+            if(previous != nullptr && state.modificationTime == previousState.modificationTime && state.size == previousState.size)
+                return true;
 
+            // Writers truncate and rewrite files in place, so they are read instead of mapped. A file that changes while it is read isn't published,
+            // the write that changed it queues another reload
+            detail::MappedFile source;
+            FileState stateAfterRead;
+            if(!source.Open(key, false) || !readState(stateAfterRead) || stateAfterRead.modificationTime != state.modificationTime || stateAfterRead.size != state.size || source.View().size() != state.size)
+                return false;
 
-        template<Style STYLE>
-        constexpr static void WriteFileContent(std::string& buffer, const std::vector<Entry>& entries
-        #if !FDF_NO_COMMENTS
-            , const std::string& fileComment
-        #endif
-            )
-        {
-            auto isShortArray   = [ ](const Entry& e) -> bool  { return e.data.u[0] <= STYLE.singleLineArrayLimit; };
-            auto isShortMap     = [ ](const Entry& e) -> bool  { return e.data.u[0] <= STYLE.singleLineMapLimit; };
-            auto writeEntryName = [&](const Entry& e) -> void  { buffer.append(e.GetIdentifier()); };
-            auto addTab = [&buffer](size_t count) -> void
-            {
-                if constexpr(STYLE.bUseSpacesOverTabs)
-                    buffer.append(count * STYLE.tabSize, ' ');
-                else
-                    buffer.append(count, '\t');
-            };
-            auto addEqualSign = [&buffer]() -> void
+            state.contentHash = detail::Checksum(source.View());
+            Document current = previous;
+            if(previous == nullptr || state.contentHash != previousState.contentHash || state.size != previousState.size)
             {
-                if constexpr(STYLE.bSpaceBeforeAndAfterEqualSign)
-                    buffer.append(" = ");
-                else
-                    buffer.push_back('=');
-            };
-            auto addComma = [&buffer]() -> void
+                auto io = std::make_shared<IO<ERROR_CALLBACK>>();
+                if(!io->Parse(source.View()))
+                    return false;
+                current = std::move(io);
+            }
+
             {
-                if constexpr(STYLE.bSpaceAfterComma)
-                    buffer.append(", ");
-                else
-                    buffer.push_back(',');
-            };
+                std::lock_guard lock(mutex);
+                WatchedFile& file = files.at(key);
+                file.state = state;
+                file.document = current;
+            }
 
-            auto writeLambda = [&](std::ranges::range auto&& order) -> void
+            if(previous != nullptr && current != previous)
             {
-                buffer.clear();
-                buffer.reserve(entries.size() * 50);
+                Patch patch = previous->Diff(*current);
+                std::lock_guard lock(mutex);
+                pendingPatches.push_back({ .filepath = key, .patch = std::move(patch), .document = std::move(current) });
+            }
+            return true;
+        }
 
-            #if !FDF_NO_COMMENTS
-                if constexpr(STYLE.bFileComment)
+        inline void Run() noexcept
+        {
+            while(true)
+            {
+                int timeout = -1;
+                std::vector<std::filesystem::path> dueFiles;
                 {
-                    if(!fileComment.empty())
+                    const Clock::time_point now = Clock::now();
+                    std::lock_guard lock(mutex);
+                    for(auto& [key, file] : files)
                     {
-                        buffer.append("/*#\n");
-                        size_t prevNewLinePos = -1;
-                        size_t newLinePos = fileComment.find_first_of('\n');
-                        while(newLinePos != std::string::npos)
-                        {
-                            addTab(1);
-                            buffer.append(fileComment, prevNewLinePos + 1, newLinePos - prevNewLinePos);
-                            prevNewLinePos = newLinePos;
-                            newLinePos = fileComment.find_first_of('\n', newLinePos + 1);
-                        }
-                        addTab(1);
-                        buffer.append(fileComment, prevNewLinePos + 1);
-                        buffer.append("\n*/\n\n\n");
-                    }
-                }
-            #endif
+                        if(!file.reloadTime)
+                            continue;
 
-                auto writeSimpleEntryValue = [&](const Entry& e) -> void
-                {
-                    std::string temp;
-                    std::string_view view = e.DataToView<STYLE>(temp);
-                    if(e.type != Type::String)
-                    {
-                        buffer.append(view);
-                    }
-                    else
-                    {
-                        bool bContainsQuote = view.find_first_of('\"') != std::string_view::npos; // does it contain double quote?
-                        if(bContainsQuote)
+                        if(*file.reloadTime <= now)
                         {
-                            if constexpr(STYLE.bAlwaysUseDoubleQuoteForStrings)
-                            {
-                                buffer.push_back('\"');
-                                for(char c : view)
-                                {
-                                    if(c == '\"')
-                                        buffer.append("\\\"");
-                                    else
-                                        buffer.push_back(c);
-                                }
-                                buffer.push_back('\"');
-                            }
-                            else
-                            {
-                                bContainsQuote = view.find_first_of('\'') != std::string_view::npos; // does it contain single quote?
-                                if(bContainsQuote)
-                                {
-                                    buffer.push_back('\"');
-                                    for(char c : view)
-                                    {
-                                        if(c == '\"')
-                                            buffer.append("\\\"");
-                                        else
-                                            buffer.push_back(c);
-                                    }
-                                    buffer.push_back('\"');
-                                }
-                                else
-                                {
-                                    buffer.push_back('\'');
-                                    buffer.append(view);
-                                    buffer.push_back('\'');
-                                }
-                            }
+                            dueFiles.push_back(file.path);
+                            file.reloadTime.reset();
                         }
                         else
                         {
-                            buffer.push_back('\"');
-                            buffer.append(view);
-                            buffer.push_back('\"');
+                            const int remaining = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(*file.reloadTime - now).count());
+                            timeout = timeout < 0? remaining : std::min(timeout, remaining);
                         }
                     }
-                };
-
-                auto writeSimpleEntry = [&](const Entry& e) -> void
-                {
-                    writeEntryName(e);
-                    addEqualSign();
-                    writeSimpleEntryValue(e);
-                };
-
-
-
-
-                auto it = order.begin();
-                auto writeSingleLine = [&]<bool bIsArray>(this auto self, uint8_t depth) -> void
-                {
-                    if constexpr(bIsArray)
-                    {
-                        if constexpr(STYLE.bSpaceWithinParentheses)
-                            buffer.append("[ ");
-                        else
-                            buffer.push_back('[');
-                    }
-                    else
-                    {
-                        if constexpr(STYLE.bSpaceWithinParentheses)
-                            buffer.append("{ ");
-                        else
-                            buffer.push_back('{');
-                    }
-
-                    ++it;
-                    while(it != order.end())
-                    {
-                        const size_t index = *it;
-                        if(entries[index].depth < depth)
-                            break;
-
-                        if(!entries[index].IsContainer())
-                        {
-                            if constexpr(bIsArray)
-                                writeSimpleEntryValue(entries[index]);
-                            else
-                                writeSimpleEntry(entries[index]);
-
-                            addComma();
-                            ++it;
+                }
+
+                // Files are read once no write happened for "debounceTime". A writer that pauses for longer publishes what it has written so far,
+                // if it parses, and its next write publishes the rest
+                if(!dueFiles.empty())
+                {
+                    for(const std::filesystem::path& path : dueFiles)
+                    {
+                        try
+                        {
+                            Reload(path);
                         }
-                        else
+                        catch(const std::exception& exception)  // Subscribers that throw and failed allocations shouldn't end the thread
                         {
-                            if constexpr(!bIsArray)
-                            {
-                                writeEntryName(entries[index]);
-                                if constexpr(STYLE.bUseEqualSignForSingleLineArraysAndMaps)
-                                    addEqualSign();
-                            }
-
-                            if(entries[index].type == Type::Array)
-                            {
-                                self.template operator()<true>(depth + 1);
-                                addComma();
-                            }
-                            else if(entries[index].type == Type::Map)
-                            {
-                                self.template operator()<false>(depth + 1);
-                                addComma();
-                            }
-                            else
-                                std::unreachable();
+                            ReportReloadFailure(path, exception.what());
+                        }
+                        catch(...)
+                        {
+                            ReportReloadFailure(path, "Unknown exception");
                         }
                     }
+                    continue;
+                }
 
-                    if constexpr(STYLE.bSpaceAfterComma)
-                        buffer.erase(buffer.size() - 2);
-                    else
-                        buffer.pop_back();
+                pollfd descriptors[2] = { { .fd = inotifyFd, .events = POLLIN, .revents = 0 }, { .fd = wakeFd, .events = POLLIN, .revents = 0 } };
+                if(::poll(descriptors, 2, timeout) < 0 && errno != EINTR)
+                    return;
+                if(descriptors[1].revents & POLLIN)
+                    return;
+                if(descriptors[0].revents & POLLIN)
+                    ReadEvents();
+            }
+        }
 
-                    if constexpr(bIsArray)
+        inline void ReadEvents() noexcept
+        {
+            alignas(inotify_event) char buffer[4096];
+            while(true)
+            {
+                const ssize_t size = ::read(inotifyFd, buffer, sizeof(buffer));
+                if(size <= 0)
+                    return;
+
+                const Clock::time_point reloadTime = Clock::now() + debounceTime;
+                std::lock_guard lock(mutex);
+                for(ssize_t offset = 0; offset < size;)
+                {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    offset += sizeof(inotify_event) + event->len;
+                    if(event->mask & IN_Q_OVERFLOW)
                     {
-                        if constexpr(STYLE.bSpaceWithinParentheses)
-                            buffer.append(" ]");
-                        else
-                            buffer.append("]");
+                        // Events were dropped, any file could have changed. Unchanged ones only cost a stat
+                        for(auto& [key, file] : files)
+                            file.reloadTime = reloadTime;
+                        continue;
                     }
-                    else
+                    if(event->len == 0)
+                        continue;
+
+                    for(auto& [key, file] : files)
                     {
-                        if constexpr(STYLE.bSpaceWithinParentheses)
-                            buffer.append(" }");
-                        else
-                            buffer.append("}");
+                        if(file.watchDescriptor == event->wd && file.path.filename() == event->name)
+                            file.reloadTime = reloadTime;
                     }
-                };
+                }
+            }
+        }
 
+        inline void ReportReloadFailure(const std::filesystem::path& filepath, std::string_view reason) noexcept
+        {
+            try
+            {
+                const std::string& path = filepath.native();
+                [[maybe_unused]] const bool bContinue = detail::ReportError<ERROR_CALLBACK>(Diagnostic(Error::ReloadFailed, path, 1, "File", path, reason));
+            }
+            catch(...)
+            {
+            }
+        }
 
+        // Calls subscribers for queued patches until none are left, unless another call is already doing it
+        // The thread that delivers keeps going, so patches queued by its subscribers are delivered after the current one
+        inline void Deliver()
+        {
+            // "lhs" is "rhs" or one of its children
+            auto isWithin = [](std::string_view lhs, std::string_view rhs)
+            {
+                return lhs.starts_with(rhs) && (lhs.size() == rhs.size() || lhs[rhs.size()] == '.');
+            };
 
+            {
+                std::lock_guard lock(mutex);
+                if(bDelivering)
+                    return;
+                bDelivering = true;
+            }
 
-                auto writeMultiLine = [&]<bool bIsArray>(this auto self, uint8_t depth) -> void
+            while(true)
+            {
+                PendingPatch pending;
+                std::vector<SubscriberEntry> targets;
                 {
-                    if constexpr(bIsArray)
+                    std::lock_guard lock(mutex);
+                    if(nextPendingPatch == pendingPatches.size())
                     {
-                        if constexpr(STYLE.bParenthesesOnNewLine)
-                        {
-                            buffer.push_back('\n');
-                            addTab(depth - 1);
-                            buffer.append("[\n");
-                        }
-                        else
-                            buffer.append("[\n");
+                        pendingPatches.clear();
+                        nextPendingPatch = 0;
+                        bDelivering = false;
+                        return;
                     }
-                    else
+                    pending = std::move(pendingPatches[nextPendingPatch++]);
+                    targets = subscribers;
+                }
+
+                try
+                {
+                    for(const Patch::Change& patchChange : pending.patch.GetChanges())
                     {
-                        if constexpr(STYLE.bParenthesesOnNewLine)
+                        const Change change = { .filepath = pending.filepath, .identifier = patchChange.identifier, .type = patchChange.type, .document = pending.document };
+                        for(const SubscriberEntry& target : targets)
                         {
-                            buffer.push_back('\n');
-                            addTab(depth - 1);
-                            buffer.append("{\n");
+                            if(target.prefix.empty() || isWithin(change.identifier, target.prefix) || isWithin(target.prefix, change.identifier))
+                                target.subscriber(change);
                         }
-                        else
-                            buffer.append("{\n");
                     }
+                }
+                catch(...)
+                {
+                    std::lock_guard lock(mutex);
+                    bDelivering = false;
+                    throw;
+                }
+            }
+        }
 
-                    ++it;
-                    while(it != order.end())
+    private:
+        const std::chrono::milliseconds debounceTime;
+        const int inotifyFd;
+        const int wakeFd;  // Written to stop the watcher thread
+
+        mutable std::mutex mutex;  // Guards everything below it, never held while parsing or calling subscribers
+        std::mutex reloadMutex;  // Held while parsing, never while calling subscribers
+        std::unordered_map<std::string, WatchedFile> files;  // Keyed by absolute path
+        std::vector<SubscriberEntry> subscribers;
+        size_t nextSubscriberId = 0;
+        std::vector<PendingPatch> pendingPatches;  // In reload order, delivered from "nextPendingPatch" on
+        size_t nextPendingPatch = 0;
+        bool bDelivering = false;
+
+        std::thread thread;  // Declared last, so everything it uses exists before it starts
+    };
+}
+#endif
+
+
+
+
+namespace fdf::detail
+{
+    // Hash and displace perfect hash over a set of key hashes, sized at compile time for a fixed key count
+    // or at run time with "std::dynamic_extent" (see "FrozenDocument")
+    // Keys are grouped into buckets and each bucket stores the displacement that sends all of its keys to free slots,
+    // so a lookup reads one displacement and lands on exactly one candidate slot that only has to be verified
+    template<size_t KEY_COUNT = std::dynamic_extent>
+    struct PerfectHash
+    {
+        static constexpr bool IS_DYNAMIC = KEY_COUNT == std::dynamic_extent;
+        static constexpr uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+        static constexpr uint32_t MAX_DISPLACEMENT = 1u << 20;
+
+        [[nodiscard]] constexpr static size_t GetSlotCount(size_t keyCount)   noexcept  { return std::bit_ceil(keyCount + keyCount / 4 + 1); }
+        [[nodiscard]] constexpr static size_t GetBucketCount(size_t keyCount) noexcept  { return std::bit_ceil(keyCount / 2 + 1); }
+
+        [[nodiscard]] constexpr size_t Find(uint64_t hash) const noexcept
+        {
+            if constexpr(IS_DYNAMIC)
+            {
+                if(slots.empty())
+                    return static_cast<size_t>(-1);
+            }
+
+            const uint32_t key = slots[Slot(MixHash(hash), displacements[MixHash(hash) & (displacements.size() - 1)])];
+            return key != EMPTY_SLOT? key : static_cast<size_t>(-1);  // Plain -1 would be converted to uint32_t
+        }
+
+        // Fails only if two keys have the same hash
+        [[nodiscard]] constexpr bool Build(std::span<const uint64_t> hashes)
+        {
+            if constexpr(IS_DYNAMIC)
+            {
+                slots.assign(GetSlotCount(hashes.size()), EMPTY_SLOT);
+                displacements.assign(GetBucketCount(hashes.size()), 0);
+            }
+            else
+            {
+                slots.fill(EMPTY_SLOT);
+                displacements.fill(0);
+            }
+
+            // Keys are grouped by bucket with a counting pass, so a bucket is a range of "keys" instead of an allocation of its own
+            const size_t bucketCount = displacements.size();
+            std::vector<uint32_t> bucketStarts(bucketCount + 1, 0);
+            for(const uint64_t hash : hashes)
+                bucketStarts[(MixHash(hash) & (bucketCount - 1)) + 1]++;
+            for(size_t i = 0; i < bucketCount; i++)
+                bucketStarts[i + 1] += bucketStarts[i];
+
+            std::vector<uint32_t> keys(hashes.size());
+            std::vector<uint32_t> bucketEnds(bucketStarts.begin(), bucketStarts.end() - 1);
+            for(size_t i = 0; i < hashes.size(); i++)
+                keys[bucketEnds[MixHash(hashes[i]) & (bucketCount - 1)]++] = static_cast<uint32_t>(i);
+
+            auto getBucket = [&](uint32_t bucket) { return std::span<const uint32_t>(keys).subspan(bucketStarts[bucket], bucketStarts[bucket + 1] - bucketStarts[bucket]); };
+
+            // Biggest buckets are placed first, while most of the slots are still free. Sizes are small, so they are counting sorted too
+            size_t maxBucketSize = 0;
+            for(uint32_t bucket = 0; bucket < bucketCount; bucket++)
+                maxBucketSize = std::max(maxBucketSize, getBucket(bucket).size());
+
+            std::vector<uint32_t> sizeStarts(maxBucketSize + 2, 0);
+            for(uint32_t bucket = 0; bucket < bucketCount; bucket++)
+                sizeStarts[maxBucketSize - getBucket(bucket).size() + 1]++;
+            for(size_t i = 0; i <= maxBucketSize; i++)
+                sizeStarts[i + 1] += sizeStarts[i];
+
+            std::vector<uint32_t> order(bucketCount);
+            for(uint32_t bucket = 0; bucket < bucketCount; bucket++)
+                order[sizeStarts[maxBucketSize - getBucket(bucket).size()]++] = bucket;
+
+            std::vector<size_t> positions;
+            for(uint32_t bucket : order)
+            {
+                if(getBucket(bucket).empty())
+                    break;
+
+                uint32_t displacement = 0;
+                for(; displacement < MAX_DISPLACEMENT; displacement++)
+                {
+                    positions.clear();
+                    for(uint32_t key : getBucket(bucket))
                     {
-                        const size_t index = *it;
-                        if(entries[index].depth < depth)
+                        const size_t position = Slot(MixHash(hashes[key]), displacement);
+                        if(slots[position] != EMPTY_SLOT || std::ranges::find(positions, position) != positions.end())
                             break;
+                        positions.push_back(position);
+                    }
 
-                        addTab(depth);
+                    if(positions.size() == getBucket(bucket).size())
+                        break;
+                }
 
-                        if(!entries[index].IsContainer())
-                        {
-                            if constexpr(bIsArray)
-                                writeSimpleEntryValue(entries[index]);
-                            else
-                                writeSimpleEntry(entries[index]);
+                if(displacement == MAX_DISPLACEMENT)
+                    return false;
 
-                            ++it;
-                        }
-                        else if(entries[index].type == Type::Array)
-                        {
-                            if(isShortArray(entries[index]))
-                            {
-                                if constexpr(!bIsArray)
-                                {
-                                    writeEntryName(entries[index]);
-                                    if constexpr(STYLE.bUseEqualSignForSingleLineArraysAndMaps)
-                                        addEqualSign();
-                                }
-                                writeSingleLine.template operator()<true>(depth + 1);
-                            }
-                            else
-                            {
-                                buffer.push_back('\n');
-                                if constexpr(!bIsArray)
-                                    writeEntryName(entries[index]);
-                                self.template operator()<true>(depth + 1);
-                            }
-                        }
-                        else if(entries[index].type == Type::Map)
-                        {
-                            if(isShortMap(entries[index]))
-                            {
-                                if constexpr(!bIsArray)
-                                {
-                                    writeEntryName(entries[index]);
-                                    if constexpr(STYLE.bUseEqualSignForSingleLineArraysAndMaps)
-                                        addEqualSign();
-                                }
-                                writeSingleLine.template operator()<false>(depth + 1);
-                            }
-                            else
-                            {
-                                buffer.push_back('\n');
-                                if constexpr(!bIsArray)
-                                    writeEntryName(entries[index]);
-                                self.template operator()<false>(depth + 1);
-                            }
-                        }
-                        else
-                            std::unreachable();
+                displacements[bucket] = displacement;
+                for(size_t i = 0; i < positions.size(); i++)
+                    slots[positions[i]] = getBucket(bucket)[i];
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] constexpr size_t Slot(uint64_t mixedHash, uint32_t displacement) const noexcept
+        {
+            return MixHash(mixedHash + displacement * 0x9E3779B97F4A7C15ull) & (slots.size() - 1);
+        }
+
+        // Dynamic tables stay empty until "Build", so the fixed sizes are only computed for fixed key counts
+        std::conditional_t<IS_DYNAMIC, std::vector<uint32_t>, std::array<uint32_t, IS_DYNAMIC? 0 : GetBucketCount(KEY_COUNT)>> displacements = {};
+        std::conditional_t<IS_DYNAMIC, std::vector<uint32_t>, std::array<uint32_t, IS_DYNAMIC? 0 : GetSlotCount(KEY_COUNT)>>   slots = {};
+    };
+
+
+    // Entry of a "StaticDocument", strings and identifiers are offsets into the text of the document so nothing points outside of it
+    struct StaticEntryData
+    {
+        Type type = Type::Invalid;
+        uint8_t depth = 0;
+        uint8_t identifierSize = 0;  // Array elements store their formatted position
+        bool bArrayElement = false;
+        uint32_t size = 0;  // Same as "Entry::size"
+        uint32_t childCount = 0;  // Total child count of containers
+        uint32_t parentOffset = 0;
+        uint32_t arrayIndex = 0;
+        uint32_t identifierOffset = 0;
+        uint32_t stringOffset = 0;  // Strings, hex values and timestamps
+
+        // Whole arrays are assigned, so the active member is always well defined during constant evaluation
+        union Values
+        {
+            std::array<bool,     VARIANT_SIZE>                b = {};
+            std::array<int64_t,  VARIANT_64BIT_ELEMENT_COUNT> i;
+            std::array<uint64_t, VARIANT_64BIT_ELEMENT_COUNT> u;
+            std::array<double,   VARIANT_64BIT_ELEMENT_COUNT> f;
+        } values;
+    };
+
+    inline constexpr StaticEntryData INVALID_STATIC_ENTRY = {};
+}
+
+
+
+
+FDF_EXPORT namespace fdf
+{
+    // Read only view to an entry of a "StaticDocument", same getters as "Entry"
+    class StaticEntry
+    {
+        template<FixedString CONTENT>
+        friend class StaticDocument;
+
+    public:
+        constexpr StaticEntry() noexcept = default;
+
+    public:
+        [[nodiscard]] constexpr size_t GetChildCount()         const noexcept  { return IsContainer()? entry->childCount : 0; }
+        [[nodiscard]] constexpr size_t GetTopLevelChildCount() const noexcept  { return IsContainer()? entry->size : 0; }
+
+        [[nodiscard]] constexpr uint8_t GetDepth()    const noexcept  { return entry->depth; }
+        [[nodiscard]] constexpr Type    GetType()     const noexcept  { return entry->type; }
+        [[nodiscard]] constexpr bool    IsValid()     const noexcept  { return entry->type != Type::Invalid; }
+        [[nodiscard]] constexpr bool    IsNull()      const noexcept  { return entry->type == Type::Null; }
+        [[nodiscard]] constexpr bool    IsNil()       const noexcept  { return IsNull(); }
+        [[nodiscard]] constexpr bool    IsContainer() const noexcept  { return entry->type == Type::Array || entry->type == Type::Map; }
+        [[nodiscard]] constexpr bool    HasValue()    const noexcept  { return IsValid() && !IsNull() && !IsContainer(); }
+
+        [[nodiscard]] constexpr bool   IsArrayElement() const noexcept  { return entry->bArrayElement; }
+        [[nodiscard]] constexpr size_t GetArrayIndex()  const noexcept  { return entry->arrayIndex; }
+
+        // Empty for array elements, like "Entry::GetIdentifier"
+        [[nodiscard]] constexpr std::string_view GetIdentifier() const noexcept
+        {
+            return IsArrayElement()? std::string_view() : std::string_view(text + entry->identifierOffset, entry->identifierSize);
+        }
+
+        template<typename T>
+        [[nodiscard]] constexpr auto GetValue() const  { }
+
+    private:
+        constexpr StaticEntry(const detail::StaticEntryData* entry_, const char* text_) noexcept : entry(entry_), text(text_)  { }
+
+    private:
+        const detail::StaticEntryData* entry = &detail::INVALID_STATIC_ENTRY;
+        const char* text = nullptr;
+    };
+
+
+
+
+    template<>
+    [[nodiscard]] constexpr auto StaticEntry::GetValue<bool>() const
+    {
+        if(entry->type != Type::Bool)
+            throw std::runtime_error("Non matching type is not 'bool'");
+        return std::span<const bool>(entry->values.b.data(), entry->size);
+    }
+
+    template<>
+    [[nodiscard]] constexpr auto StaticEntry::GetValue<int64_t>() const
+    {
+        if(entry->type != Type::Int)
+            throw std::runtime_error("Non matching type is not 'int64_t'");
+        return std::span<const int64_t>(entry->values.i.data(), entry->size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto StaticEntry::GetValue<int>() const { return GetValue<int64_t>(); }
+
+    template<>
+    [[nodiscard]] constexpr auto StaticEntry::GetValue<uint64_t>() const
+    {
+        if(entry->type != Type::UInt && entry->type != Type::Version)
+            throw std::runtime_error("Non matching type is not 'uint64_t'");
+        return std::span<const uint64_t>(entry->values.u.data(), entry->size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto StaticEntry::GetValue<unsigned int>() const { return GetValue<uint64_t>(); }
+
+    template<>
+    [[nodiscard]] constexpr auto StaticEntry::GetValue<double>() const
+    {
+        if(entry->type != Type::Float)
+            throw std::runtime_error("Non matching type is not 'double'");
+        return std::span<const double>(entry->values.f.data(), entry->size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto StaticEntry::GetValue<float>() const { return GetValue<double>(); }
+
+    template<>
+    [[nodiscard]] constexpr auto StaticEntry::GetValue<char>() const
+    {
+        if(entry->type != Type::String && entry->type != Type::Hex && entry->type != Type::Timestamp)
+            throw std::runtime_error("Non matching type is not 'string'");
+        return std::string_view(text + entry->stringOffset, entry->size);
+    }
+    template<>
+    [[nodiscard]] constexpr auto StaticEntry::GetValue<std::string>() const { return GetValue<char>(); }
+    template<>
+    [[nodiscard]] constexpr auto StaticEntry::GetValue<std::string_view>() const { return GetValue<char>(); }
 
-                        if constexpr((bIsArray && STYLE.bCommasOnArrays) || (!bIsArray && STYLE.bCommasOnMaps))
-                            buffer.append(",\n");
-                        else
-                            buffer.push_back('\n');
-                    }
 
-                    if constexpr(!STYLE.bCommasOnLastElement)
-                        buffer.erase(buffer.size() - 2, 1);
 
-                    addTab(depth - 1);
-                    if constexpr(bIsArray)
-                        buffer.append("]\n");
-                    else
-                        buffer.append("}\n");
-                };
 
+    // Document that is parsed at compile time and stored in fixed size tables, so it costs nothing at startup and never allocates
+    // Paths are looked up through a perfect hash, "Get<"a.b">()" resolves the path at compile time and fails the build if it doesn't exist
+    // Comments aren't kept. Every byte of the content costs constant evaluation steps, big documents may need a higher limit (-fconstexpr-ops-limit, /constexpr:steps)
+    template<FixedString CONTENT>
+    class StaticDocument
+    {
+        struct Sizes
+        {
+            size_t entryCount = 0;
+            size_t textSize = 0;
+            size_t topLevelEntryCount = 0;
+            bool bParsed = false;
+        };
 
+        [[nodiscard]] static consteval bool ParseContent(detail::EntryVector& entries, size_t& topLevelEntryCount)
+        {
+            detail::EntryIndex index;
+        #if !FDF_NO_COMMENTS
+            std::string fileComment;
+            return detail::Utils<detail::DefaultErrorCallback, ParseOptions{.bSkipComments = true}>::ParseFileContent(CONTENT.View(), entries, index, fileComment, topLevelEntryCount);
+        #else
+            return detail::Utils<detail::DefaultErrorCallback, ParseOptions{.bSkipComments = true}>::ParseFileContent(CONTENT.View(), entries, index, topLevelEntryCount);
+        #endif
+        }
 
+        [[nodiscard]] static consteval size_t DigitCount(uint32_t value) noexcept
+        {
+            size_t count = 1;
+            for(; value >= 10; value /= 10)
+                count++;
+            return count;
+        }
 
-                while(it != order.end())
+        [[nodiscard]] static consteval Sizes Measure()
+        {
+            Sizes sizes;
+            detail::EntryVector entries;
+            sizes.bParsed = ParseContent(entries, sizes.topLevelEntryCount);
+            sizes.entryCount = entries.size();
+            for(const Entry& entry : entries)
+            {
+                sizes.textSize += entry.IsArrayElement()? DigitCount(entry.GetArrayIndex()) : entry.GetIdentifier().size();
+                if(entry.GetType() == Type::String || entry.GetType() == Type::Hex || entry.GetType() == Type::Timestamp)
+                    sizes.textSize += entry.GetValue<char>().size();
+            }
+            return sizes;
+        }
+
+        static constexpr Sizes SIZES = Measure();
+        static_assert(SIZES.bParsed, "Content of the static document can't be parsed");
+
+        struct Tables
+        {
+            std::array<detail::StaticEntryData, SIZES.entryCount> entries = {};
+            std::array<char, SIZES.textSize> text = {};
+            detail::PerfectHash<SIZES.entryCount> index;
+            bool bIndexed = false;
+        };
+
+        [[nodiscard]] static consteval Tables Build()
+        {
+            Tables tables;
+            detail::EntryVector entries;
+            size_t topLevelEntryCount = 0;
+            if(!ParseContent(entries, topLevelEntryCount))
+                return tables;
+
+            size_t textSize = 0;
+            auto appendText = [&](std::string_view view) -> uint32_t
+            {
+                std::ranges::copy(view, tables.text.begin() + textSize);
+                textSize += view.size();
+                return static_cast<uint32_t>(textSize - view.size());
+            };
+
+            std::vector<uint64_t> hashes(entries.size());
+            for(size_t i = 0; i < entries.size(); i++)
+            {
+                const Entry& entry = entries[i];
+                detail::StaticEntryData& data = tables.entries[i];
+                data.type = entry.GetType();
+                data.depth = entry.GetDepth();
+                data.bArrayElement = entry.IsArrayElement();
+                const size_t parentIndex = detail::EntryIndex::GetParentIndex(entries, i);
+                data.parentOffset = parentIndex != -1? static_cast<uint32_t>(i - parentIndex) : 0;
+                data.arrayIndex = static_cast<uint32_t>(entry.GetArrayIndex());
+
+                if(entry.IsArrayElement())
                 {
-                    const size_t index = *it;
+                    char digits[std::numeric_limits<uint32_t>::digits10 + 1] = {};
+                    const size_t digitCount = DigitCount(data.arrayIndex);
+                    for(uint32_t value = data.arrayIndex, d = digitCount; d-- > 0; value /= 10)
+                        digits[d] = static_cast<char>('0' + value % 10);
+                    data.identifierOffset = appendText(std::string_view(digits, digitCount));
+                    data.identifierSize = static_cast<uint8_t>(digitCount);
+                }
+                else
+                {
+                    data.identifierOffset = appendText(entry.GetIdentifier());
+                    data.identifierSize = static_cast<uint8_t>(entry.GetIdentifier().size());
+                }
 
-                    if(!entries[index].IsContainer())
+                switch(entry.GetType())
+                {
+                    case Type::Array:
+                    case Type::Map:
+                        data.size = static_cast<uint32_t>(entry.GetTopLevelChildCount());
+                        data.childCount = static_cast<uint32_t>(entry.GetChildCount());
+                        break;
+
+                    case Type::String:
+                    case Type::Hex:
+                    case Type::Timestamp:
+                        data.size = static_cast<uint32_t>(entry.GetValue<char>().size());
+                        data.stringOffset = appendText(entry.GetValue<char>());
+                        break;
+
+                    case Type::Bool:
                     {
-                        writeSimpleEntry(entries[index]);
-                        ++it;
+                        std::array<bool, detail::VARIANT_SIZE> values = {};
+                        const auto span = entry.GetValueUnsafe<bool>();
+                        std::ranges::copy(span, values.begin());
+                        data.values.b = values;
+                        data.size = static_cast<uint32_t>(span.size());
+                        break;
                     }
-                    else if(entries[index].type == Type::Array)
+                    case Type::Int:
                     {
-                        if(isShortArray(entries[index]))
-                        {
-                            writeEntryName(entries[index]);
-                            if constexpr(STYLE.bUseEqualSignForSingleLineArraysAndMaps)
-                                addEqualSign();
-
-                            writeSingleLine.template operator()<true>(1);
-                        }
-                        else
-                        {
-                            buffer.push_back('\n');
-                            writeEntryName(entries[index]);
-                            writeMultiLine.template operator()<true>(1);
-                        }
+                        std::array<int64_t, detail::VARIANT_64BIT_ELEMENT_COUNT> values = {};
+                        const auto span = entry.GetValueUnsafe<int64_t>();
+                        std::ranges::copy(span, values.begin());
+                        data.values.i = values;
+                        data.size = static_cast<uint32_t>(span.size());
+                        break;
                     }
-                    else if(entries[index].type == Type::Map)
+                    case Type::UInt:
+                    case Type::Version:
                     {
-                        if(isShortMap(entries[index]))
-                        {
-                            writeEntryName(entries[index]);
-                            if constexpr(STYLE.bUseEqualSignForSingleLineArraysAndMaps)
-                                addEqualSign();
-                            
-                            writeSingleLine.template operator()<false>(1);
-                        }
-                        else
-                        {
-                            buffer.push_back('\n');
-                            writeEntryName(entries[index]);
-                            writeMultiLine.template operator()<false>(1);
-                        }
+                        std::array<uint64_t, detail::VARIANT_64BIT_ELEMENT_COUNT> values = {};
+                        const auto span = entry.GetValueUnsafe<uint64_t>();
+                        std::ranges::copy(span, values.begin());
+                        data.values.u = values;
+                        data.size = static_cast<uint32_t>(span.size());
+                        break;
+                    }
+                    case Type::Float:
+                    {
+                        std::array<double, detail::VARIANT_64BIT_ELEMENT_COUNT> values = {};
+                        const auto span = entry.GetValueUnsafe<double>();
+                        std::ranges::copy(span, values.begin());
+                        data.values.f = values;
+                        data.size = static_cast<uint32_t>(span.size());
+                        break;
                     }
-                    else
-                        std::unreachable();
 
-                    buffer.push_back('\n');
+                    default:
+                        break;
                 }
 
-                const size_t lastNonNewLine = buffer.find_last_not_of('\n');
-                if(lastNonNewLine != std::string::npos)
+                // FNV-1a can be continued, so the hash of the full path is built from the hash of the parent
+                const std::string_view segment(tables.text.data() + data.identifierOffset, data.identifierSize);
+                hashes[i] = parentIndex != -1? detail::HashString(segment, detail::HashString(".", hashes[parentIndex])) : detail::HashString(segment);
+            }
+
+            tables.bIndexed = tables.index.Build(hashes);
+            return tables;
+        }
+
+        static constexpr Tables TABLES = Build();
+        static_assert(TABLES.bIndexed, "Perfect hash of the static document can't be built, two paths have the same hash");
+
+        // The candidate of the perfect hash is verified by walking its parent chain back to the top level
+        [[nodiscard]] static constexpr bool MatchesPath(size_t index, std::string_view path) noexcept
+        {
+            while(true)
+            {
+                const detail::StaticEntryData& entry = TABLES.entries[index];
+                const std::string_view segment(TABLES.text.data() + entry.identifierOffset, entry.identifierSize);
+                if(!path.ends_with(segment))
+                    return false;
+                path.remove_suffix(segment.size());
+
+                if(entry.parentOffset == 0)
+                    return path.empty();
+                if(!path.ends_with('.'))
+                    return false;
+                path.remove_suffix(1);
+                index -= entry.parentOffset;
+            }
+        }
+
+        [[nodiscard]] static constexpr size_t Find(std::string_view path) noexcept
+        {
+            if constexpr(SIZES.entryCount == 0)
+                return -1;
+
+            const size_t index = TABLES.index.Find(detail::HashString(path));
+            return index != -1 && MatchesPath(index, path)? index : -1;
+        }
+
+    public:
+        [[nodiscard]] static constexpr size_t GetEntryCount()         noexcept  { return SIZES.entryCount; }
+        [[nodiscard]] static constexpr size_t GetTopLevelEntryCount() noexcept  { return SIZES.topLevelEntryCount; }
+
+        // Invalid entry if "path" doesn't exist
+        [[nodiscard]] static constexpr StaticEntry GetEntry(std::string_view path) noexcept
+        {
+            const size_t index = Find(path);
+            return index != -1? StaticEntry(&TABLES.entries[index], TABLES.text.data()) : StaticEntry();
+        }
+        // Entries are stored in the same order as "IO::entries"
+        [[nodiscard]] static constexpr StaticEntry GetEntryAt(size_t index) noexcept
+        {
+            return index < SIZES.entryCount? StaticEntry(&TABLES.entries[index], TABLES.text.data()) : StaticEntry();
+        }
+
+        template<FixedString PATH>
+        [[nodiscard]] static constexpr StaticEntry Get() noexcept
+        {
+            constexpr size_t index = Find(PATH.View());
+            static_assert(index != -1, "Path doesn't exist in the static document");
+            return StaticEntry(&TABLES.entries[index], TABLES.text.data());
+        }
+    };
+}
+
+
+
+
+namespace fdf::detail
+{
+    // Entry of a "FrozenDocument", everything but the values in 24 bytes. Values and identifiers are offsets into the pools of the document
+    struct FrozenNode
+    {
+        Type type = Type::Invalid;
+        uint8_t depth = 0;
+        uint8_t identifierSize = 0;  // Array elements store their formatted position
+        bool bArrayElement = false;
+        uint32_t size = 0;  // Same as "Entry::size"
+        uint32_t parentOffset = 0;
+        uint32_t identifierOffset = 0;
+        uint32_t childCount = 0;  // Total child count of containers
+        uint32_t payload = 0;  // Containers: first direct child in "children", strings: offset into the text, other values: offset into the pool of their type
+    };
+
+    inline constexpr FrozenNode INVALID_FROZEN_NODE = {};
+}
+
+
+
+
+FDF_EXPORT namespace fdf
+{
+    // Read only copy of a document that is parsed once and read many times (see "IO::Freeze")
+    // Entries keep their order in 24 byte nodes, identifiers and strings are packed into one text blob and values are pooled by type
+    // Full identifiers are found through a perfect hash, a lookup reads one displacement and one slot and only verifies the candidate it lands on
+    // Comments aren't kept. Wrappers point into the document, they stay valid until it is moved or destroyed
+    class FrozenDocument
+    {
+    public:
+        FrozenDocument() = default;
+
+        // Throws if two entries have the same full identifier (possible after "IO::Combine"), or if the content doesn't fit 32 bit offsets
+        template<auto ERROR_CALLBACK>
+        explicit FrozenDocument(const IO<ERROR_CALLBACK>& io) : topLevelEntryCount(io.GetTopLevelEntryCount())
+        {
+            const size_t entryCount = io.GetEntryCount();
+
+            // Measured first, so every pool is allocated once
+            size_t textSize = 0;
+            size_t intCount = 0;
+            size_t uintCount = 0;
+            size_t floatCount = 0;
+            for(size_t i = 0; i < entryCount; i++)
+            {
+                const Entry& entry = io.GetEntry(i).Get();
+                textSize += entry.IsArrayElement()? FormatArrayIndex(entry.GetArrayIndex()).second : entry.GetIdentifier().size();
+                switch(entry.GetType())
                 {
-                    if constexpr(STYLE.bEmptyLineAtEOF)
-                        buffer.erase(lastNonNewLine + 2);
-                    else
-                        buffer.erase(lastNonNewLine + 1);
+                    case Type::String:
+                    case Type::Hex:
+                    case Type::Timestamp: textSize   += entry.GetValueUnsafe<char>().size();     break;
+                    case Type::Bool:      boolCount  += entry.GetValueUnsafe<bool>().size();     break;
+                    case Type::Int:       intCount   += entry.GetValueUnsafe<int64_t>().size();  break;
+                    case Type::UInt:
+                    case Type::Version:   uintCount  += entry.GetValueUnsafe<uint64_t>().size(); break;
+                    case Type::Float:     floatCount += entry.GetValueUnsafe<double>().size();   break;
+                    default:                                                                      break;
+                }
+            }
+            if(entryCount >= std::numeric_limits<uint32_t>::max() || textSize >= std::numeric_limits<uint32_t>::max())
+                throw std::runtime_error("Max size of a frozen document(4GB) is exceeded");
+
+            nodes.resize(entryCount);
+            children.resize(entryCount);
+            text.reserve(textSize);
+            ints.reserve(intCount);
+            uints.reserve(uintCount);
+            floats.reserve(floatCount);
+            bools = std::make_unique<bool[]>(boolCount);
+
+            size_t boolSize = 0;
+            size_t topLevelSize = 0;
+            uint32_t childEnd = static_cast<uint32_t>(topLevelEntryCount);
+            std::vector<uint64_t> hashes(entryCount);
+            for(size_t i = 0; i < entryCount; i++)
+            {
+                const Entry& entry = io.GetEntry(i).Get();
+                detail::FrozenNode& node = nodes[i];
+                node.type = entry.GetType();
+                node.depth = entry.GetDepth();
+                node.bArrayElement = entry.IsArrayElement();
+                const size_t parentIndex = io.GetEntry(i).GetParent().index;
+                node.parentOffset = parentIndex != -1? static_cast<uint32_t>(i - parentIndex) : 0;
+
+                const auto [digits, digitCount] = FormatArrayIndex(entry.GetArrayIndex());
+                const std::string_view segment = entry.IsArrayElement()? std::string_view(digits.data(), digitCount) : entry.GetIdentifier();
+                node.identifierOffset = static_cast<uint32_t>(text.size());
+                node.identifierSize = static_cast<uint8_t>(segment.size());
+                text.append(segment);
+
+                switch(node.type)
+                {
+                    case Type::Array:
+                    case Type::Map:
+                        node.size = static_cast<uint32_t>(entry.GetTopLevelChildCount());
+                        node.childCount = static_cast<uint32_t>(entry.GetChildCount());
+                        node.payload = childEnd;
+                        childEnd += node.size;
+                        break;
+
+                    case Type::String:
+                    case Type::Hex:
+                    case Type::Timestamp:
+                        node.size = static_cast<uint32_t>(entry.GetValueUnsafe<char>().size());
+                        node.payload = static_cast<uint32_t>(text.size());
+                        text.append(entry.GetValueUnsafe<char>());
+                        break;
+
+                    case Type::Bool:
+                        node.size = static_cast<uint32_t>(entry.GetValueUnsafe<bool>().size());
+                        node.payload = static_cast<uint32_t>(boolSize);
+                        boolSize = std::ranges::copy(entry.GetValueUnsafe<bool>(), bools.get() + boolSize).out - bools.get();
+                        break;
+                    case Type::Int:
+                        node.size = static_cast<uint32_t>(entry.GetValueUnsafe<int64_t>().size());
+                        node.payload = static_cast<uint32_t>(ints.size());
+                        ints.insert(ints.end(), entry.GetValueUnsafe<int64_t>().begin(), entry.GetValueUnsafe<int64_t>().end());
+                        break;
+                    case Type::UInt:
+                    case Type::Version:
+                        node.size = static_cast<uint32_t>(entry.GetValueUnsafe<uint64_t>().size());
+                        node.payload = static_cast<uint32_t>(uints.size());
+                        uints.insert(uints.end(), entry.GetValueUnsafe<uint64_t>().begin(), entry.GetValueUnsafe<uint64_t>().end());
+                        break;
+                    case Type::Float:
+                        node.size = static_cast<uint32_t>(entry.GetValueUnsafe<double>().size());
+                        node.payload = static_cast<uint32_t>(floats.size());
+                        floats.insert(floats.end(), entry.GetValueUnsafe<double>().begin(), entry.GetValueUnsafe<double>().end());
+                        break;
+
+                    default:
+                        break;
                 }
-            };
 
+                // Direct children of a container are consecutive, "payload" of the parent is moved back to their start below
+                if(parentIndex != -1)
+                    children[nodes[parentIndex].payload++] = static_cast<uint32_t>(i);
+                else
+                    children[topLevelSize++] = static_cast<uint32_t>(i);
+
+                // The hash of the full identifier is built from the hash of the parent, like the keys of "IO"
+                hashes[i] = detail::HashSegment(parentIndex != -1? hashes[parentIndex] : TOP_LEVEL_KEY, segment);
+            }
+            for(detail::FrozenNode& node : nodes)
+            {
+                if(node.type == Type::Array || node.type == Type::Map)
+                    node.payload -= node.size;
+            }
 
+            if(!index.Build(hashes))
+                throw std::runtime_error("Perfect hash of the frozen document can't be built, two entries have the same full identifier");
+        }
 
+    private:
+        [[nodiscard]] constexpr static auto Wrap(const FrozenDocument& document) noexcept  { return std::views::transform([&document](size_t i) { return EntryWrapper{document, i}; }); }
 
-            if constexpr(STYLE.bGroupSimilarTypes)
+    public:
+        // Same read API as "IO::EntryWrapper", "operator->" gives the wrapper itself so "entry->GetValue<int>()" keeps working
+        struct EntryWrapper
+        {
+            const FrozenDocument& document;
+            const size_t index = static_cast<size_t>(-1);
+
+            [[nodiscard]] constexpr const EntryWrapper& operator*()  const noexcept  { return *this; }
+                          constexpr const EntryWrapper* operator->() const noexcept  { return this; }
+            [[nodiscard]] constexpr const EntryWrapper& Get()        const noexcept  { return *this; }
+
+            [[nodiscard]] constexpr auto Iterator()         const noexcept  { return std::views::iota(index + 1, index + 1 + GetChildCount())                                       | Wrap(document); }
+            [[nodiscard]] constexpr auto TopLevelIterator() const noexcept  { return std::span(document.children).subspan(IsContainer()? Node().payload : 0, GetTopLevelChildCount()) | Wrap(document); }
+
+            [[nodiscard]] constexpr size_t GetEntryCount()         const noexcept  { return GetChildCount(); }
+            [[nodiscard]] constexpr size_t GetTopLevelEntryCount() const noexcept  { return GetTopLevelChildCount(); }
+
+        public:
+            [[nodiscard]] constexpr EntryWrapper GetEntry(size_t id) const noexcept
             {
-                std::vector<size_t> sortVec;
-                sortVec.reserve(entries.size());
+                return GetEntryCount() > id? EntryWrapper{document, id + index + 1} : EntryWrapper{document};
+            }
+            // Relative identifiers are hashed as a continuation of the full identifier of this entry
+            [[nodiscard]] constexpr EntryWrapper GetEntry(std::string_view identifier) const noexcept
+            {
+                return index != -1? document.GetEntry(document.Find(index, identifier, HashPath(identifier, document.HashEntry(index)))) : EntryWrapper{document};
+            }
+            [[nodiscard]] constexpr EntryWrapper GetEntry(const Path& path) const noexcept
+            {
+                return index != -1? document.GetEntry(document.Find(index, path.text, HashPath(path.segments, document.HashEntry(index)))) : EntryWrapper{document};
+            }
+            [[nodiscard]] constexpr EntryWrapper GetTopLevelEntry(size_t id) const noexcept
+            {
+                return GetTopLevelEntryCount() > id? EntryWrapper{document, document.children[Node().payload + id]} : EntryWrapper{document};
+            }
+
+            [[nodiscard]] constexpr EntryWrapper GetParent() const noexcept
+            {
+                return index != -1 && Node().parentOffset != 0? EntryWrapper{document, index - Node().parentOffset} : EntryWrapper{document};
+            }
+
+        public:
+            [[nodiscard]] constexpr std::string_view GetFullIdentifier(std::string& buffer) const
+            {
+                buffer.clear();
+                if(index != -1)
+                    AppendFullIdentifier(buffer);
+                return buffer;
+            }
+            [[nodiscard]] constexpr std::string_view GetParentIdentifier(std::string& buffer) const
+            {
+                return GetParent().GetFullIdentifier(buffer);
+            }
+            // Empty for array elements, like "Entry::GetIdentifier"
+            [[nodiscard]] constexpr std::string_view GetIdentifier() const noexcept
+            {
+                return IsArrayElement()? std::string_view() : GetSegment();
+            }
+            // Array elements are already formatted, "temp" is only taken to match "Entry::GetIdentifier"
+            [[nodiscard]] constexpr std::string_view GetIdentifier(std::string&) const noexcept
+            {
+                return GetSegment();
+            }
 
-                auto sortFn = [&entries, &sortVec](this auto self, uint8_t depth, size_t startIndex) -> void
+        public:
+            [[nodiscard]] constexpr size_t GetChildCount()         const noexcept  { return IsContainer()? Node().childCount : 0; }
+            [[nodiscard]] constexpr size_t GetTopLevelChildCount() const noexcept  { return IsContainer()? Node().size : 0; }
+
+            [[nodiscard]] constexpr uint8_t GetDepth()    const noexcept  { return Node().depth; }
+            [[nodiscard]] constexpr Type    GetType()     const noexcept  { return Node().type; }
+            [[nodiscard]] constexpr bool    IsValid()     const noexcept  { return Node().type != Type::Invalid; }
+            [[nodiscard]] constexpr bool    IsNull()      const noexcept  { return Node().type == Type::Null; }
+            [[nodiscard]] constexpr bool    IsNil()       const noexcept  { return IsNull(); }
+            [[nodiscard]] constexpr bool    IsContainer() const noexcept  { return Node().type == Type::Array || Node().type == Type::Map; }
+            [[nodiscard]] constexpr bool    HasValue()    const noexcept  { return IsValid() && !IsNull() && !IsContainer(); }
+
+            [[nodiscard]] constexpr bool IsArrayElement() const noexcept  { return Node().bArrayElement; }
+            [[nodiscard]] inline size_t GetArrayIndex() const noexcept
+            {
+                size_t arrayIndex = 0;
+                if(IsArrayElement())
+                    std::from_chars(GetSegment().data(), GetSegment().data() + GetSegment().size(), arrayIndex);
+                return arrayIndex;
+            }
+
+            // Same types and errors as "Entry::GetValue"
+            template<typename T>
+            [[nodiscard]] constexpr auto GetValue() const
+            {
+                const detail::FrozenNode& node = Node();
+                if constexpr(std::is_same_v<T, bool>)
                 {
-                    for(size_t i = startIndex; i < entries.size(); i++)
-                    {
-                        if(entries[i].depth < depth)
-                            break;
-                        if(entries[i].depth == depth && !entries[i].IsContainer())
-                            sortVec.push_back(i);
-                    }
+                    if(node.type != Type::Bool)
+                        throw std::runtime_error("Non matching type is not 'bool'");
+                    return std::span<const bool>(document.bools.get() + node.payload, node.size);
+                }
+                else if constexpr(std::is_same_v<T, int64_t> || std::is_same_v<T, int>)
+                {
+                    if(node.type != Type::Int)
+                        throw std::runtime_error("Non matching type is not 'int64_t'");
+                    return std::span<const int64_t>(document.ints).subspan(node.payload, node.size);
+                }
+                else if constexpr(std::is_same_v<T, uint64_t> || std::is_same_v<T, unsigned int>)
+                {
+                    if(node.type != Type::UInt && node.type != Type::Version)
+                        throw std::runtime_error("Non matching type is not 'uint64_t'");
+                    return std::span<const uint64_t>(document.uints).subspan(node.payload, node.size);
+                }
+                else if constexpr(std::is_same_v<T, double> || std::is_same_v<T, float>)
+                {
+                    if(node.type != Type::Float)
+                        throw std::runtime_error("Non matching type is not 'double'");
+                    return std::span<const double>(document.floats).subspan(node.payload, node.size);
+                }
+                else if constexpr(std::is_same_v<T, char> || std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+                {
+                    if(node.type != Type::String && node.type != Type::Hex && node.type != Type::Timestamp)
+                        throw std::runtime_error("Non matching type is not 'string'");
+                    return std::string_view(document.text).substr(node.payload, node.size);
+                }
+                else
+                {
+                    static_assert(!sizeof(T), "Type isn't supported, see \"Entry::GetValue\"");
+                }
+            }
 
-                    for(size_t i = startIndex; i < entries.size(); i++)
-                    {
-                        if(entries[i].depth < depth)
-                            break;
-                        if(entries[i].depth == depth && entries[i].type == Type::Array)
-                        {
-                            sortVec.push_back(i);
-                            self(depth + 1, i + 1);
-                        }
-                    }
+        private:
+            [[nodiscard]] constexpr const detail::FrozenNode& Node() const noexcept  { return index != -1? document.nodes[index] : detail::INVALID_FROZEN_NODE; }
+            [[nodiscard]] constexpr std::string_view GetSegment()    const noexcept  { return std::string_view(document.text).substr(Node().identifierOffset, Node().identifierSize); }
 
-                    for(size_t i = startIndex; i < entries.size(); i++)
-                    {
-                        if(entries[i].depth < depth)
-                            break;
-                        if(entries[i].depth == depth && entries[i].type == Type::Map)
-                        {
-                            sortVec.push_back(i);
-                            self(depth + 1, i + 1);
-                        }
-                    }
-                };
-                sortFn(0, 0);
-                writeLambda(sortVec);
+            constexpr void AppendFullIdentifier(std::string& buffer) const
+            {
+                if(Node().parentOffset != 0)
+                {
+                    GetParent().AppendFullIdentifier(buffer);
+                    buffer.push_back('.');
+                }
+                buffer.append(GetSegment());
             }
-            else
+        };
+
+    public:
+        [[nodiscard]] constexpr auto Iterator()         const noexcept  { return std::views::iota(static_cast<size_t>(0), nodes.size())         | Wrap(*this); }
+        [[nodiscard]] constexpr auto TopLevelIterator() const noexcept  { return std::span(children).subspan(0, topLevelEntryCount) | Wrap(*this); }
+
+        [[nodiscard]] constexpr size_t GetEntryCount()         const noexcept  { return nodes.size(); }
+        [[nodiscard]] constexpr size_t GetTopLevelEntryCount() const noexcept  { return topLevelEntryCount; }
+
+        // Bytes owned by the document, to compare with the entries of the "IO" it was frozen from
+        [[nodiscard]] constexpr size_t GetMemoryUsage() const noexcept
+        {
+            return nodes.capacity() * sizeof(detail::FrozenNode) + children.capacity() * sizeof(uint32_t) + text.capacity() + ints.capacity() * sizeof(int64_t) +
+                   uints.capacity() * sizeof(uint64_t) + floats.capacity() * sizeof(double) + boolCount * sizeof(bool) + (index.displacements.capacity() + index.slots.capacity()) * sizeof(uint32_t);
+        }
+
+    public:
+        [[nodiscard]] constexpr EntryWrapper GetEntry(size_t id) const noexcept
+        {
+            return GetEntryCount() > id? EntryWrapper{*this, id} : EntryWrapper{*this};
+        }
+        [[nodiscard]] constexpr EntryWrapper GetEntry(std::string_view identifier) const noexcept
+        {
+            return GetEntry(Find(static_cast<size_t>(-1), identifier, HashPath(identifier, TOP_LEVEL_KEY)));
+        }
+        // The segments of "path" are already hashed, only their keys are combined
+        [[nodiscard]] constexpr EntryWrapper GetEntry(const Path& path) const noexcept
+        {
+            return GetEntry(Find(static_cast<size_t>(-1), path.text, HashPath(path.segments, TOP_LEVEL_KEY)));
+        }
+        // The hash of "PATH" is computed at compile time
+        template<FixedString PATH>
+        [[nodiscard]] constexpr EntryWrapper Get() const noexcept
+        {
+            constexpr uint64_t HASH = HashPath(detail::PATH_SEGMENTS<PATH>, TOP_LEVEL_KEY);
+            return GetEntry(Find(static_cast<size_t>(-1), PATH.View(), HASH));
+        }
+        [[nodiscard]] constexpr EntryWrapper GetTopLevelEntry(size_t id) const noexcept
+        {
+            return GetTopLevelEntryCount() > id? EntryWrapper{*this, children[id]} : EntryWrapper{*this};
+        }
+
+    private:
+        // Array positions are stored as text too, so they are compared and hashed like identifiers
+        [[nodiscard]] inline static std::pair<std::array<char, std::numeric_limits<uint32_t>::digits10 + 1>, size_t> FormatArrayIndex(size_t arrayIndex) noexcept
+        {
+            std::array<char, std::numeric_limits<uint32_t>::digits10 + 1> digits = {};
+            return {digits, static_cast<size_t>(std::to_chars(digits.data(), digits.data() + digits.size(), arrayIndex).ptr - digits.data())};
+        }
+
+        [[nodiscard]] constexpr uint64_t HashEntry(size_t entryIndex) const noexcept
+        {
+            const detail::FrozenNode& node = nodes[entryIndex];
+            const std::string_view segment = std::string_view(text).substr(node.identifierOffset, node.identifierSize);
+            return detail::HashSegment(node.parentOffset != 0? HashEntry(entryIndex - node.parentOffset) : TOP_LEVEL_KEY, segment);
+        }
+
+        // Each segment is mixed into the key of its parent, starting from "key"
+        [[nodiscard]] constexpr static uint64_t HashPath(std::string_view path, uint64_t key) noexcept
+        {
+            for(size_t offset = 0; ; )
             {
-                writeLambda(std::views::iota(static_cast<size_t>(0), entries.size()));
+                const size_t end = std::min(path.find('.', offset), path.size());
+                key = detail::HashSegment(key, path.substr(offset, end - offset));
+                if(end == path.size())
+                    return key;
+                offset = end + 1;
             }
         }
-    };
-}
+        [[nodiscard]] constexpr static uint64_t HashPath(std::span<const detail::PathSegment> segments, uint64_t key) noexcept
+        {
+            for(const detail::PathSegment& segment : segments)
+                key = detail::HashKey(key, segment.hash);
+            return key;
+        }
 
+        // The candidate of the perfect hash is verified by walking its parent chain back to "baseIndex" (-1 for full identifiers)
+        [[nodiscard]] constexpr bool MatchesPath(size_t entryIndex, std::string_view path, size_t baseIndex) const noexcept
+        {
+            while(true)
+            {
+                const detail::FrozenNode& node = nodes[entryIndex];
+                const std::string_view segment = std::string_view(text).substr(node.identifierOffset, node.identifierSize);
+                if(!path.ends_with(segment))
+                    return false;
+                path.remove_suffix(segment.size());
 
+                const size_t parentIndex = node.parentOffset != 0? entryIndex - node.parentOffset : static_cast<size_t>(-1);
+                if(path.empty())
+                    return parentIndex == baseIndex;
+                if(parentIndex == -1 || parentIndex == baseIndex || !path.ends_with('.'))
+                    return false;
+                path.remove_suffix(1);
+                entryIndex = parentIndex;
+            }
+        }
 
+        [[nodiscard]] constexpr size_t Find(size_t baseIndex, std::string_view path, uint64_t hash) const noexcept
+        {
+            const size_t entryIndex = index.Find(hash);
+            return entryIndex != -1 && MatchesPath(entryIndex, path, baseIndex)? entryIndex : static_cast<size_t>(-1);
+        }
 
+    private:
+        static constexpr uint64_t TOP_LEVEL_KEY = static_cast<uint64_t>(-1);  // Parent key of top level entries, as in "IO"
+
+        std::vector<detail::FrozenNode> nodes;
+        std::vector<uint32_t> children;  // Top level entries first, then the direct children of each container
+        std::string text;  // Identifiers (and formatted array positions) and strings
+        std::vector<int64_t> ints;
+        std::vector<uint64_t> uints;  // Versions too
+        std::vector<double> floats;
+        std::unique_ptr<bool[]> bools;
+        size_t boolCount = 0;
+        detail::PerfectHash<> index;
+        size_t topLevelEntryCount = 0;
+    };
 
+    template<auto ERROR_CALLBACK> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
+    inline FrozenDocument IO<ERROR_CALLBACK>::Freeze() const
+    {
+        return FrozenDocument(*this);
+    }
+}
 
 
 
 
 
+namespace fdf::detail
+{
+    template<typename T>
+    struct IsStdArray : std::false_type  { };
+    template<typename T, size_t N>
+    struct IsStdArray<std::array<T, N>> : std::true_type  { };
 
+    template<typename T>
+    struct IsStdVector : std::false_type  { };
+    template<typename T, typename ALLOCATOR>
+    struct IsStdVector<std::vector<T, ALLOCATOR>> : std::true_type  { };
 
+    template<typename T>
+    struct IsStdOptional : std::false_type  { };
+    template<typename T>
+    struct IsStdOptional<std::optional<T>> : std::true_type  { };
 
-FDF_EXPORT namespace fdf
-{
-    template<auto ERROR_CALLBACK> requires(detail::IsValidErrorCallback<decltype(ERROR_CALLBACK)>)
-    class IO
-    {
-        friend struct detail::Test;
 
-    public:
-        constexpr IO() noexcept = default;
+    // Values like "1920x1080" have more than one component, returns 0 for values without components (strings, null, containers)
+    [[nodiscard]] constexpr size_t GetComponentCount(const Entry& entry)
+    {
+        switch(entry.GetType())
+        {
+            case Type::Bool:  return entry.GetValueUnsafe<bool>().size();
+            case Type::Int:   return entry.GetValueUnsafe<int64_t>().size();
+            case Type::UInt:  return entry.GetValueUnsafe<uint64_t>().size();
+            case Type::Float: return entry.GetValueUnsafe<double>().size();
+            default:          return 0;
+        }
+    }
 
-    public:
-        [[nodiscard]] constexpr bool Parse(std::string_view content, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty) noexcept
+    // Integers are only converted if they fit, floating point members also take integers
+    template<typename T>
+    [[nodiscard]] constexpr bool ConvertComponent(const Entry& entry, size_t component, T& out)
+    {
+        const Type type = entry.GetType();
+        if constexpr(std::is_same_v<T, bool>)
         {
-            IO other;
-        #if !FDF_NO_COMMENTS
-            if(!detail::Utils<ERROR_CALLBACK>::ParseFileContent(content, other.entries, other.fileComment, topLevelEntryCount))
-                return false;
-        #else
-            if(!detail::Utils<ERROR_CALLBACK>::ParseFileContent(content, other.entries, topLevelEntryCount))
+            if(type != Type::Bool)
                 return false;
-        #endif
-
-            return Combine(other, fileCommentCombineStrategy);
+            out = entry.GetValueUnsafe<bool>()[component];
+            return true;
         }
-        [[nodiscard]] inline bool Parse(std::filesystem::path filepath, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty) noexcept
+        else if constexpr(std::is_integral_v<T>)
         {
-            if(!std::filesystem::exists(filepath) || !std::filesystem::is_regular_file(filepath))
-                return false;
-
-            std::ifstream file(filepath);
-            if(!file)
-                return false;
-
-            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-            IO other;
-        #if !FDF_NO_COMMENTS
-            if(!detail::Utils<ERROR_CALLBACK>::ParseFileContent(content, other.entries, other.fileComment, topLevelEntryCount))
-                return false;
-        #else
-            if(!detail::Utils<ERROR_CALLBACK>::ParseFileContent(content, other.entries, topLevelEntryCount))
+            if(type == Type::Int && std::in_range<T>(entry.GetValueUnsafe<int64_t>()[component]))
+                out = static_cast<T>(entry.GetValueUnsafe<int64_t>()[component]);
+            else if(type == Type::UInt && std::in_range<T>(entry.GetValueUnsafe<uint64_t>()[component]))
+                out = static_cast<T>(entry.GetValueUnsafe<uint64_t>()[component]);
+            else
                 return false;
-        #endif
-
-            return Combine(other, fileCommentCombineStrategy);
+            return true;
         }
-        template<auto OTHER_ERROR_CALLBACK>
-        [[nodiscard]] constexpr bool Combine(const IO<OTHER_ERROR_CALLBACK>& other, CommentCombineStrategy fileCommentCombineStrategy = CommentCombineStrategy::UseNewIfExistingIsEmpty) noexcept
+        else if constexpr(std::is_floating_point_v<T>)
         {
-        #if !FDF_NO_COMMENTS
-            switch(fileCommentCombineStrategy)
+            switch(type)
             {
-                case CommentCombineStrategy::UseExisting: break;
-                case CommentCombineStrategy::UseNew: fileComment = other.fileComment; break;
-                case CommentCombineStrategy::UseNewIfExistingIsEmpty: 
-                    if(fileComment.empty())
-                        fileComment = other.fileComment;
-                    break;
-                case CommentCombineStrategy::Merge:
-                    if(fileComment.empty())
-                        fileComment = other.fileComment;
-                    else if(!other.fileComment.empty())
-                        fileComment = fileComment + '\n' + other.fileComment;
-                    break;
-                case CommentCombineStrategy::Clear: fileComment.clear(); break;
-                default: std::unreachable();
+                case Type::Float: out = static_cast<T>(entry.GetValueUnsafe<double>()[component]);   return true;
+                case Type::Int:   out = static_cast<T>(entry.GetValueUnsafe<int64_t>()[component]);  return true;
+                case Type::UInt:  out = static_cast<T>(entry.GetValueUnsafe<uint64_t>()[component]); return true;
+                default:          return false;
             }
-        #endif
+        }
+        else
+            return false;
+    }
 
-            // TODO: We assume there is no name collision
-            entries.insert(entries.end(), other.entries.begin(), other.entries.end());
-            topLevelEntryCount += other.topLevelEntryCount;
+    // Members are only written if the whole value fits, vectors are filled from array children by the caller
+    template<typename T>
+    [[nodiscard]] constexpr bool AssignValue(const Entry& entry, T& member)
+    {
+        if constexpr(IsStdOptional<T>::value)
+        {
+            if(entry.IsNull())
+            {
+                member.reset();
+                return true;
+            }
+
+            typename T::value_type value{};
+            if(!AssignValue(entry, value))
+                return false;
+            member = std::move(value);
             return true;
         }
-
-    public:
-        template<Style STYLE = {}>
-        constexpr void WriteToBuffer(std::string& buffer) const noexcept
+        else if constexpr(std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
         {
-        #if !FDF_NO_COMMENTS
-            detail::Utils<ERROR_CALLBACK>::template WriteFileContent<STYLE>(buffer, entries, fileComment);
-        #else
-            detail::Utils<ERROR_CALLBACK>::template WriteFileContent<STYLE>(buffer, entries);
-        #endif
+            if(entry.GetType() != Type::String && entry.GetType() != Type::Hex && entry.GetType() != Type::Timestamp)
+                return false;
+            member = T(entry.GetValueUnsafe<char>());
+            return true;
         }
-        template<Style STYLE = {}>
-        [[nodiscard]] inline bool WriteToFile(std::filesystem::path filepath, bool bCreateIfNotExists = true) const noexcept
+        else if constexpr(IsStdArray<T>::value)
         {
-            if(!std::filesystem::exists(filepath))
+            T value{};
+            if(GetComponentCount(entry) != value.size())
+                return false;
+            for(size_t i = 0; i < value.size(); i++)
             {
-                if(!bCreateIfNotExists)
+                if(!ConvertComponent(entry, i, value[i]))
                     return false;
-
-                auto parentDir = filepath.parent_path();
-                if(!parentDir.empty() && !std::filesystem::exists(parentDir))
-                {
-                    std::error_code ec;
-                    std::filesystem::create_directories(parentDir, ec);
-                    if(ec)
-                        return false;
-                }
-            }
-            else if(!std::filesystem::is_regular_file(filepath))
-            {
-                return false;
             }
+            member = value;
+            return true;
+        }
+        else if constexpr(std::is_arithmetic_v<T>)
+            return GetComponentCount(entry) == 1 && ConvertComponent(entry, 0, member);
+        else
+        {
+            static_assert(IsStdVector<T>::value, "Type of the member can't be bound");
+            return false;
+        }
+    }
+}
 
-            std::ofstream file(filepath);
-            if(!file)
-                return false;
 
-            std::string buffer;
-            WriteToBuffer(buffer);
 
-            file << buffer;
-            return static_cast<bool>(file);
-        }
 
-    private:
-        #define REQ requires(!IS_CONST)
-        template<bool IS_CONST>
-        struct EntryWrapper
-        { 
-            std::conditional_t<IS_CONST, const std::vector<Entry>&, std::vector<Entry>&> entries;
-            const size_t index = static_cast<size_t>(-1);
+FDF_EXPORT namespace fdf
+{
+    // Full path of an entry and the member it is read into, see "Binding"
+    template<FixedString KEY_, auto MEMBER_>
+    struct Field
+    {
+        static constexpr FixedString KEY = KEY_;
+        static constexpr auto MEMBER = MEMBER_;
+    };
 
-            [[nodiscard]] constexpr bool IsMutable() const noexcept  { return !IS_CONST; }
-            
-            [[nodiscard]] constexpr       Entry& operator*()        noexcept REQ  { return index != -1?  entries[index] :  Entry::INVALID; }
-            [[nodiscard]] constexpr const Entry& operator*()  const noexcept      { return index != -1?  entries[index] :  Entry::INVALID; }
-                          constexpr       Entry* operator->()       noexcept REQ  { return index != -1? &entries[index] : &Entry::INVALID; }
-                          constexpr const Entry* operator->() const noexcept      { return index != -1? &entries[index] : &Entry::INVALID; }
 
-            [[nodiscard]] constexpr       Entry& Get()       noexcept REQ  { return index != -1?  entries[index] :  Entry::INVALID; }
-            [[nodiscard]] constexpr const Entry& Get() const noexcept      { return index != -1?  entries[index] :  Entry::INVALID; }
+    // Fills the members of "T" described by "FIELDS" in a single pass over a document, instead of looking up each path on its own:
+    //     using SettingsBinding = fdf::Binding<Settings, fdf::Field<"name", &Settings::name>, fdf::Field<"window.size", &Settings::size>>;
+    //     SettingsBinding::Read(io, settings);
+    // Paths are hashed the same way while walking the entries and matched through a perfect hash built at compile time
+    // Members can be bool, numbers, std::string, std::string_view, std::array (components of values like 1920x1080), std::vector (elements of arrays)
+    // and std::optional of them (null). Nothing throws, a field that is missing or doesn't match the type of its member leaves the member untouched
+    // (except vectors read with "Read(content)", which are filled while the elements arrive)
+    template<typename T, typename... FIELDS>
+    class Binding
+    {
+        static constexpr size_t FIELD_COUNT = sizeof...(FIELDS);
+        static_assert(FIELD_COUNT > 0, "Binding needs at least one field");
 
-            [[nodiscard]] constexpr auto Iterator()               noexcept REQ  { return Span() | ChildFilter()                    | Wrap(); }
-            [[nodiscard]] constexpr auto Iterator()         const noexcept      { return Span() | ChildFilter()                    | Wrap(); }
-            [[nodiscard]] constexpr auto TopLevelIterator()       noexcept REQ  { return Span() | ChildFilter() | TopLevelFilter() | Wrap(); }
-            [[nodiscard]] constexpr auto TopLevelIterator() const noexcept      { return Span() | ChildFilter() | TopLevelFilter() | Wrap(); }
+        static constexpr std::array<std::string_view, FIELD_COUNT> KEYS = { FIELDS::KEY.View()... };
+        static constexpr std::array<uint64_t, FIELD_COUNT> HASHES = { detail::HashString(FIELDS::KEY.View())... };
 
-            [[nodiscard]] constexpr size_t GetEntryCount()         const noexcept  { return entries[index].IsContainer()? entries[index].data.u[0] : 0; }
-            [[nodiscard]] constexpr size_t GetTopLevelEntryCount() const noexcept  { return entries[index].IsContainer()? entries[index].size : 0; }
+        [[nodiscard]] static consteval std::pair<detail::PerfectHash<FIELD_COUNT>, bool> BuildIndex()
+        {
+            detail::PerfectHash<FIELD_COUNT> index;
+            const bool bBuilt = index.Build(HASHES);
+            return { index, bBuilt };
+        }
+        static constexpr auto INDEX = BuildIndex();
+        static_assert(INDEX.second, "Two fields of the binding have the same key");
 
-        public:
-            // Call const versions, so we don't duplicate the code
-            [[nodiscard]] constexpr EntryWrapper<false> GetEntryMutable(size_t id) noexcept REQ
-            {
-                return {entries, GetEntry(id).index};
-            }
-            [[nodiscard]] constexpr EntryWrapper<false> GetEntryMutable(std::string_view identifier) noexcept REQ
-            {
-                return {entries, GetEntry(identifier).index};
-            }
-            [[nodiscard]] constexpr EntryWrapper<false> GetTopLevelEntryMutable(size_t id) noexcept REQ
+        // Paths of the containers that hold the fields, only their children are visited
+        [[nodiscard]] static consteval size_t CountParents()
+        {
+            size_t count = 0;
+            for(const std::string_view key : KEYS)
+                count += std::ranges::count(key, '.');
+            return count;
+        }
+        [[nodiscard]] static consteval std::array<uint64_t, CountParents()> BuildParents()
+        {
+            std::array<uint64_t, CountParents()> parents = {};
+            size_t count = 0;
+            for(const std::string_view key : KEYS)
             {
-                return {entries, GetTopLevelEntry(id).index};
+                for(size_t dot = key.find('.'); dot != std::string_view::npos; dot = key.find('.', dot + 1))
+                    parents[count++] = detail::HashString(key.substr(0, dot));
             }
+            std::ranges::sort(parents);
+            return parents;
+        }
+        static constexpr auto PARENTS = BuildParents();
 
-            [[nodiscard]] constexpr EntryWrapper<true> GetEntry(size_t id) const noexcept
-            {
-                return GetEntryCount() > id? EntryWrapper<true>{entries, id + index + 1} : EntryWrapper<true>{entries};
-            }
-            [[nodiscard]] constexpr EntryWrapper<true> GetEntry(std::string_view identifier) const noexcept
+        [[nodiscard]] static constexpr size_t Find(uint64_t hash) noexcept
+        {
+            const size_t field = INDEX.first.Find(hash);
+            return field != -1 && HASHES[field] == hash? field : -1;
+        }
+        [[nodiscard]] static constexpr bool IsParent(uint64_t hash) noexcept
+        {
+            return std::ranges::binary_search(PARENTS, hash);
+        }
+
+        // Calls "function" with the member of the field known at runtime
+        template<typename FUNCTION>
+        static constexpr bool VisitMember(size_t field, T& object, FUNCTION&& function)
+        {
+            return [&]<size_t... I>(std::index_sequence<I...>)
             {
-                const size_t id = detail::Utils<ERROR_CALLBACK>::FindChildEntry(entries, Get().fullIdentifier, identifier, Get().depth + 1 + std::ranges::count(identifier, '.'), index + 1);
-                return entries.size() > id? EntryWrapper<true>{entries, id} : EntryWrapper<true>{entries};
-            }
-            [[nodiscard]] constexpr EntryWrapper<true> GetTopLevelEntry(size_t id) const noexcept
+                bool bResult = false;
+                ((I == field? (bResult = function(object.*FIELDS::MEMBER), true) : false) || ...);
+                return bResult;
+            }(std::index_sequence_for<FIELDS...>());
+        }
+
+    public:
+        // True if every field is found and fits its member
+        template<auto ERROR_CALLBACK>
+        [[nodiscard]] static constexpr bool Read(const IO<ERROR_CALLBACK>& io, T& object)
+        {
+            std::array<bool, FIELD_COUNT> bFound = {};
+            size_t foundCount = 0;
+            bool bResult = true;
+
+            std::array<uint64_t, std::numeric_limits<uint8_t>::max() + 1> hashes = {};  // Hash of the path of the last entry at each depth
+            std::string identifier;
+            std::string temp;
+            for(size_t i = 0; i < io.GetEntryCount() && foundCount < FIELD_COUNT;)
             {
-                size_t currentTopLevelCount = 0;
-                for(size_t i = index + 1; i < entries.size() && currentTopLevelCount < GetTopLevelEntryCount(); i++)
+                const auto entry = io.GetEntry(i);
+                const uint8_t depth = entry->GetDepth();
+                const std::string_view segment = entry->GetIdentifier(temp);
+                hashes[depth] = depth != 0? detail::HashString(segment, detail::HashString(".", hashes[depth - 1])) : detail::HashString(segment);
+
+                const size_t field = Find(hashes[depth]);
+                if(field != -1 && !bFound[field] && entry.GetFullIdentifier(identifier) == KEYS[field])
                 {
-                    if(entries[i].depth == entries[index].depth + 1)
-                    {
-                        if(id == currentTopLevelCount++)
-                            return {entries, i};
-                    }
+                    bFound[field] = true;
+                    foundCount++;
+                    bResult = VisitMember(field, object, [&]<typename MEMBER>(MEMBER& member) { return AssignEntry(io, i, member); }) && bResult;
                 }
 
-                return {entries};
+                // Containers that don't hold any field are skipped with their children
+                i += entry->IsContainer() && !IsParent(hashes[depth])? 1 + entry->GetChildCount() : 1;
             }
-        
-        private:
-            constexpr auto Span()       noexcept REQ  { return index != -1? std::span(entries.data() + index + 1, entries[index].IsContainer()? entries[index].data.u[0] : 0) : std::span<Entry>(); }
-            constexpr auto Span() const noexcept      { return index != -1? std::span(entries.data() + index + 1, entries[index].IsContainer()? entries[index].data.u[0] : 0) : std::span<Entry>(); }
-
-            constexpr auto ChildFilter()    const noexcept  { return std::views::take_while([this](const Entry& e) { return entries[&e - entries.data()].depth > entries[index].depth; }); }
-            constexpr auto TopLevelFilter() const noexcept  { return std::views::filter(    [this](const Entry& e) { return e.depth == entries[index].depth + 1; }); }
-
-            constexpr auto Wrap()       noexcept REQ  { return std::views::transform([this](      Entry& e) { return EntryWrapper<false>{entries, static_cast<size_t>(&e - entries.data())}; }); }
-            constexpr auto Wrap() const noexcept      { return std::views::transform([this](const Entry& e) { return EntryWrapper<true >{entries, static_cast<size_t>(&e - entries.data())}; }); }
-        };
-        #undef REQ
-        
-        constexpr static auto TopLevelFilter() noexcept  { return std::views::filter([] (const Entry& e) { return e.depth == 0; }); }
-
-        constexpr auto Wrap()       noexcept  { return std::views::transform([this](      Entry& e) { return EntryWrapper<false>{entries, static_cast<size_t>(&e - entries.data())}; }); }
-        constexpr auto Wrap() const noexcept  { return std::views::transform([this](const Entry& e) { return EntryWrapper<true >{entries, static_cast<size_t>(&e - entries.data())}; }); }
-
-    public:
-        [[nodiscard]] constexpr auto Iterator()               noexcept  { return entries                    | Wrap(); }
-        [[nodiscard]] constexpr auto Iterator()         const noexcept  { return entries                    | Wrap(); }
-        [[nodiscard]] constexpr auto TopLevelIterator()       noexcept  { return entries | TopLevelFilter() | Wrap(); }
-        [[nodiscard]] constexpr auto TopLevelIterator() const noexcept  { return entries | TopLevelFilter() | Wrap(); }
-
-        [[nodiscard]] constexpr size_t GetEntryCount()         const noexcept  { return entries.size(); }
-        [[nodiscard]] constexpr size_t GetTopLevelEntryCount() const noexcept  { return topLevelEntryCount; }
 
-    public:
-        // Call const versions, so we don't duplicate the code
-        [[nodiscard]] constexpr EntryWrapper<false> GetEntryMutable(size_t id) noexcept
-        {
-            return {entries, GetEntry(id).index};
-        }
-        [[nodiscard]] constexpr EntryWrapper<false> GetEntryMutable(std::string_view identifier) noexcept
-        {
-            return {entries, GetEntry(identifier).index};
-        }
-        [[nodiscard]] constexpr EntryWrapper<false> GetTopLevelEntryMutable(size_t id) noexcept
-        {
-            return {entries, GetTopLevelEntry(id).index};
+            return bResult && foundCount == FIELD_COUNT;
         }
 
-        [[nodiscard]] constexpr EntryWrapper<true> GetEntry(size_t id) const noexcept
+        // Reads the fields straight from "content" through "ParseEvents", no entries are built. Members can't be std::string_view, nothing outlives the parsing
+        template<auto ERROR_CALLBACK = detail::DefaultErrorCallback>
+        [[nodiscard]] static constexpr bool Read(std::string_view content, T& object)
         {
-            return GetEntryCount() > id? EntryWrapper<true>{entries, id} : EntryWrapper<true>{entries};
+            static_assert(((!std::is_same_v<std::remove_cvref_t<decltype(std::declval<T&>().*FIELDS::MEMBER)>, std::string_view>) && ...), "std::string_view members can only be read from an IO");
+
+            EventReader reader{ .object = object };
+            return ParseEvents<ERROR_CALLBACK>(content, reader) && reader.bResult && reader.foundCount == FIELD_COUNT;
         }
-        [[nodiscard]] constexpr EntryWrapper<true> GetEntry(std::string_view identifier) const noexcept
+
+    private:
+        template<auto ERROR_CALLBACK, typename MEMBER>
+        [[nodiscard]] static constexpr bool AssignEntry(const IO<ERROR_CALLBACK>& io, size_t index, MEMBER& member)
         {
-            const size_t id = detail::Utils<ERROR_CALLBACK>::FindEntry(entries, identifier, std::ranges::count(identifier, '.'), 0);
-            return GetEntry(id);
+            const auto entry = io.GetEntry(index);
+            if constexpr(detail::IsStdVector<MEMBER>::value)
+            {
+                if(entry->GetType() != Type::Array)
+                    return false;
+
+                MEMBER elements;
+                elements.reserve(entry->GetTopLevelChildCount());
+                for(size_t i = index + 1; i < index + 1 + entry->GetChildCount(); i += 1 + io.GetEntry(i)->GetChildCount())
+                {
+                    if(!detail::AssignValue(*io.GetEntry(i), elements.emplace_back()))
+                        return false;
+                }
+                member = std::move(elements);
+                return true;
+            }
+            else
+                return detail::AssignValue(*entry, member);
         }
-        [[nodiscard]] constexpr EntryWrapper<true> GetTopLevelEntry(size_t id) const noexcept
+
+        // Handler of "ParseEvents", tracks the path of the current entry in text since there is no entry to take it from
+        struct EventReader
         {
-            size_t currentTopLevelCount = 0;
-            for(size_t i = 0; i < entries.size() && currentTopLevelCount < GetTopLevelEntryCount(); i++)
+            struct Container
+            {
+                size_t pathSize = 0;  // Size of "path" before the container was entered
+                bool bArray = false;
+                uint32_t nextIndex = 0;
+                size_t vectorField = static_cast<size_t>(-1);  // Field the elements are collected into
+            };
+
+            // Appends the segment of the entry that begins to "path", returns its field or -1
+            [[nodiscard]] constexpr size_t Enter()
+            {
+                if(!containers.empty())
+                    path.push_back('.');
+                if(!containers.empty() && containers.back().bArray)
+                {
+                    char indexBuffer[std::numeric_limits<uint32_t>::digits10 + 1] = {};
+                    path.append(indexBuffer, std::to_chars(indexBuffer, std::end(indexBuffer), containers.back().nextIndex++).ptr);
+                }
+                else
+                    path.append(key);
+
+                const size_t field = Find(detail::HashString(path));
+                if(field == -1 || bFound[field] || path != KEYS[field])
+                    return -1;
+
+                bFound[field] = true;
+                foundCount++;
+                return field;
+            }
+
+            constexpr void OnKey(std::string_view identifier)  { key = identifier; }
+
+            constexpr void OnValue(const Entry& value)
             {
-                if(entries[i].depth == 0)
+                const size_t pathSize = path.size();
+                const size_t field = Enter();
+                if(!containers.empty() && containers.back().vectorField != -1)
+                {
+                    bResult = VisitMember(containers.back().vectorField, object, [&]<typename MEMBER>(MEMBER& member)
+                    {
+                        if constexpr(detail::IsStdVector<MEMBER>::value)
+                            return detail::AssignValue(value, member.emplace_back());
+                        return false;
+                    }) && bResult;
+                }
+                if(field != -1)
                 {
-                    if(id == currentTopLevelCount++)
-                        return {entries, i};
+                    bResult = VisitMember(field, object, [&]<typename MEMBER>(MEMBER& member)
+                    {
+                        if constexpr(!detail::IsStdVector<MEMBER>::value)
+                            return detail::AssignValue(value, member);
+                        return false;
+                    }) && bResult;
                 }
+                path.resize(pathSize);
             }
 
-            return {entries};
-        }
+            constexpr void OnBegin(bool bArray)
+            {
+                const size_t pathSize = path.size();
+                if(!containers.empty() && containers.back().vectorField != -1)
+                    bResult = false;  // Elements of bound vectors have to be values
+                const size_t field = Enter();
 
-    private:
-        std::vector<Entry> entries;
-        size_t topLevelEntryCount = 0;
+                size_t vectorField = static_cast<size_t>(-1);
+                if(field != -1)
+                {
+                    const bool bVector = VisitMember(field, object, [&]<typename MEMBER>(MEMBER& member)
+                    {
+                        if constexpr(detail::IsStdVector<MEMBER>::value)
+                            member.clear();
+                        return detail::IsStdVector<MEMBER>::value;
+                    });
+                    vectorField = bVector && bArray? field : static_cast<size_t>(-1);
+                    bResult = vectorField != -1 && bResult;
+                }
+                containers.push_back({ .pathSize = pathSize, .bArray = bArray, .vectorField = vectorField });
+            }
+            constexpr void OnBeginMap()    { OnBegin(false); }
+            constexpr void OnBeginArray()  { OnBegin(true); }
 
-#if !FDF_NO_COMMENTS
-    public:
-        std::string fileComment;
-#endif
+            constexpr void OnEnd()
+            {
+                path.resize(containers.back().pathSize);
+                containers.pop_back();
+            }
+            constexpr void OnEndMap()    { OnEnd(); }
+            constexpr void OnEndArray()  { OnEnd(); }
+
+            T& object;
+            std::array<bool, FIELD_COUNT> bFound = {};
+            size_t foundCount = 0;
+            bool bResult = true;
+
+            std::string key;
+            std::string path;
+            std::vector<Container> containers;
+        };
     };
 }
 
@@ -2927,6 +8208,11 @@ FDF_EXPORT namespace fdf
 
 
 #undef FDF_EXPORT
+#undef FDF_SIMD_AVX2
+#undef FDF_SIMD_SSE2
+#undef FDF_SIMD_NEON
+#undef FDF_MMAP
+#undef FDF_INOTIFY
 #undef FDF_CHECK_TOKEN
 #undef FDF_CHECK_TOKEN_FOR_EOF
 #undef FDF_FORWARD_ERROR
@@ -1,5 +1,22 @@
 
 module;
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #include <sys/inotify.h>
+    #include <sys/eventfd.h>
+    #include <poll.h>
+#endif
+
 export module fdf;
 import std;
 import std.compat;
@@ -22,10 +22,8 @@ namespace fdf::detail
         "EndOfFile       ",
         "Comment         ",
 
-        "At              ",
         "Equal           ",
         "Comma           ",
-        "Colon           ",
 
         "CurlyBraceOpen  ",
         "CurlyBraceClose ",
@@ -44,6 +42,7 @@ namespace fdf::detail
 
         "EvaluateLiteral "
     };
+    static_assert(std::size(TOKEN_TYPE_TO_STRING) == static_cast<size_t>(TokenType::ValueLiteral_End) + 1);
 
     constexpr std::string_view ENTRY_TYPE_TO_STRING[] =
     {
@@ -85,6 +84,15 @@ namespace fdf::detail
     size_t longestFilename = 0;
     std::string output;
 
+    constexpr char STATIC_CONTENT[] = R"(
+name = "fdf"
+version = 0.1.0
+window { size = 1920x1080, scale = 1.5, fullscreen = false, title = "Main \"window\"" }
+files[ "include/fdf.h", "src/fdf.cpp" ]
+limits[ 18446744073709551615, 0xFF00FF#, 2024-12-24, true ]
+rounding[ 0.30000000000000004440892098500626, 123456789012345678901234567890.5, 1.00000000000000011102230246251565404236316680908203125, 1.000000000000000111022302462515654042363166809082031250001 ]
+)";
+
 
 
 
@@ -138,7 +146,7 @@ namespace fdf::detail
             return static_cast<bool>(oFile);
         }
 
-        static bool PrintAllEntries(const std::vector<Entry>& entries, std::string_view outFile)
+        static bool PrintAllEntries(const EntryVector& entries, std::string_view outFile)
         {
             std::ofstream file(outFile.data());
             if(!file)
@@ -157,12 +165,15 @@ namespace fdf::detail
             };
 
             std::string temp;
-            for(const Entry& entry : entries)
+            std::string name;
+            for(size_t i = 0; i < entries.size(); i++)
             {
+                const Entry& entry = entries[i];
+                (void)entry.GetFullIdentifier(name);
             #if !FDF_NO_COMMENTS
-                addToBuffer(std::format("{:<{}}Type={}--Size={:03}--Name={:<20}--Value={:<50}--Comment={}", "", 4 * entry.depth, ENTRY_TYPE_TO_STRING[static_cast<size_t>(entry.type)], entry.size, entry.fullIdentifier, entry.DataToView(temp), entry.comment));
+                addToBuffer(std::format("{:<{}}Type={}--Size={:03}--Name={:<20}--Value={:<50}--Comment={}", "", 4 * entry.depth, ENTRY_TYPE_TO_STRING[static_cast<size_t>(entry.type)], entry.size, name, entry.DataToView(temp), entry.GetComment()));
             #else
-                addToBuffer(std::format("{:<{}}Type={}--Size={:03}--Name={:<20}--Value={:<50}", "", 4 * entry.depth, ENTRY_TYPE_TO_STRING[static_cast<size_t>(entry.type)], entry.size, entry.fullIdentifier, entry.DataToView(temp)));
+                addToBuffer(std::format("{:<{}}Type={}--Size={:03}--Name={:<20}--Value={:<50}", "", 4 * entry.depth, ENTRY_TYPE_TO_STRING[static_cast<size_t>(entry.type)], entry.size, name, entry.DataToView(temp)));
             #endif
                 buffer.push_back('\n');
             }
@@ -193,6 +204,22 @@ namespace fdf::detail
         
 
 
+        static inline std::vector<std::string> diagnostics;
+        static bool DiagnosticCallback(const Diagnostic& diagnostic)
+        {
+            const SourceLocation location = diagnostic.GetLocation();
+            const SourceLocation previousLocation = diagnostic.GetPreviousLocation();
+            diagnostics.push_back(std::format("{}|{}|{}:{}|{}:{}", diagnostic.GetText(), diagnostic.GetPreviousText(), location.line, location.column, previousLocation.line, previousLocation.column));
+            return true;
+        }
+
+        static inline std::atomic<size_t> reloadFailureCount = 0;
+        static bool ReloadFailureCallback(const Diagnostic& diagnostic)
+        {
+            reloadFailureCount += diagnostic.GetError() == Error::ReloadFailed;
+            return true;
+        }
+
         static void PrintLastSuccessfullyParsedEntry(auto& io)
         {
             size_t lastID = -1;
@@ -205,7 +232,11 @@ namespace fdf::detail
                 }
             }
 
-            std::println("-----LAST SUCCESSFULLY PARSED ENTRY: {} (id: {})-----", lastID == -1? "<None>" : io.entries[lastID].fullIdentifier, static_cast<int64_t>(lastID));
+            std::string name = "<None>";
+            if(lastID != -1)
+                (void)io.entries[lastID].GetFullIdentifier(name);
+
+            std::println("-----LAST SUCCESSFULLY PARSED ENTRY: {} (id: {})-----", name, static_cast<int64_t>(lastID));
         }
 
         static bool ParseTest()
@@ -248,6 +279,101 @@ namespace fdf::detail
 
 
 
+        // Type, extra data and text of the tokens of every test file should match its checked-in expectation in "tests/expected"
+        // Also prints how fast a big content is tokenized, so changes to the tokenizer can be compared
+        static bool TokenTest()
+        {
+            auto readFile = [](const std::filesystem::path& path)
+            {
+                std::ifstream file(path);
+                return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            };
+
+            bool bResult = true;
+            for(const TestDirectories& directories : filesToTest)
+            {
+                const std::filesystem::path expectedFile = std::filesystem::path(FDF_TEST_DIRECTORY "/expected") / std::filesystem::path(directories.tokenizedFile).filename();
+                if(!std::filesystem::exists(expectedFile))
+                {
+                    std::println("[ERROR]: No expected tokens for \"{}\", check \"{}\" and copy it to \"{}\"", directories.inputFile, directories.tokenizedFile, expectedFile.generic_string());
+                    bResult = false;
+                    continue;
+                }
+
+                const bool bSame = PrintAllTokens(directories.inputFile, directories.tokenizedFile) && readFile(directories.tokenizedFile) == readFile(expectedFile);
+                if(!bSame)
+                    std::println("[ERROR]: Tokens of \"{}\" changed, compare \"{}\" with \"{}\"", directories.inputFile, directories.tokenizedFile, expectedFile.generic_string());
+                bResult = bResult && bSame;
+            }
+
+            std::string content = readFile(filesToTest[0].inputFile);
+            content.push_back('\n');
+            std::string bigContent;
+            for(size_t i = 0; i < 2000; i++)
+                bigContent += content;
+
+            size_t tokenCount = 0;
+            const auto startTime = std::chrono::high_resolution_clock::now();
+            for(Tokenizer tokenizer(bigContent); tokenizer.Current().type != TokenType::EndOfFile && tokenizer.Current().type != TokenType::Invalid; tokenizer.Advance())
+                tokenCount++;
+            const auto endTime = std::chrono::high_resolution_clock::now();
+            const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+
+            std::println("Token Count: {} -- Throughput: {:.1f} MB/s -- Result: {}", tokenCount, bigContent.size() / seconds / 1'000'000.0, bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // The SIMD classification of a block should match the scalar one, which is what constant evaluation uses
+        static bool StructuralTest()
+        {
+            constexpr auto makeBlock = [](std::string_view pattern)
+            {
+                std::array<char, STRUCTURAL_BLOCK_SIZE> block = {};
+                for(size_t i = 0; i < block.size(); i++)
+                    block[i] = pattern[i % pattern.size()];
+                return block;
+            };
+            constexpr std::array blocks =
+            {
+                makeBlock("name = \"a \\\" b\", x[ 'c', '\\'' ]\n"),
+                makeBlock("// line comment\n/* block */ map{ a = 1 }\n"),
+                makeBlock("\\\\\"\\'/\\/"),
+                makeBlock("\xE2\x80\x9C\"\xFF/=\n,{[\x80\\"),
+                makeBlock("identifier without anything structural in it at all"),
+                makeBlock("\"\"''//**\n\n==,,{{[[\\\\"),
+            };
+            constexpr auto expected = [&blocks]()
+            {
+                std::array<StructuralMasks, blocks.size()> masks = {};
+                for(size_t i = 0; i < blocks.size(); i++)
+                    masks[i] = ClassifyBlock(blocks[i].data());
+                return masks;
+            }();
+
+            bool bResult = true;
+            for(size_t i = 0; i < blocks.size(); i++)
+            {
+                const std::string block(blocks[i].begin(), blocks[i].end());
+                bResult = bResult && ClassifyBlock(block.data()) == expected[i] && (expected[i].All() != 0) == (i != 4);
+            }
+
+            // The star of "/*" doesn't close the comment, everything up to "*/" stays inside it
+            constexpr std::string_view openComment = "/*/\na = 1\n*/";
+            TopLevelScanner scanner;
+            IO io;
+            bResult = bResult && EstimateSizes(openComment).entryCountEstimate == 0 && scanner.Scan(openComment) == std::string_view::npos;
+            bResult = bResult && io.Parse(std::string_view("/*/ a = 1 */\nb = 2\n")) && io.GetEntryCount() == 1;
+
+            std::println("Block Count: {:>3} -- Result: {}", blocks.size(), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
         // We intentionally print each one via a "Entry::GetValue" instead of "Entry::DataToView" so we can test more of the code
         // TODO: Maybe automate ReadTest so we don't need to implement each Entry by hand? (and manually adjust formatting (currently 24))
         static bool ReadTest()
@@ -512,6 +638,1188 @@ namespace fdf::detail
 
 
 
+        // Feeds the design file in small chunks, the result should be the same as parsing it at once
+        static bool StreamTest()
+        {
+            std::ifstream file(filesToTest[0].inputFile);
+            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            IO expected;
+            if(!expected.Parse(std::string_view(content)))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            std::string expectedBuffer;
+            expected.WriteToBuffer(expectedBuffer);
+
+            bool bResult = true;
+            for(size_t chunkSize : { 1, 7, 64, 4096 })
+            {
+                IO io;
+                StreamParser parser(io);
+
+                bool bSuccess = true;
+                for(size_t i = 0; i < content.size() && bSuccess; i += chunkSize)
+                    bSuccess = parser.Feed(std::string_view(content).substr(i, chunkSize));
+                bSuccess = bSuccess && parser.Finish();
+
+                std::string buffer;
+                io.WriteToBuffer(buffer);
+                bSuccess = bSuccess && io.GetEntryCount() == expected.GetEntryCount() && io.GetTopLevelEntryCount() == expected.GetTopLevelEntryCount() && buffer == expectedBuffer;
+
+                std::println("Chunk Size: {:>4} -- Result: {}", chunkSize, bSuccess? "SUCCESS" : "FAIL");
+                bResult = bResult && bSuccess;
+            }
+
+            // A stream that fails to parse halfway or repeats an existing identifier leaves the target as it was
+            IO io;
+            if(!io.Parse(std::string_view("StreamTestEntry{ a = 1 }\n")))
+                return false;
+
+            std::string before;
+            io.WriteToBuffer(before);
+            for(const std::string_view tail : { "\nbroken{ a = }\n", "\nStreamTestEntry = 2\n" })
+            {
+                StreamParser parser(io);
+                const bool bParsed = parser.Feed(std::string_view(content)) && parser.Feed(tail) && parser.Finish();
+
+                std::string after;
+                io.WriteToBuffer(after);
+                const bool bSuccess = !bParsed && io.GetEntryCount() == 2 && io.GetTopLevelEntryCount() == 1 && io.GetEntry("StreamTestEntry.a")->IsValid() && after == before;
+                std::println("Failing stream -- Result: {}", bSuccess? "SUCCESS" : "FAIL");
+                bResult = bResult && bSuccess;
+            }
+
+            return bResult;
+        }
+
+
+
+
+        // Numbers should keep the int/uint promotion rules and floats should be written back exactly as they were parsed
+        static bool NumberTest()
+        {
+            struct Case
+            {
+                std::string_view content;
+                Type type;
+                std::string_view expected;
+            };
+            constexpr Case cases[] =
+            {
+                { "a = 1920x1080\n",                        Type::Int,     "1920x1080" },
+                { "a = 9223372036854775807\n",              Type::Int,     "9223372036854775807" },
+                { "a = 9223372036854775808\n",              Type::UInt,    "9223372036854775808" },
+                { "a = 18446744073709551615x1\n",           Type::UInt,    "18446744073709551615x1" },
+                { "a = -1x18446744073709551615\n",          Type::Invalid, "" },
+                { "a = 18446744073709551616\n",             Type::Invalid, "" },
+                { "a = 1x-2x3\n",                           Type::Int,     "1x-2x3" },
+                { "a = 0.1\n",                              Type::Float,   "0.1" },
+                { "a = 0.30000000000000004\n",              Type::Float,   "0.30000000000000004" },
+                { "a = 1.0x2.5x3.125\n",                    Type::Float,   "1.0x2.5x3.125" },
+                { "a = 1234567890123456789.25\n",           Type::Float,   "1234567890123456768.0" },
+                { "a = 1.2.3\n",                            Type::Version, "1.2.3" },
+                { "a = 1x2x3x4x5x6\n",                      Type::Invalid, "" },
+            };
+
+            bool bResult = true;
+            std::string temp;
+            for(const Case& c : cases)
+            {
+                IO io;
+                const bool bParsed = io.Parse(c.content);
+                const bool bSuccess = c.type == Type::Invalid? !bParsed : bParsed && io.GetEntry("a")->GetType() == c.type && io.GetEntry("a")->DataToView(temp) == c.expected;
+                if(!bSuccess)
+                    std::println("Failed: {}", c.content.substr(0, c.content.size() - 1));
+                bResult = bResult && bSuccess;
+            }
+
+            // Under half of the smallest subnormal rounds to zero, only values over the largest double are out of range. Both ways agree
+            auto parseLimits = []() -> bool
+            {
+                double underflow = 1.0;
+                double subnormal = 0.0;
+                double overflow = 0.0;
+                return ParseFloat("-0." + std::string(400, '0') + "1", underflow) && underflow == 0.0 && std::signbit(underflow) &&
+                       ParseFloat("0." + std::string(323, '0') + "3", subnormal) && subnormal == std::numeric_limits<double>::denorm_min() &&
+                       !ParseFloat("1" + std::string(400, '0') + ".0", overflow);
+            };
+            static_assert(parseLimits());
+            bResult = bResult && parseLimits();
+
+            std::println("Case Count: {:>3} -- Result: {}", std::size(cases), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Parts parsed on different threads should be merged into the same entries as a single threaded parse
+        static bool ParallelTest()
+        {
+            std::string content = "/*# Generated content for the parallel test */\n";
+            for(size_t i = 0; i < 20000; i++)
+                content += std::format("entry{}\n{{\n    id = {}\n    name = \"Entry {}\"  // Comment {}\n}}\nvalues{}[ {}, 1.5, true ]\n", i, i, i, i, i, i);
+
+            IO expected;
+            if(!expected.Parse(std::string_view(content)))
+            {
+                std::puts("[ERROR]: Failed to parse the generated content!");
+                return false;
+            }
+
+            // Comments above an entry belong to it, the parts must not be split between them
+            std::string commentedContent;
+            for(size_t i = 0; i < 20000; i++)
+                commentedContent += i % 2 == 0? std::format("// Leading comment {}\ncommented{} = {}\n", i, i, i) : std::format("/* Leading\n   comment {} */\n\ncommented{} = {}\n", i, i, i);
+
+            IO expectedCommented;
+            if(!expectedCommented.Parse(std::string_view(commentedContent)))
+            {
+                std::puts("[ERROR]: Failed to parse the generated content!");
+                return false;
+            }
+
+            std::string expectedBuffer;
+            expected.WriteToBuffer(expectedBuffer);
+
+            bool bResult = true;
+            for(size_t threadCount : { 2, 4, 16 })
+            {
+                IO io;
+                bool bSuccess = io.ParseParallel(content, threadCount) && io.GetEntryCount() == expected.GetEntryCount() && io.GetTopLevelEntryCount() == expected.GetTopLevelEntryCount();
+
+                std::string buffer;
+                io.WriteToBuffer(buffer);
+                bSuccess = bSuccess && buffer == expectedBuffer;
+
+                std::string name, expectedName, temp, expectedTemp;
+                for(size_t i = 0; i < io.GetEntryCount() && bSuccess; i++)
+                {
+                    const Entry& entry = io.entries[i];
+                    const Entry& expectedEntry = expected.entries[i];
+                    bSuccess = entry.type == expectedEntry.type && entry.depth == expectedEntry.depth && entry.size == expectedEntry.size &&
+                               io.GetEntry(i).GetFullIdentifier(name) == expected.GetEntry(i).GetFullIdentifier(expectedName) && entry.DataToView(temp) == expectedEntry.DataToView(expectedTemp);
+                #if !FDF_NO_COMMENTS
+                    bSuccess = bSuccess && entry.GetComment() == expectedEntry.GetComment();
+                #endif
+                }
+            #if !FDF_NO_COMMENTS
+                bSuccess = bSuccess && io.fileComment == expected.fileComment;
+            #endif
+
+                IO commented;
+                bSuccess = bSuccess && commented.ParseParallel(commentedContent, threadCount) && commented.GetEntryCount() == expectedCommented.GetEntryCount();
+            #if !FDF_NO_COMMENTS
+                for(size_t i = 0; i < commented.GetEntryCount() && bSuccess; i++)
+                    bSuccess = commented.entries[i].GetComment() == expectedCommented.entries[i].GetComment() && !commented.entries[i].GetComment().empty();
+            #endif
+
+                std::println("Thread Count: {:>2} -- Result: {}", threadCount, bSuccess? "SUCCESS" : "FAIL");
+                bResult = bResult && bSuccess;
+            }
+
+            // Duplicates end up in different parts, they have to be found while merging
+            content += "entry0 = 1\n";
+            IO duplicate;
+            const bool bDuplicateRejected = !duplicate.ParseParallel(content, 4) && duplicate.GetEntryCount() == 0;
+            std::println("Duplicate Rejected: {}", bDuplicateRejected? "SUCCESS" : "FAIL");
+
+            return bResult && bDuplicateRejected;
+        }
+
+
+
+
+        // Borrowed entries reference the source instead of copying it, they should still look the same as the copied ones
+        static bool BorrowTest()
+        {
+            std::ifstream file(filesToTest[0].inputFile);
+            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            IO expected;
+            IO io;
+            if(!expected.Parse(std::string_view(content)) || !io.ParseOwned(content))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            std::string expectedBuffer;
+            std::string buffer;
+            expected.WriteToBuffer(expectedBuffer);
+            io.WriteToBuffer(buffer);
+
+            bool bResult = buffer == expectedBuffer && io.GetEntryCount() == expected.GetEntryCount();
+            size_t borrowedCount = 0;
+            for(size_t i = 0; i < io.entries.size(); i++)
+            {
+            #if !FDF_NO_COMMENTS
+                bResult = bResult && io.entries[i].GetComment() == expected.entries[i].GetComment();
+            #endif
+                borrowedCount += io.entries[i].IsBorrowed();
+            }
+
+        #if !FDF_NO_COMMENTS
+            // A comment set afterwards replaces the borrowed one, also when it is empty
+            const auto commented = std::ranges::find_if(io.entries, [](const Entry& entry) { return !entry.GetComment().empty(); });
+            if(commented != io.entries.end())
+            {
+                commented->SetComment("");
+                bResult = bResult && commented->GetComment().empty();
+                commented->SetComment("New");
+                bResult = bResult && commented->GetComment() == "New";
+            }
+        #endif
+
+            std::println("Borrowed Entry Count: {:>3} -- Result: {}", borrowedCount, bResult? "SUCCESS" : "FAIL");
+            return bResult && borrowedCount > 0;
+        }
+
+
+
+
+        // Static documents are parsed at compile time, they should have the same entries as a runtime parse of the same content
+        static bool StaticTest()
+        {
+            using Document = StaticDocument<STATIC_CONTENT>;
+            static_assert(Document::Get<"window.size">().GetValue<int>()[1] == 1080);
+            static_assert(Document::Get<"files.1">().GetValue<std::string_view>() == "src/fdf.cpp");
+            static_assert(!Document::GetEntry("window.missing").IsValid());
+
+            // Correctly rounded like the compiler, also for digits past the precision of a double and exact ties
+            static_assert(Document::Get<"rounding.0">().GetValue<double>()[0] == 0.30000000000000004440892098500626);
+            static_assert(Document::Get<"rounding.1">().GetValue<double>()[0] == 123456789012345678901234567890.5);
+            static_assert(Document::Get<"rounding.2">().GetValue<double>()[0] == 1.0);
+            static_assert(Document::Get<"rounding.3">().GetValue<double>()[0] == 1.0 + std::numeric_limits<double>::epsilon());
+
+            IO expected;
+            if(!expected.Parse(std::string_view(STATIC_CONTENT)))
+            {
+                std::puts("[ERROR]: Failed to parse the static content at runtime!");
+                return false;
+            }
+
+            bool bResult = Document::GetEntryCount() == expected.GetEntryCount() && Document::GetTopLevelEntryCount() == expected.GetTopLevelEntryCount();
+            std::string path;
+            for(size_t i = 0; i < expected.entries.size() && bResult; i++)
+            {
+                const Entry& entry = expected.entries[i];
+                (void)entry.GetFullIdentifier(path);
+
+                const StaticEntry found = Document::GetEntry(path);
+                bResult = found.GetType() == entry.GetType() && found.GetDepth() == entry.GetDepth() && found.GetIdentifier() == entry.GetIdentifier()
+                    && found.GetArrayIndex() == entry.GetArrayIndex() && found.GetChildCount() == entry.GetChildCount() && Document::GetEntryAt(i).GetType() == entry.GetType();
+
+                switch(entry.GetType())
+                {
+                    case Type::Bool:    bResult = bResult && std::ranges::equal(found.GetValue<bool>(), entry.GetValue<bool>());         break;
+                    case Type::Int:     bResult = bResult && std::ranges::equal(found.GetValue<int64_t>(), entry.GetValue<int64_t>());   break;
+                    case Type::UInt:
+                    case Type::Version: bResult = bResult && std::ranges::equal(found.GetValue<uint64_t>(), entry.GetValue<uint64_t>()); break;
+                    case Type::Float:   bResult = bResult && std::ranges::equal(found.GetValue<double>(), entry.GetValue<double>());     break;
+                    case Type::String:
+                    case Type::Hex:
+                    case Type::Timestamp: bResult = bResult && found.GetValue<char>() == entry.GetValue<char>(); break;
+                    default: break;
+                }
+            }
+
+            std::println("Entry Count: {:>3} -- Result: {}", Document::GetEntryCount(), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Locations are only computed when asked for, they should still point to the right place
+        static bool DiagnosticTest()
+        {
+            constexpr std::string_view content = "a = 1\n// First\n// Second\nb = 2\n";
+
+            IO<DiagnosticCallback> io;
+            bool bResult = io.Parse(content);
+
+        #if !FDF_NO_COMMENTS
+            bResult = bResult && diagnostics.size() == 1 && diagnostics[0] == "Second|First|3:4|2:4";
+        #else
+            bResult = bResult && diagnostics.empty();
+        #endif
+
+            // Identifiers longer than 255 bytes are reported and fail the parse, they don't throw through the noexcept parse functions
+            const std::string longKey = std::string(300, 'k') + " = 1\n";
+            IO<DiagnosticCallback> longKeyIO;
+            const size_t diagnosticCount = diagnostics.size();
+            bResult = bResult && !longKeyIO.Parse(std::string_view(longKey)) && diagnostics.size() == diagnosticCount + 1 && diagnostics.back() == std::string(300, 'k') + "||1:1|1:1";
+
+        #if defined(__linux__)
+            // Procfs files report a size of 0, their content has to be read (and rejected) instead of parsed as an empty file
+            IO procIO;
+            bResult = bResult && !procIO.Parse(std::filesystem::path("/proc/self/status"));
+        #endif
+
+            std::println("Diagnostic Count: {:>3} -- Result: {}", diagnostics.size(), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Tokens longer than "MAX_TOKEN_SIZE" should be invalid instead of truncated, offsets past 4 GB should be kept as they are
+        static bool LargeContentTest()
+        {
+            // Big allocations get zeroed pages from the system, only the few that are written take memory
+            const size_t size = MAX_TOKEN_SIZE + 4096;
+            std::unique_ptr<char, decltype(&std::free)> buffer(static_cast<char*>(std::calloc(size, 1)), &std::free);
+            if(buffer == nullptr)
+            {
+                std::puts("Not enough address space for the test, skipped");
+                return true;
+            }
+
+            // String literal of "MAX_TOKEN_SIZE" + 2 characters, its length doesn't fit into "Token::count"
+            const std::string_view content(buffer.get(), size);
+            buffer.get()[0] = '"';
+            buffer.get()[MAX_TOKEN_SIZE + 1] = '"';
+            bool bResult = Tokenizer(content).Current().type == TokenType::Invalid;
+
+            const size_t offset = MAX_TOKEN_SIZE + 100;
+            std::ranges::copy(std::string_view("\nvalue = 1"), buffer.get() + offset);
+            const Token token = Tokenizer(content, 1, offset + 1).Current();
+            bResult = bResult && token.type == TokenType::Identifier && token.startPosition == offset + 1 && token.ToView(content) == "value";
+
+            const SourceLocation location = Diagnostic(Error::UnexpectedToken, content, 1, "Token", token.ToView(content)).GetLocation();
+            bResult = bResult && location.line == 2 && location.column == 1;
+
+            std::println("Token Offset: {} -- Result: {}", token.startPosition, bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Skipping comments shouldn't change anything but the comments
+        static bool SkipCommentsTest()
+        {
+            IO expected;
+            IO io;
+            if(!expected.Parse(std::filesystem::path(filesToTest[0].inputFile)) || !io.Parse<ParseOptions{.bSkipComments = true}>(std::filesystem::path(filesToTest[0].inputFile)))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            std::string expectedTemp;
+            std::string temp;
+            bool bResult = io.GetEntryCount() == expected.GetEntryCount();
+            size_t skippedCount = 0;
+            for(size_t i = 0; i < io.entries.size() && bResult; i++)
+            {
+                bResult = io.entries[i].GetType() == expected.entries[i].GetType() && io.entries[i].DataToView(temp) == expected.entries[i].DataToView(expectedTemp);
+            #if !FDF_NO_COMMENTS
+                bResult = bResult && io.entries[i].GetComment().empty();
+                skippedCount += !expected.entries[i].GetComment().empty();
+            #endif
+            }
+        #if !FDF_NO_COMMENTS
+            bResult = bResult && io.fileComment.empty();
+        #endif
+
+            std::println("Skipped Comment Count: {:>3} -- Result: {}", skippedCount, bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Lazily parsed values should decode to the same values as eagerly parsed ones, copies should decode on their own
+        static bool LazyTest()
+        {
+            std::ifstream file(filesToTest[0].inputFile);
+            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            IO expected;
+            IO io;
+            if(!expected.Parse(std::string_view(content)) || !io.ParseOwned<ParseOptions{.bLazyValues = true}>(content))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            size_t lazyCount = 0;
+            for(const Entry& entry : io.entries)
+                lazyCount += !entry.IsResolved();
+
+            IO copy = io;
+            std::string expectedTemp;
+            std::string temp;
+            bool bResult = io.GetEntryCount() == expected.GetEntryCount() && lazyCount > 0;
+            for(size_t i = 0; i < io.entries.size(); i++)
+            {
+                const std::string_view expectedView = expected.entries[i].DataToView(expectedTemp);
+                bResult = bResult && io.entries[i].GetType() == expected.entries[i].GetType() && io.entries[i].DataToView(temp) == expectedView;
+                bResult = bResult && copy.entries[i].DataToView(temp) == expectedView && io.entries[i].IsResolved();
+            #if !FDF_NO_COMMENTS
+                bResult = bResult && io.entries[i].GetComment() == expected.entries[i].GetComment();
+            #endif
+            }
+
+            // Decoding errors show up on access instead of failing the parse
+            IO overflow;
+            bResult = bResult && overflow.Parse<ParseOptions{.bLazyValues = true}>(std::string_view("a = 18446744073709551616\n")) && !overflow.GetEntry("a")->IsValid();
+
+            // Resolving everything up front leaves nothing for const access to write, so the IO can be shared
+            IO shared;
+            bResult = bResult && shared.Parse<ParseOptions{.bLazyValues = true}>(std::string_view(content));
+            shared.ResolveValues();
+            bResult = bResult && std::ranges::all_of(shared.entries, &Entry::IsResolved);
+
+            std::println("Lazy Entry Count: {:>3} -- Result: {}", lazyCount, bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Binary snapshots should load back into the same entries, corrupted ones should be rejected
+        static bool BinaryTest()
+        {
+            IO expected;
+            if(!expected.Parse<ParseOptions{.bLazyValues = true}>(std::filesystem::path(filesToTest[0].inputFile)))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            std::string binary;
+            expected.WriteBinary(binary);
+
+            IO io;
+            IO fromFile;
+            const std::filesystem::path binaryFile = FDF_TEST_DIRECTORY "/output/BinaryTest.bin";
+            bool bResult = io.LoadBinary(std::string_view(binary)) && expected.WriteBinaryToFile(binaryFile) && fromFile.LoadBinary(binaryFile);
+
+            std::string expectedBuffer;
+            std::string buffer;
+            std::string fileBuffer;
+            expected.WriteToBuffer(expectedBuffer);
+            io.WriteToBuffer(buffer);
+            fromFile.WriteToBuffer(fileBuffer);
+            bResult = bResult && buffer == expectedBuffer && fileBuffer == expectedBuffer && io.GetTopLevelEntryCount() == expected.GetTopLevelEntryCount();
+
+            std::string fullIdentifier;
+            for(size_t i = 0; bResult && i < io.entries.size(); i++)
+            {
+                bResult = io.GetEntry(io.GetEntry(i).GetFullIdentifier(fullIdentifier)).index == i;
+            #if !FDF_NO_COMMENTS
+                bResult = bResult && io.entries[i].GetComment() == expected.entries[i].GetComment();
+            #endif
+            }
+        #if !FDF_NO_COMMENTS
+            bResult = bResult && io.fileComment == expected.fileComment;
+        #endif
+
+            std::string corrupted = binary;
+            corrupted[corrupted.size() / 2] ^= 0x20;
+            IO rejected;
+            bResult = bResult && !rejected.LoadBinary(std::string_view(corrupted)) && !rejected.LoadBinary(std::string_view(binary).substr(0, binary.size() - 1)) && rejected.GetEntryCount() == 0;
+
+            // Infinity has no text spelling, an image holding it is rejected instead of writing something that can't be parsed back
+            IO finite;
+            std::string nonFinite;
+            const double half = 0.5;
+            const double infinity = std::numeric_limits<double>::infinity();
+            bResult = bResult && finite.Parse(std::string_view("a = 0.5\n"));
+            finite.WriteBinary(nonFinite);
+            const size_t valueOffset = nonFinite.find(std::string_view(reinterpret_cast<const char*>(&half), sizeof(half)));
+            bResult = bResult && valueOffset != std::string::npos;
+            if(valueOffset != std::string::npos)
+                std::memcpy(nonFinite.data() + valueOffset, &infinity, sizeof(infinity));
+            bResult = bResult && !rejected.LoadBinary(std::string_view(nonFinite), CommentCombineStrategy::UseNewIfExistingIsEmpty, false) && rejected.GetEntryCount() == 0;
+
+            std::println("Binary Size: {:>6} -- Result: {}", binary.size(), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Cached files should load the same entries as parsing them, changes to the file should invalidate its image
+        static bool ParseCacheTest()
+        {
+            const std::filesystem::path cacheDirectory = FDF_TEST_DIRECTORY "/output/ParseCache";
+            const std::filesystem::path sourceFile = FDF_TEST_DIRECTORY "/output/ParseCacheSource.txt";
+            std::filesystem::remove_all(cacheDirectory);
+            std::filesystem::copy_file(filesToTest[0].inputFile, sourceFile, std::filesystem::copy_options::overwrite_existing);
+
+            auto countFiles = [&cacheDirectory](std::string_view extension) -> size_t
+            {
+                size_t count = 0;
+                for(const auto& file : std::filesystem::directory_iterator(cacheDirectory))
+                    count += file.path().extension() == extension;
+                return count;
+            };
+            auto countBorrowed = [](const auto& io) -> size_t
+            {
+                return std::ranges::count_if(io.entries, [](const Entry& entry) { return entry.IsBorrowed(); });
+            };
+
+            IO expected;
+            IO miss;
+            IO hit;
+            IO otherProcess;
+            ParseCache cache(cacheDirectory);
+            ParseCache otherCache(cacheDirectory);
+            bool bResult = expected.Parse(sourceFile) && miss.Parse(sourceFile, cache) && hit.Parse(sourceFile, cache) && otherProcess.Parse(sourceFile, otherCache);
+            bResult = bResult && countFiles(".fdfb") == 1 && countFiles(".stamp") == 1 && countBorrowed(miss) == 0 && countBorrowed(hit) > 0 && countBorrowed(otherProcess) > 0;
+
+            std::string expectedBuffer;
+            std::string hitBuffer;
+            std::string otherProcessBuffer;
+            expected.WriteToBuffer(expectedBuffer);
+            hit.WriteToBuffer(hitBuffer);
+            otherProcess.WriteToBuffer(otherProcessBuffer);
+            bResult = bResult && hitBuffer == expectedBuffer && otherProcessBuffer == expectedBuffer;
+
+            std::ofstream(sourceFile, std::ios::app) << "\nParseCacheTestEntry = 1\n";
+            IO changed;
+            bResult = bResult && changed.Parse(sourceFile, cache) && changed.GetEntry("ParseCacheTestEntry")->IsValid() && countFiles(".fdfb") == 2;
+
+            ParseCache tinyCache(cacheDirectory, 1);
+            IO evicted;
+            bResult = bResult && evicted.Parse(sourceFile, tinyCache) && evicted.GetEntryCount() == changed.GetEntryCount();
+            // Temporary files that may still be written by another process are kept, ones left behind by a crash aren't
+            const std::filesystem::path writingFile = cacheDirectory / "writing.tmp";
+            const std::filesystem::path abandonedFile = cacheDirectory / "abandoned.tmp";
+            std::ofstream(writingFile) << "partial image";
+            std::ofstream(abandonedFile) << "partial image";
+            std::filesystem::last_write_time(abandonedFile, std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+            tinyCache.Evict();
+            bResult = bResult && countFiles(".fdfb") == 0 && countFiles(".stamp") == 0 && std::filesystem::exists(writingFile) && !std::filesystem::exists(abandonedFile);
+
+            std::println("Cached Entry Count: {:>3} -- Result: {}", hit.GetEntryCount(), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Reparsed documents should be the same as parsing the edited content from scratch, failed edits should leave them alone
+        static bool ReparseTest()
+        {
+            std::ifstream file(filesToTest[0].inputFile);
+            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            IO io;
+            if(!io.Parse(std::string_view(content)))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            size_t editCount = 0;
+            auto replace = [&content](std::string_view from, std::string_view to) -> TextEdit
+            {
+                const size_t offset = content.find(from);
+                return { .offset = offset != std::string::npos? offset : content.size(), .removedSize = offset != std::string::npos? from.size() : 0, .insertedText = to };
+            };
+            auto applyEdits = [&](std::initializer_list<TextEdit> edits, bool bShouldSucceed) -> bool
+            {
+                std::string newContent;
+                size_t previousEnd = 0;
+                for(const TextEdit& edit : edits)
+                {
+                    newContent.append(content, previousEnd, edit.offset - previousEnd).append(edit.insertedText);
+                    previousEnd = edit.offset + edit.removedSize;
+                }
+                newContent.append(content, previousEnd);
+
+                std::string before;
+                io.WriteToBuffer(before);
+                std::vector<const char*> identifiers;
+                for(const Entry& entry : io.entries)
+                    identifiers.push_back(entry.GetIdentifier().data());
+                std::ranges::sort(identifiers);
+
+                editCount++;
+                if(!io.Reparse(newContent, edits))
+                {
+                    std::string after;
+                    io.WriteToBuffer(after);
+                    return !bShouldSucceed && after == before;
+                }
+
+                IO expected;
+                std::string expectedBuffer;
+                std::string buffer;
+                std::string fullIdentifier;
+                bool bResult = expected.Parse(std::string_view(newContent)) && bShouldSucceed;
+                expected.WriteToBuffer(expectedBuffer);
+                io.WriteToBuffer(buffer);
+                bResult = bResult && buffer == expectedBuffer && io.GetTopLevelEntryCount() == expected.GetTopLevelEntryCount() && io.entryPositions == expected.entryPositions;
+                bResult = bResult && io.entries.size() == expected.entries.size();
+                for(size_t i = 0; bResult && i < io.entries.size(); i++)
+                {
+                    bResult = io.GetEntry(io.GetEntry(i).GetFullIdentifier(fullIdentifier)).index == i;
+                    bResult = bResult && io.entries[i].parentOffset == expected.entries[i].parentOffset && io.entries[i].GetChildCount() == expected.entries[i].GetChildCount()
+                                      && io.entries[i].GetTopLevelChildCount() == expected.entries[i].GetTopLevelChildCount();
+                #if !FDF_NO_COMMENTS
+                    bResult = bResult && io.entries[i].GetComment() == expected.entries[i].GetComment();
+                #endif
+                }
+            #if !FDF_NO_COMMENTS
+                bResult = bResult && io.fileComment == expected.fileComment;
+            #endif
+
+                // Every edit is local, parsing from scratch would have moved all identifiers into a new pool
+                bResult = bResult && std::ranges::any_of(io.entries, [&identifiers](const Entry& entry) { return !entry.IsArrayElement() && std::ranges::binary_search(identifiers, entry.GetIdentifier().data()); });
+
+                content = std::move(newContent);
+                return bResult;
+            };
+
+            bool bResult = applyEdits({ replace("12345", "54321") }, true);
+            bResult = applyEdits({ replace("volume=75\n}", "volume=75\n    extra=1\n}") }, true) && bResult;
+            bResult = applyEdits({ replace("// Other string use cases", "added=\"x\"\n// Other string use cases") }, true) && bResult;
+            bResult = applyEdits({ replace("name2='MyGame2'\n", "") }, true) && bResult;
+            bResult = applyEdits({ replace("(file comments", "(File comments") }, true) && bResult;
+            bResult = applyEdits({ replace("id=54321", "id=1"), replace("pi=3.14", "pi=3.1415") }, true) && bResult;
+            bResult = applyEdits({ replace("volume=75 }", "volume=75") }, false) && bResult;  // Map isn't closed
+            bResult = applyEdits({ replace("uuid=", "name=") }, false) && bResult;  // Same top level identifier twice
+            bResult = applyEdits({ replace("appVersion=1.0.0.0", "appVersion=1.0.0.1") }, true) && bResult;
+            bResult = applyEdits({ replace("type=\"Health\"", "type=\"Poison\"") }, true) && bResult;  // Only a child of "gameItems1.properties"
+            bResult = applyEdits({ replace("type=\"Poison\"", "type=\"Poison\"\n        duration=5") }, true) && bResult;
+            bResult = applyEdits({ replace("        effect=\"Restores HP\"\n", "") }, true) && bResult;
+            bResult = applyEdits({ replace("name=\"Potion\"", "name=\"Potion\"\n") }, true) && bResult;  // New line ends up in front of the next child
+            bResult = applyEdits({ replace("name=\"Potion\"", "name=\"Potion\" // Potion") }, true) && bResult;
+            bResult = applyEdits({ replace("name=\"Potion\"", "id=\"Potion\"") }, false) && bResult;  // Same child identifier twice
+
+            // Entries parsed with a borrowed content are not kept, none of them may view the previous content afterwards
+            std::string source = content;
+            IO borrowed;
+            if(!borrowed.Parse<ParseOptions{.bBorrowSource = true}>(std::string_view(source)) || !borrowed.entryPositions.empty())
+                bResult = false;
+
+            const TextEdit edit = replace("id=1", "id=2");
+            std::string newContent = content;
+            newContent.replace(edit.offset, edit.removedSize, edit.insertedText);
+            std::string buffer;
+            std::string expectedBuffer;
+            IO expected;
+            bResult = borrowed.Reparse(newContent, { &edit, 1 }) && expected.Parse(std::string_view(newContent)) && bResult;
+            std::ranges::fill(source, ' ');
+            borrowed.WriteToBuffer(buffer);
+            expected.WriteToBuffer(expectedBuffer);
+            bResult = bResult && buffer == expectedBuffer && borrowed.entries.size() == expected.entries.size();
+            for(size_t i = 0; bResult && i < borrowed.entries.size(); i++)
+            {
+                std::string value;
+                std::string expectedValue;
+                bResult = borrowed.entries[i].GetIdentifier() == expected.entries[i].GetIdentifier()
+                       && borrowed.entries[i].DataToView(value) == expected.entries[i].DataToView(expectedValue);
+            }
+
+            std::println("Edit Count: {:>3} -- Result: {}", editCount, bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Rewriting a watched file should publish the new document and notify only the subscribers of the entries that changed
+        static bool FileWatcherTest()
+        {
+            #if defined(__linux__)
+            const std::filesystem::path watchedFile = FDF_TEST_DIRECTORY "/output/FileWatcherTest.txt";
+            std::ofstream(watchedFile, std::ios::trunc) << "a = 1\nmap\n{\n    x = 1\n    y = 2\n}\n";
+
+            FileWatcher watcher(std::chrono::milliseconds(10));
+            if(!watcher.Watch(watchedFile))
+            {
+                std::puts("[ERROR]: Failed to watch the file!");
+                return false;
+            }
+
+            std::mutex mutex;
+            std::vector<std::string> allChanges;
+            std::vector<std::string> mapChanges;
+            auto describe = [](const FileWatcher<>::Change& change)
+            {
+                constexpr std::string_view TYPES[] = { "Added", "Removed", "Changed" };
+                return std::string(TYPES[static_cast<size_t>(change.type)]) + " " + change.identifier;
+            };
+            watcher.Subscribe("", [&](const FileWatcher<>::Change& change) { std::lock_guard lock(mutex); allChanges.push_back(describe(change)); });
+            watcher.Subscribe("map", [&](const FileWatcher<>::Change& change) { std::lock_guard lock(mutex); mapChanges.push_back(describe(change)); });
+            watcher.Subscribe("ma", [&](const FileWatcher<>::Change&) { std::lock_guard lock(mutex); mapChanges.push_back("Wrong prefix"); });
+            watcher.Subscribe("a", [&](const FileWatcher<>::Change&) { [[maybe_unused]] const bool bReloaded = watcher.Reload(watchedFile); });  // Subscribers may reload
+
+            std::ofstream(watchedFile, std::ios::trunc) << "b = 2\nmap\n{\n    x = 3\n    y = 2\n}\n";
+            for(int i = 0; i < 200; i++)
+            {
+                {
+                    std::lock_guard lock(mutex);
+                    if(allChanges.size() >= 3)
+                        break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            bool bResult = watcher.Reload(watchedFile);  // Nothing changed since the last reload
+            std::lock_guard lock(mutex);
+            std::ranges::sort(allChanges);
+            bResult = bResult && allChanges == std::vector<std::string>{ "Added b", "Changed map.x", "Removed a" };
+            bResult = bResult && mapChanges == std::vector<std::string>{ "Changed map.x" };
+
+            const auto document = watcher.Get(watchedFile);
+            bResult = bResult && document != nullptr && document->GetEntry("map.x")->GetValue<int>()[0] == 3 && watcher.Get("Unwatched.txt") == nullptr;
+
+            // A file that can't be parsed isn't watched
+            const std::filesystem::path invalidFile = FDF_TEST_DIRECTORY "/output/FileWatcherInvalid.txt";
+            std::ofstream(invalidFile, std::ios::trunc) << "a = = 1\n";
+            bResult = bResult && !watcher.Watch(invalidFile) && watcher.Get(invalidFile) == nullptr;
+
+            // A subscriber that throws on the watcher thread is reported and the thread keeps reloading
+            const std::filesystem::path throwingFile = FDF_TEST_DIRECTORY "/output/FileWatcherThrowing.txt";
+            std::ofstream(throwingFile, std::ios::trunc) << "a = 1\n";
+            FileWatcher<ReloadFailureCallback> throwingWatcher(std::chrono::milliseconds(10));
+            bResult = bResult && throwingWatcher.Watch(throwingFile);
+            throwingWatcher.Subscribe("", [](const auto&) { throw std::runtime_error("Subscriber failed"); });
+
+            auto waitFor = [](auto condition)
+            {
+                for(int i = 0; i < 200 && !condition(); i++)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                return condition();
+            };
+            std::ofstream(throwingFile, std::ios::trunc) << "a = 2\n";
+            bResult = bResult && waitFor([]() { return reloadFailureCount != 0; });
+            const size_t failureCount = reloadFailureCount;
+            std::ofstream(throwingFile, std::ios::trunc) << "a = 3\n";
+            bResult = bResult && waitFor([&]()
+            {
+                const auto document = throwingWatcher.Get(throwingFile);  // The file may be empty between truncating and writing it
+                return document->GetEntry("a")->GetType() == Type::Int && document->GetEntry("a")->GetValue<int>()[0] == 3 && reloadFailureCount > failureCount;
+            });
+
+            std::println("Change Count: {:>3} -- Result: {}", allChanges.size(), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+            #else
+            std::puts("File watcher isn't available on this platform");
+            return true;
+            #endif
+        }
+
+
+
+
+        // Applying the diff of two versions of the design file should turn the first one into the second one
+        static bool DiffTest()
+        {
+            std::ifstream file(filesToTest[0].inputFile);
+            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            auto replace = [](std::string text, std::string_view from, std::string_view to)
+            {
+                const size_t offset = text.find(from);
+                return offset != std::string::npos? text.replace(offset, from.size(), to) : text;
+            };
+            std::string newContent = replace(content, "id=12345", "id=54321");
+            newContent = replace(newContent, "volume=75 }", "volume=80 }");
+            newContent = replace(newContent, "levels1[ 1, 2, 3, 4, 5 ]", "levels1[ 1, 2, 9 ]");
+            newContent = replace(newContent, "\"map\", \"example\" ]", "\"map\", \"example\", \"new\", \"newer\" ]");
+            newContent = replace(newContent, "uuid=\"a123-xyz\"", "");
+            newContent = replace(newContent, "pi=3.14", "pi{ x=1, y=2 }");
+            newContent += "\nDiffTestEntry{ a=1, b{ c=2 } }\n";
+
+            IO io;
+            IO target;
+            if(!io.Parse(std::string_view(content)) || !target.Parse(std::string_view(newContent)))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            const Patch patch = io.Diff(target);
+            std::vector<std::string> changes;
+            for(const Patch::Change& change : patch.GetChanges())
+            {
+                constexpr std::string_view TYPES[] = { "Added", "Removed", "Changed" };
+                changes.push_back(std::string(TYPES[static_cast<size_t>(change.type)]) + " " + change.identifier);
+            }
+            std::ranges::sort(changes);
+            const std::vector<std::string> expectedChanges =
+            {
+                "Added DiffTestEntry", "Added tags1.3", "Added tags1.4", "Changed gameSettings1.volume", "Changed id", "Changed levels1.2",
+                "Changed pi", "Removed levels1.3", "Removed levels1.4", "Removed uuid"
+            };
+            bool bResult = changes == expectedChanges && patch.GetEntry(patch.GetChanges().back()) == nullptr;
+
+            // Every entry of the target has to be found by its full identifier, so the index is checked too
+            IO patched = io;
+            bResult = bResult && patched.Apply(patch) && patched.Diff(target).IsEmpty() && target.Diff(patched).IsEmpty();
+            bResult = bResult && patched.GetEntryCount() == target.GetEntryCount() && patched.GetTopLevelEntryCount() == target.GetTopLevelEntryCount();
+            std::string identifier;
+            std::string temp;
+            std::string expectedTemp;
+            for(const auto entry : target.Iterator())
+            {
+                const auto patchedEntry = patched.GetEntry(entry.GetFullIdentifier(identifier));
+                bResult = bResult && patchedEntry->GetType() == entry->GetType() && patchedEntry->DataToView(temp) == entry->DataToView(expectedTemp);
+            }
+
+            bResult = bResult && !patched.Apply(patch) && io.Diff(io).IsEmpty();  // "DiffTestEntry" already exists
+            std::println("Change Count: {:>3} -- Result: {}", changes.size(), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Fields bound to a struct should be read the same way from an IO and from the events, mismatches shouldn't throw or touch the member
+        static bool BindingTest()
+        {
+            std::ifstream file(filesToTest[0].inputFile);
+            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            IO io;
+            if(!io.Parse(std::string_view(content)))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            struct Settings
+            {
+                std::string name;
+                int64_t id = 0;
+                float pi = 0.0f;
+                std::array<uint16_t, 2> resolution = {};
+                bool bFullscreen = false;
+                uint8_t volume = 0;
+                std::vector<int> levels;
+                int thirdLevel = 0;
+                std::optional<int> value = 1;
+            };
+            using SettingsBinding = Binding<Settings,
+                Field<"name", &Settings::name>, Field<"id", &Settings::id>, Field<"pi", &Settings::pi>, Field<"resolution", &Settings::resolution>,
+                Field<"gameSettings2.fullscreen", &Settings::bFullscreen>, Field<"gameSettings2.volume", &Settings::volume>,
+                Field<"levels1", &Settings::levels>, Field<"levels1.2", &Settings::thirdLevel>, Field<"value", &Settings::value>>;
+
+            auto isExpected = [](const Settings& settings)
+            {
+                return settings.name == "MyGame" && settings.id == 12345 && settings.pi == 3.14f && settings.resolution == std::array<uint16_t, 2>{ 1920, 1080 } &&
+                       settings.bFullscreen && settings.volume == 75 && settings.levels == std::vector<int>{ 1, 2, 3, 4, 5 } && settings.thirdLevel == 3 && !settings.value;
+            };
+            Settings fromIO;
+            Settings fromEvents;
+            bool bResult = SettingsBinding::Read(io, fromIO) && isExpected(fromIO);
+            bResult = bResult && SettingsBinding::Read(std::string_view(content), fromEvents) && isExpected(fromEvents);
+
+            struct Mismatch
+            {
+                int64_t name = 7;
+                int8_t id = 7;
+                std::string_view uuid;
+                int missing = 7;
+            };
+            using MismatchBinding = Binding<Mismatch, Field<"name", &Mismatch::name>, Field<"id", &Mismatch::id>, Field<"uuid", &Mismatch::uuid>, Field<"missing", &Mismatch::missing>>;
+            Mismatch mismatch;
+            bResult = bResult && !MismatchBinding::Read(io, mismatch) && mismatch.name == 7 && mismatch.id == 7 && mismatch.uuid == "a123-xyz" && mismatch.missing == 7;
+
+            std::println("Field Count: {:>3} -- Result: {}", 9, bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Prehashed and literal paths should find the same entries as the text ones, including array elements and children of entries
+        static bool PathTest()
+        {
+            IO io;
+            if(!io.Parse(std::filesystem::path(filesToTest[0].inputFile)))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            bool bResult = true;
+            std::string identifier;
+            for(const auto entry : io.Iterator())
+            {
+                const Path path(entry.GetFullIdentifier(identifier));
+                bResult = bResult && io.GetEntry(path).index == entry.index && io.GetEntry(identifier).index == entry.index;
+            }
+
+            const Path volume("gameSettings2.volume");
+            const IO copy = io;
+            bResult = bResult && copy.GetEntry(volume)->GetValue<int>()[0] == 75 && io.GetEntry("gameSettings2").GetEntry(Path("volume")).index == io.GetEntry(volume).index;
+            bResult = bResult && io.Get<"levels1.2">()->GetValue<int>()[0] == 3 && io.Get<"gameSettings2.volume">().index == io.GetEntry(volume).index;
+            bResult = bResult && !io.Get<"levels1.x">()->IsValid() && !io.Get<"id.x">()->IsValid() && !io.GetEntry(Path("levels1.99"))->IsValid() && !io.GetEntry(Path())->IsValid();
+
+            io.GetMutable<"gameSettings2">().SetIdentifier("renamedSettings");
+            bResult = bResult && io.Get<"renamedSettings.volume">().index == copy.GetEntry(volume).index && !io.GetEntry(volume)->IsValid();
+
+            std::println("Path Count: {:>3} -- Result: {}", io.GetEntryCount(), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Children found by index and by the sibling iterators should be the ones a scan over the depths finds, also after entries are added
+        static bool ChildAccessTest()
+        {
+            IO io;
+            IO extra;
+            if(!io.Parse(std::filesystem::path(filesToTest[0].inputFile)) || !extra.Parse(std::string_view("extra{ a = 1 b = [ 2, 3 ] }")))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            auto matchesScan = [](const auto& document) -> bool
+            {
+                bool bMatches = true;
+                std::vector<size_t> expected;
+                std::vector<size_t> iterated;
+                for(size_t parent = static_cast<size_t>(-1); parent == -1 || parent < document.GetEntryCount(); parent++)
+                {
+                    const bool bTopLevel = parent == -1;
+                    const size_t end = bTopLevel? document.GetEntryCount() : parent + 1 + document.entries[parent].GetChildCount();
+                    const uint8_t depth = bTopLevel? 0 : document.entries[parent].depth + 1;
+                    expected.clear();
+                    for(size_t i = parent + 1; i < end; i++)
+                    {
+                        if(document.entries[i].depth == depth)
+                            expected.push_back(i);
+                    }
+
+                    iterated.clear();
+                    if(bTopLevel)
+                        std::ranges::copy(document.TopLevelIterator() | std::views::transform([](const auto& child) { return child.index; }), std::back_inserter(iterated));
+                    else
+                        std::ranges::copy(document.GetEntry(parent).TopLevelIterator() | std::views::transform([](const auto& child) { return child.index; }), std::back_inserter(iterated));
+                    bMatches = bMatches && iterated == expected;
+
+                    for(size_t id = 0; id <= expected.size(); id++)
+                    {
+                        const size_t found = bTopLevel? document.GetTopLevelEntry(id).index : document.GetEntry(parent).GetTopLevelEntry(id).index;
+                        bMatches = bMatches && found == (id < expected.size()? expected[id] : static_cast<size_t>(-1));
+                    }
+                }
+                return bMatches;
+            };
+
+            bool bResult = matchesScan(io);
+            const IO copy = io;
+            bResult = bResult && io.Combine(extra) && matchesScan(io) && matchesScan(copy);
+            bResult = bResult && io.GetTopLevelEntry(io.GetTopLevelEntryCount() - 1).GetTopLevelEntry(1).GetTopLevelEntry(1)->GetValue<int>()[0] == 3;
+            bResult = bResult && io.GetTopLevelEntryMutable(0).index == 0 && !io.GetEntry("id").GetTopLevelEntry(0)->IsValid();
+
+            // Lookups can't fail, without a table (constant evaluation, out of memory) the siblings are walked instead
+            static_assert(noexcept(io.GetTopLevelEntry(0)) && noexcept(io.GetEntry(0).GetTopLevelEntry(0)));
+
+            std::println("Top Level Entry Count: {:>3} -- Result: {}", io.GetTopLevelEntryCount(), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Frozen entries should read the same as the entries they were frozen from, full and relative identifiers should find them through the perfect hash
+        static bool FrozenTest()
+        {
+            IO io;
+            if(!io.Parse(std::filesystem::path(filesToTest[0].inputFile)))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            const FrozenDocument frozen = io.Freeze();
+            bool bResult = frozen.GetEntryCount() == io.GetEntryCount() && frozen.GetTopLevelEntryCount() == io.GetTopLevelEntryCount();
+
+            std::string identifier;
+            std::string frozenIdentifier;
+            for(size_t i = 0; i < io.GetEntryCount() && bResult; i++)
+            {
+                const auto expected = io.GetEntry(i);
+                const auto entry = frozen.GetEntry(i);
+                bResult = entry->GetType() == expected->GetType() && entry->GetDepth() == expected->GetDepth() && entry->GetIdentifier() == expected->GetIdentifier() &&
+                          entry->GetArrayIndex() == expected->GetArrayIndex() && entry.GetParent().index == expected.GetParent().index &&
+                          entry.GetEntryCount() == expected.GetEntryCount() && entry.GetTopLevelEntryCount() == expected.GetTopLevelEntryCount() &&
+                          entry.GetFullIdentifier(frozenIdentifier) == expected.GetFullIdentifier(identifier) && frozen.GetEntry(identifier).index == i;
+
+                switch(expected->GetType())
+                {
+                    case Type::Bool:  bResult = bResult && std::ranges::equal(entry->GetValue<bool>(),   expected->GetValue<bool>());   break;
+                    case Type::Int:   bResult = bResult && std::ranges::equal(entry->GetValue<int>(),    expected->GetValue<int>());    break;
+                    case Type::Float: bResult = bResult && std::ranges::equal(entry->GetValue<double>(), expected->GetValue<double>()); break;
+                    case Type::UInt:
+                    case Type::Version:   bResult = bResult && std::ranges::equal(entry->GetValue<uint64_t>(), expected->GetValue<uint64_t>()); break;
+                    case Type::String:
+                    case Type::Hex:
+                    case Type::Timestamp: bResult = bResult && entry->GetValue<std::string_view>() == expected->GetValue<std::string_view>(); break;
+                    default: break;
+                }
+
+                for(size_t id = 0; id < expected.GetTopLevelEntryCount(); id++)
+                    bResult = bResult && entry.GetTopLevelEntry(id).index == expected.GetTopLevelEntry(id).index;
+            }
+            bResult = bResult && std::ranges::equal(frozen.TopLevelIterator() | std::views::transform([](const auto& entry) { return entry.index; }),
+                                                    io.TopLevelIterator()     | std::views::transform([](const auto& entry) { return entry.index; }));
+
+            bResult = bResult && frozen.GetEntry("gameSettings2").GetEntry("volume")->GetValue<int>()[0] == 75 && frozen.Get<"levels1.2">()->GetValue<int>()[0] == 3;
+            bResult = bResult && frozen.GetEntry("levels1").GetEntry(Path("4")).index == frozen.Get<"levels1.4">().index && frozen.GetEntry("levels1").GetTopLevelEntry(4).index == frozen.Get<"levels1.4">().index;
+            bResult = bResult && !frozen.Get<"levels1.x">()->IsValid() && !frozen.Get<"id.x">()->IsValid() && !frozen.GetEntry("levels1.99")->IsValid() && !frozen.GetEntry("")->IsValid();
+            bResult = bResult && !frozen.GetEntry("gameSettings2").GetEntry("id")->IsValid() && !frozen.GetEntry("volume")->IsValid();
+            bResult = bResult && frozen.GetEntry(Path("gameSettings2.volume")).index == frozen.GetEntry("gameSettings2.volume").index && frozen.GetEntry(Path("levels1.2")).index == frozen.Get<"levels1.2">().index;
+            bResult = bResult && frozen.GetEntry(Path("gameSettings2.volume"))->IsValid() && !frozen.GetEntry(Path("levels1.x"))->IsValid() && !frozen.GetEntry(Path("volume"))->IsValid();
+            bResult = bResult && frozen.GetMemoryUsage() < io.GetEntryCount() * sizeof(Entry);
+
+            // Combining a document with itself repeats every identifier, it is rejected and the document stays the same
+            IO combined = io;
+            bResult = bResult && !combined.Combine(io) && combined.GetEntryCount() == io.GetEntryCount() && combined.GetTopLevelEntryCount() == io.GetTopLevelEntryCount();
+            bResult = bResult && combined.GetEntry("levels1.2").index == io.GetEntry("levels1.2").index && combined.Freeze().GetEntryCount() == frozen.GetEntryCount();
+
+            std::println("Memory: {} bytes frozen, {} bytes of entries -- Result: {}", frozen.GetMemoryUsage(), io.GetEntryCount() * sizeof(Entry), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Entries parsed into an arena should be the same as the ones parsed with new/delete, copies shouldn't keep using the arena
+        static bool ArenaTest()
+        {
+            IO expected;
+            IO io = IO<>::WithArena();
+            if(!expected.Parse(std::filesystem::path(filesToTest[0].inputFile)) || !io.Parse(std::filesystem::path(filesToTest[0].inputFile)))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            IO copy = io;
+            std::string expectedBuffer;
+            std::string buffer;
+            std::string copyBuffer;
+            expected.WriteToBuffer(expectedBuffer);
+            io.WriteToBuffer(buffer);
+            copy.WriteToBuffer(copyBuffer);
+
+            bool bResult = buffer == expectedBuffer && copyBuffer == expectedBuffer && io.GetMemoryResource() != nullptr && copy.GetMemoryResource() == nullptr;
+
+            // Copies don't share the arena or the identifier pool, neither is thread safe
+            IO assigned = IO<>::WithArena();
+            assigned = io;
+            bResult = bResult && assigned.GetMemoryResource() == nullptr && assigned.entries.size() == io.entries.size();
+            for(size_t i = 0; bResult && i < io.entries.size(); i++)
+                bResult = io.entries[i].IsArrayElement() || (assigned.entries[i].GetIdentifier() == io.entries[i].GetIdentifier() && assigned.entries[i].GetIdentifier().data() != io.entries[i].GetIdentifier().data());
+
+            // Parsing from scratch moves the document into a new arena instead of piling up in the old one
+            std::ifstream file(filesToTest[0].inputFile);
+            const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            const std::pmr::memory_resource* previousArena = io.GetMemoryResource();
+            bResult = bResult && io.Reparse(content, {}) && io.GetMemoryResource() != nullptr && io.GetMemoryResource() != previousArena && io.GetEntryCount() == expected.GetEntryCount();
+
+            IO pool = IO<>::WithPool();
+            std::string poolBuffer;
+            bResult = bResult && pool.Parse(std::string_view(content)) && pool.GetMemoryResource() != nullptr && pool.GetEntryCount() == expected.GetEntryCount();
+            pool.WriteToBuffer(poolBuffer);
+            bResult = bResult && poolBuffer == expectedBuffer;
+
+            std::println("Result: {}", bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Every rebuilt full identifier should lead back to its entry, renaming a container should rename its whole subtree
+        static bool IdentifierTest()
+        {
+            IO io;
+            if(!io.Parse(std::filesystem::path(filesToTest[0].inputFile)))
+            {
+                std::puts("[ERROR]: Failed to parse the design file... Should never happen unless initial parse failed too!");
+                return false;
+            }
+
+            bool bResult = true;
+            std::string name;
+            for(size_t i = 0; i < io.GetEntryCount(); i++)
+                bResult = bResult && io.GetEntry(io.GetEntry(i).GetFullIdentifier(name)).index == i;
+
+            size_t containerID = -1;
+            for(size_t i = 0; i < io.GetEntryCount() && containerID == -1; i++)
+            {
+                if(io.entries[i].depth == 0 && io.entries[i].GetChildCount() > 0)
+                    containerID = i;
+            }
+            if(containerID == -1)
+                return false;
+
+            const std::string oldName = std::string(io.entries[containerID].GetIdentifier());
+            io.GetEntryMutable(containerID).SetIdentifier("Renamed");
+            for(size_t i = containerID + 1; i <= containerID + io.entries[containerID].GetChildCount(); i++)
+            {
+                const std::string_view fullIdentifier = io.GetEntry(i).GetFullIdentifier(name);
+                bResult = bResult && fullIdentifier.starts_with("Renamed.") && io.GetEntry(fullIdentifier).index == i;
+            }
+            bResult = bResult && !io.GetEntry(oldName)->IsValid() && io.GetEntry("Renamed").index == containerID;
+
+            std::println("Renamed: {} -> Renamed -- Child Count: {:>3} -- Result: {}", oldName, io.entries[containerID].GetChildCount(), bResult? "SUCCESS" : "FAIL");
+            return bResult;
+        }
+
+
+
+
+        // Every value and container of the design file should be reported once, and every container should be closed
+        static bool EventTest()
+        {
+            struct Handler
+            {
+                void OnValue(Type type, std::string_view value)
+                {
+                    elementCount++;
+                    // Strings are views into the content, only evaluate literals are replaced by their placeholder text
+                    const bool bInContent = value.data() >= content.data() && value.data() + value.size() <= content.data() + content.size();
+                    if(type == Type::String && !bInContent && value != "Evaluate Literal")
+                        copiedCount++;
+                }
+                void OnBeginMap()                     { elementCount++; openCount++; }
+                void OnBeginArray()                   { elementCount++; openCount++; }
+                void OnEndMap()                       { closeCount++; }
+                void OnEndArray()                     { closeCount++; }
+
+                std::string_view content;
+                size_t elementCount = 0;
+                size_t copiedCount = 0;
+                size_t openCount = 0;
+                size_t closeCount = 0;
+            };
+
+            std::ifstream file(filesToTest[0].inputFile);
+            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            IO io;
+            Handler handler = { .content = content };
+            const bool bSuccess = io.Parse(std::string_view(content)) && ParseEvents(content, handler);
+
+            std::println("Element Count: {:>3} (should be {:>3})", handler.elementCount, io.GetEntryCount());
+            std::println("Open  / Close: {:>3} / {:>3}", handler.openCount, handler.closeCount);
+
+            return bSuccess && handler.elementCount == io.GetEntryCount() && handler.openCount == handler.closeCount && handler.copiedCount == 0;
+        }
+
+
+
+
         static bool WriteTest()
         {
             IO io;
@@ -557,8 +1865,54 @@ int main()
 
     std::print("Parse test -- Found {} files\n{}", filesToTest.size(), separator);
     bResult = Test::ParseTest() && bResult;
+    std::print("\n{1}{1}\nToken test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::TokenTest() && bResult;
+    std::print("\n{1}{1}\nStructural test -- file: {0}\n{1}", "<Embedded>", separator);
+    bResult = Test::StructuralTest() && bResult;
     std::print("\n{1}{1}\nRead test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
     bResult = Test::ReadTest()  && bResult;
+    std::print("\n{1}{1}\nStream test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::StreamTest() && bResult;
+    std::print("\n{1}{1}\nEvent test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::EventTest() && bResult;
+    std::print("\n{1}{1}\nNumber test -- file: {0}\n{1}", "<Generated>", separator);
+    bResult = Test::NumberTest() && bResult;
+    std::print("\n{1}{1}\nStatic test -- file: {0}\n{1}", "<Embedded>", separator);
+    bResult = Test::StaticTest() && bResult;
+    std::print("\n{1}{1}\nParallel test -- file: {0}\n{1}", "<Generated>", separator);
+    bResult = Test::ParallelTest() && bResult;
+    std::print("\n{1}{1}\nBorrow test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::BorrowTest() && bResult;
+    std::print("\n{1}{1}\nDiagnostic test -- file: {0}\n{1}", "<Embedded>", separator);
+    bResult = Test::DiagnosticTest() && bResult;
+    std::print("\n{1}{1}\nLarge content test -- file: {0}\n{1}", "<Generated>", separator);
+    bResult = Test::LargeContentTest() && bResult;
+    std::print("\n{1}{1}\nSkip comments test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::SkipCommentsTest() && bResult;
+    std::print("\n{1}{1}\nLazy test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::LazyTest() && bResult;
+    std::print("\n{1}{1}\nBinary test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::BinaryTest() && bResult;
+    std::print("\n{1}{1}\nParse cache test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::ParseCacheTest() && bResult;
+    std::print("\n{1}{1}\nReparse test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::ReparseTest() && bResult;
+    std::print("\n{1}{1}\nFile watcher test -- file: {0}\n{1}", "<Embedded>", separator);
+    bResult = Test::FileWatcherTest() && bResult;
+    std::print("\n{1}{1}\nDiff test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::DiffTest() && bResult;
+    std::print("\n{1}{1}\nBinding test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::BindingTest() && bResult;
+    std::print("\n{1}{1}\nPath test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::PathTest() && bResult;
+    std::print("\n{1}{1}\nChild access test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::ChildAccessTest() && bResult;
+    std::print("\n{1}{1}\nFrozen test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::FrozenTest() && bResult;
+    std::print("\n{1}{1}\nArena test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::ArenaTest() && bResult;
+    std::print("\n{1}{1}\nIdentifier test -- file: {0}\n{1}", filesToTest[0].inputFile, separator);
+    bResult = Test::IdentifierTest() && bResult;
     std::print("\n{1}{1}\nWrite test -- file: {0}\n{1}", "<Placeholder>", separator);
     bResult = Test::WriteTest() && bResult;
 